@@ -49,31 +49,26 @@ AndGate::AndGate(SpartyBoots *spartyBoots): LogicGate(spartyBoots)
     auto h = AndGateSize.GetHeight(); // Height of the AND gate
 
     /// Creating a vector of pins and initializing them at the same time
-    mInputPins.push_back(std::make_shared<InputPin>(spartyBoots));
-    mInputPins.push_back(std::make_shared<InputPin>(spartyBoots));
+    AddInputPin();
+    AddInputPin();
 
-    mOutputPins.push_back(std::make_shared<OutputPin>(spartyBoots));
+    AddOutputPin();
 
     /// setting the pins location to be exactly where I drew them.
     mInputPins[0]->SetLocation(x - w / 2 - DefaultLineLength, y + h / 4);
     mInputPins[1]->SetLocation(x - w / 2 - DefaultLineLength, y - h / 4);
 
     mOutputPins[0]->SetLocation(x + w / 2 + 3 * DefaultLineLength, y);
-
-    /// Adding the pins to spartyboots so that it recognizes it when hittesting
-    spartyBoots->Add(mInputPins[0]);
-    spartyBoots->Add(mInputPins[1]);
-    spartyBoots->Add(mOutputPins[0]);
 }
 
 /**
  * Draw AndGate with virtual pixel
  * @param graphics
  */
-void AndGate::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void AndGate::Draw(DrawCommands &graphics)
 {
     // Create a path to draw the AND gate shape
-    auto path = graphics->CreatePath();
+    auto path = graphics.CreatePath();
 
     // The location and size
     auto x = GetX();
@@ -102,11 +97,11 @@ void AndGate::Draw(std::shared_ptr<wxGraphicsContext> graphics)
     path.CloseSubpath();
 
     // Set pen and brush for drawing
-    graphics->SetPen(*wxBLACK_PEN);
-    graphics->SetBrush(*wxWHITE_BRUSH);
+    graphics.SetPen(*wxBLACK_PEN);
+    graphics.SetBrush(*wxWHITE_BRUSH);
 
     // Draw the path
-    graphics->DrawPath(path);
+    graphics.DrawPath(path);
 
     // // Compute logic of the inputs and change output accordingly
     // GateCompute();
@@ -135,7 +130,7 @@ void AndGate::Draw(std::shared_ptr<wxGraphicsContext> graphics)
  * @param end_x
  * @param end_y
  */
-void AndGate::DrawPins(std::shared_ptr<wxGraphicsContext> graphics, int start_x, int start_y, int end_x, int end_y)
+void AndGate::DrawPins(DrawCommands &graphics, int start_x, int start_y, int end_x, int end_y)
 {
 }
 
@@ -21,13 +21,18 @@ class AndGate : public LogicGate {
 private:
 public:
     AndGate(SpartyBoots *spartyBoots);
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
-    void DrawPins(std::shared_ptr<wxGraphicsContext> graphics, int start_x, int start_y, int end_x, int end_y) override;
+    void Draw(DrawCommands &graphics) override;
+    void DrawPins(DrawCommands &graphics, int start_x, int start_y, int end_x, int end_y) override;
     bool HitTest(int x, int y) override;
     /**
     *Compute the logic. Depending on the object/gate
     ** */
     void GateCompute() override;
+    /**
+     * Get the kind of gate
+     * @return Kind::And
+     */
+    Kind GetKind() const override { return Kind::And; }
 };
 
 #endif // PROJECT1_CONVEYORLIB_ANDGATE_H
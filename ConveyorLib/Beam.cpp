@@ -5,6 +5,8 @@
 
 #include "pch.h"
 #include "Beam.hpp"
+#include "Snapshot.hpp"
+#include "WireBatch.hpp"
 
 /// Image for the beam sender and receiver when red
 const std::wstring BeamRedImage = L"beam-red.png";
@@ -29,24 +31,6 @@ const int BeamPinWidth = 40;
 /// Diameter to draw the pin in pixels
 const int PinSize = 10;
 
-/// Color to use for drawing a zero connection wire
-const wxColour ConnectionColorZero = *wxBLACK;
-
-/// Color to use for drawing a one connection wire
-const wxColour ConnectionColorOne = *wxRED;
-
-/// Color to use for drawing an unknown state connection wire
-const wxColour ConnectionColorUnknown = wxColour(128, 128, 128);
-
-/// Maximum offset of Bezier control points relative to line ends
-static constexpr double BezierMaxOffset = 200;
-
-/// Line with for drawing lines between pins
-static const int LineWidth = 3;
-
-/// Default length of line from the pin
-static const int DefaultLineLength = 20;
-
 /**
  * Initialization function for Beam
  * @param spartyBoots SpartyBoots
@@ -54,7 +38,7 @@ static const int DefaultLineLength = 20;
  * @param y int
  * @param sender int
  */
-Beam::Beam(SpartyBoots *spartyBoots, int x, int y, int sender) : LogicItem(spartyBoots),
+Beam::Beam(SpartyBoots *spartyBoots, int x, int y, int sender) : PinOwner(spartyBoots),
     mBeamRedImage(L"images/" + BeamRedImage, wxBITMAP_TYPE_ANY), mBeamRedBitmap(mBeamRedImage),
     mBeamGreenImage(L"images/" + BeamGreenImage, wxBITMAP_TYPE_ANY), mBeamGreenBitmap(mBeamGreenImage),
     mBeamGreenImageMirrored(L"images/" + BeamGreenImage, wxBITMAP_TYPE_ANY), mBeamGreenBitmapMirrored(mBeamGreenImage.Mirror(true)),
@@ -66,8 +50,7 @@ Beam::Beam(SpartyBoots *spartyBoots, int x, int y, int sender) : LogicItem(spart
      mY = y;
      mSender = sender;
     SetLocation(x, y);
-    mOutputPins.push_back(std::make_shared<OutputPin>(spartyBoots));
-    spartyBoots->Add(mOutputPins[0]);
+    AddOutputPin();
     mOutputPins[0]->setConnect((true));
 }
 
@@ -75,18 +58,19 @@ Beam::Beam(SpartyBoots *spartyBoots, int x, int y, int sender) : LogicItem(spart
  * Draw the beam.
  * @param graphics
  */
-void Beam::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void Beam::Draw(DrawCommands &graphics)
 {
+    double scale = GetSpartyBoots()->getScale();
 
     wxPen laser1(wxColour(255, 200, 200, 100), 8);
     wxPen laser2(wxColour(255, 0, 0, 175), 4);
 
-    graphics->SetPen(laser1);
-    graphics->StrokeLine(mX - ConveyorWidth - BeamPinOffset + 5, mY,
+    graphics.SetPen(laser1);
+    graphics.StrokeLine(mX - ConveyorWidth - BeamPinOffset + 5, mY,
                      mX, mY);
 
-    graphics->SetPen(laser2);
-    graphics->StrokeLine(mX - ConveyorWidth - BeamPinOffset + 5, mY,
+    graphics.SetPen(laser2);
+    graphics.StrokeLine(mX - ConveyorWidth - BeamPinOffset + 5, mY,
                      mX, mY);
 
     mOutputPins[0]->SetLocation(mX + 25 + BeamPinOffset,mY);
@@ -94,22 +78,22 @@ void Beam::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 
     if(!mItemTouchingBeam)
     {
-        wxPen wirePen(ConnectionColorZero,3);
-        graphics->SetPen(wirePen);
-        graphics->StrokeLine(mX, mY,mX + 100, mY);
+        wxPen wirePen(WireBatch::ConnectionColorZero, WireBatch::LineWidth);
+        graphics.SetPen(wirePen);
+        graphics.StrokeLine(mX, mY,mX + 100, mY);
 
-        graphics->DrawBitmap(mBeamGreenBitmap, mX - ConveyorWidth - BeamPinOffset, mY - (BeamPinHeight/2), BeamPinWidth, BeamPinHeight);
-        graphics->DrawBitmap(mBeamGreenBitmapMirrored, mX, mY - (BeamPinHeight/2), BeamPinWidth, BeamPinHeight);
+        mBeamGreenBitmap.Draw(graphics, scale, mX - ConveyorWidth - BeamPinOffset, mY - (BeamPinHeight/2), BeamPinWidth, BeamPinHeight);
+        mBeamGreenBitmapMirrored.Draw(graphics, scale, mX, mY - (BeamPinHeight/2), BeamPinWidth, BeamPinHeight);
 
     }
     else
     {
-        wxPen wirePen(ConnectionColorOne,3);
-        graphics->SetPen(wirePen);
-        graphics->StrokeLine(mX, mY,mX + 100, mY);
+        wxPen wirePen(WireBatch::ConnectionColorOne, WireBatch::LineWidth);
+        graphics.SetPen(wirePen);
+        graphics.StrokeLine(mX, mY,mX + 100, mY);
 
-        graphics->DrawBitmap(mBeamRedBitmap, mX - ConveyorWidth - BeamPinOffset, mY - (BeamPinHeight/2), BeamPinWidth, BeamPinHeight);
-        graphics->DrawBitmap(mBeamRedBitmapMirrored, mX, mY - (BeamPinHeight/2), BeamPinWidth, BeamPinHeight);
+        mBeamRedBitmap.Draw(graphics, scale, mX - ConveyorWidth - BeamPinOffset, mY - (BeamPinHeight/2), BeamPinWidth, BeamPinHeight);
+        mBeamRedBitmapMirrored.Draw(graphics, scale, mX, mY - (BeamPinHeight/2), BeamPinWidth, BeamPinHeight);
     }
 }
 /**
@@ -121,4 +105,24 @@ void Beam::SetItemTouchingBeam(bool itemTouching)
     mItemTouchingBeam = itemTouching;
     ///set output pin value to true or false when item comes by
     mOutputPins[0]->setValue(itemTouching);
-}
\ No newline at end of file
+}
+
+/**
+ * Save the state that changes as the game runs
+ * @param writer Snapshot to write to
+ */
+void Beam::SaveState(SnapshotWriter &writer)
+{
+    Item::SaveState(writer);
+    writer.Write(mItemTouchingBeam);
+}
+
+/**
+ * Restore the state saved by SaveState
+ * @param reader Snapshot to read from
+ */
+void Beam::LoadState(SnapshotReader &reader)
+{
+    Item::LoadState(reader);
+    reader.Read(mItemTouchingBeam);
+}
@@ -7,14 +7,15 @@
 
 #ifndef BEAM_HPP
 #define BEAM_HPP
-#include "LogicItem.hpp"
+#include "PinOwner.hpp"
+#include "ScaledBitmap.hpp"
 #include "SpartyBoots.hpp"
 #include "OutputPin.h"
 
 /**
 *Beam Class
 */
-class Beam : public LogicItem {
+class Beam : public PinOwner {
 private:
     /// X coordinate
     int mX;
@@ -25,32 +26,29 @@ private:
     /// Bool if item is touching the beam
     bool mItemTouchingBeam = false;
 
-    /// vector containing output pins
-    std::vector<std::shared_ptr<OutputPin>> mOutputPins;
-
     /// Image for the beam sender and receiver when red
     wxImage mBeamRedImage;
 
     /// The bitmap beam sender and receiver when red.
-    wxBitmap mBeamRedBitmap;
+    ScaledBitmap mBeamRedBitmap;
 
     /// Image for the beam sender and receiver when green
     wxImage mBeamGreenImage;
 
     /// The bitmap for beam sender and receiver when green.
-    wxBitmap mBeamGreenBitmap;
+    ScaledBitmap mBeamGreenBitmap;
 
     /// Image for the beam sender and receiver when green
     wxImage mBeamGreenImageMirrored;
 
     /// The bitmap for beam sender and receiver when green.
-    wxBitmap mBeamGreenBitmapMirrored;
+    ScaledBitmap mBeamGreenBitmapMirrored;
 
     /// Image for the beam sender and receiver when green
     wxImage mBeamRedImageMirrored;
 
     /// The bitmap for beam sender and receiver when green.
-    wxBitmap mBeamRedBitmapMirrored;
+    ScaledBitmap mBeamRedBitmapMirrored;
 
 
 public:
@@ -59,8 +57,10 @@ public:
      * getter for pins in list
      * @return mOutputPins
      */
-    std::vector<std::shared_ptr<OutputPin>> getPins(){ return mOutputPins; }
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    const std::vector<std::shared_ptr<OutputPin>> &getPins() const { return mOutputPins; }
+    void Draw(DrawCommands &graphics) override;
+    void SaveState(SnapshotWriter &writer) override;
+    void LoadState(SnapshotReader &reader) override;
     bool HitTest(int x, int y) override
     {
         return false;
@@ -76,7 +76,7 @@ public:
     /**
      * Empty draw pins function
      */
-    void DrawPins(std::shared_ptr<wxGraphicsContext>,int,int,int,int){};
+    void DrawPins(DrawCommands &,int,int,int,int){};
     void SetItemTouchingBeam(bool b);;
 };
 
@@ -0,0 +1,539 @@
+/**
+ * @file CircuitSolver.cpp
+ * @author Alex Mueller
+ */
+
+#include "pch.h"
+#include "CircuitSolver.hpp"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <thread>
+#include "LevelGenerator.hpp"
+#include "LoadLevel.h"
+
+using namespace std;
+
+/// Gate names as used in level files, in Kind order
+const wchar_t *KindNames[] = {L"and", L"or", L"not", L"sr", L"d"};
+
+/**
+ * Does a gate have two outputs?
+ * @param kind Kind of gate
+ * @return true for the flip-flops
+ */
+static bool IsFlipFlop(CircuitSolver::Kind kind)
+{
+    return kind == CircuitSolver::Kind::SR || kind == CircuitSolver::Kind::D;
+}
+
+/**
+ * Search state of one worker thread
+ */
+struct CircuitSolver::Search
+{
+    /// Every signal so far: the inputs then the gate outputs
+    vector<Bits> mSignals;
+    /// Gate that produced each signal, -1 for the inputs
+    vector<int> mSignalGate;
+    /// Gates placed so far
+    vector<Gate> mGates;
+    /// First signal of each gate
+    vector<int> mGateSignal;
+    /// Number of gate inputs wired to each gate
+    vector<int> mUses;
+    /// Index of the first gate choice this search started from
+    int mTask = 0;
+    /// Number of circuits evaluated
+    long long mCandidates = 0;
+    /// Signal wired to Sparty in the solution
+    int mOutput = -1;
+    /// Gate choices for each depth, kept to avoid allocating
+    vector<vector<Gate>> mChoices;
+    /// Gate outputs for each depth, kept to avoid allocating
+    vector<Bits> mOutputs;
+};
+
+/**
+ * Constructor
+ * @param options Search settings
+ */
+CircuitSolver::CircuitSolver(const Options &options) : mOptions(options) {}
+
+/**
+ * Build the rows for a level
+ * @param level Level with a sensor and products
+ */
+void CircuitSolver::SetLevel(LoadLevel &level)
+{
+    auto children = level.GetLevelSensorChildren();
+    auto products = level.GetLevelProducts();
+
+    mRows = (int)products.size() * 2;
+    mWords = max(1, (mRows + 63) / 64);
+    mInputs.assign(1 + children.size(), Bits(mWords, 0));
+    mTarget.assign(mWords, 0);
+    mCare.assign(mWords, 0);
+    mValid.assign(mWords, 0);
+
+    for (int row = 0; row < mRows; row++)
+    {
+        mValid[row / 64] |= uint64_t(1) << (row % 64);
+    }
+
+    for (size_t p = 0; p < products.size(); p++)
+    {
+        // Product fields are placement, shape, color, content, kick
+        auto &product = products[p];
+        int row = (int)p * 2 + 1;
+        auto bit = uint64_t(1) << (row % 64);
+        int word = row / 64;
+
+        mCare[word] |= bit;
+        mInputs[0][word] |= bit;
+        if (product.size() > 4 && product[4] == L"yes")
+        {
+            mTarget[word] |= bit;
+        }
+
+        for (size_t c = 0; c < children.size(); c++)
+        {
+            if (find(product.begin() + 1, product.begin() + min<size_t>(4, product.size()), children[c]) !=
+                product.begin() + min<size_t>(4, product.size()))
+            {
+                mInputs[c + 1][word] |= bit;
+            }
+        }
+    }
+}
+
+/**
+ * Search for the smallest circuit
+ * @return the circuit, if one with up to mMaxGates gates exists
+ */
+CircuitSolver::Result CircuitSolver::Solve()
+{
+    Result result;
+    auto start = chrono::steady_clock::now();
+
+    // The smallest circuit is a wire straight to Sparty
+    for (size_t s = 0; s < mInputs.size(); s++)
+    {
+        result.mCandidates++;
+        if (Matches(mInputs[s]))
+        {
+            result.mSolved = true;
+            result.mOutput = (int)s;
+            result.mSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            return result;
+        }
+    }
+
+    int threadCount = mOptions.mThreads > 0 ? mOptions.mThreads : max(1, (int)thread::hardware_concurrency());
+    for (mDepth = 1; mDepth <= mOptions.mMaxGates && !result.mSolved; mDepth++)
+    {
+        vector<Gate> first;
+        FirstGates(first);
+
+        vector<Search> solutions(first.size());
+        atomic<int> next{0};
+        atomic<long long> candidates{0};
+        mBestTask = INT_MAX;
+
+        auto worker = [&]() {
+            long long evaluated = 0;
+            for (int task = next++; task < (int)first.size() && task < mBestTask; task = next++)
+            {
+                Search search;
+                search.mTask = task;
+                search.mSignals = mInputs;
+                search.mSignalGate.assign(mInputs.size(), -1);
+                search.mChoices.resize(mDepth);
+                search.mOutputs.resize(mDepth * 2);
+                bool solved = Accept(search, first[task], 0);
+                evaluated += search.mCandidates;
+                if (solved)
+                {
+                    solutions[task] = move(search);
+
+                    // Tasks after this one can stop, earlier ones must finish
+                    int best = mBestTask;
+                    while (task < best && !mBestTask.compare_exchange_weak(best, task))
+                    {
+                    }
+                }
+            }
+            candidates += evaluated;
+        };
+
+        vector<thread> threads;
+        for (int t = 1; t < threadCount; t++)
+        {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto &t : threads)
+        {
+            t.join();
+        }
+
+        result.mCandidates += candidates;
+        if (mBestTask != INT_MAX)
+        {
+            auto &solution = solutions[mBestTask];
+            result.mSolved = true;
+            result.mGates = solution.mGates;
+            result.mOutput = solution.mOutput;
+        }
+    }
+
+    result.mSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+/**
+ * Every choice for a gate given the signals available
+ * @param gates Choices, appended to
+ * @param signals Number of signals available
+ * @param flipFlops Include flip-flops?
+ */
+static void GateChoices(vector<CircuitSolver::Gate> &gates, int signals, bool flipFlops)
+{
+    using Kind = CircuitSolver::Kind;
+    for (int a = 0; a < signals; a++)
+    {
+        for (int b = a + 1; b < signals; b++)
+        {
+            gates.push_back({Kind::And, {a, b}});
+            gates.push_back({Kind::Or, {a, b}});
+        }
+        gates.push_back({Kind::Not, {a, a}});
+    }
+
+    if (flipFlops)
+    {
+        for (int a = 0; a < signals; a++)
+        {
+            for (int b = 0; b < signals; b++)
+            {
+                if (a != b)
+                {
+                    gates.push_back({Kind::SR, {a, b}});
+                    gates.push_back({Kind::D, {a, b}});
+                }
+            }
+        }
+    }
+}
+
+/**
+ * The choices for the first gate, which are the parallel tasks
+ * @param gates Choices
+ */
+void CircuitSolver::FirstGates(std::vector<Gate> &gates) const
+{
+    gates.clear();
+    GateChoices(gates, (int)mInputs.size(), mOptions.mFlipFlops);
+}
+
+/**
+ * Try every choice for the next gate
+ * @param search Search state
+ * @param depth Position of the gate
+ * @return true if a solution was found
+ */
+bool CircuitSolver::Place(Search &search, int depth) const
+{
+    // An earlier task already has a solution at this depth
+    if (mBestTask < search.mTask)
+    {
+        return false;
+    }
+
+    auto &choices = search.mChoices[depth];
+    choices.clear();
+    GateChoices(choices, (int)search.mSignals.size(), mOptions.mFlipFlops);
+    for (auto &gate : choices)
+    {
+        if (Accept(search, gate, depth))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Evaluate a gate at a position and continue the search with it
+ * @param search Search state
+ * @param gate Gate to place
+ * @param depth Position of the gate
+ * @return true if a solution was found
+ */
+bool CircuitSolver::Accept(Search &search, const Gate &gate, int depth) const
+{
+    search.mCandidates++;
+
+    auto &signals = search.mSignals;
+    auto &q = search.mOutputs[depth * 2];
+    auto &qn = search.mOutputs[depth * 2 + 1];
+    bool twoOutputs = Evaluate(gate.mKind, signals[gate.mInputs[0]], signals[gate.mInputs[1]], q, qn);
+
+    // A gate that computes a signal we already have is redundant
+    for (auto &signal : signals)
+    {
+        if (signal == q)
+        {
+            return false;
+        }
+    }
+
+    int gateIndex = (int)search.mGates.size();
+    int inputCount = gate.mKind == Kind::Not ? 1 : 2;
+    auto use = [&](int delta) {
+        for (int i = 0; i < inputCount; i++)
+        {
+            int from = search.mSignalGate[gate.mInputs[i]];
+            if (from >= 0)
+            {
+                search.mUses[from] += delta;
+            }
+        }
+    };
+
+    if (depth == mDepth - 1)
+    {
+        // The last gate drives Sparty, so every other gate must be in use
+        use(1);
+        bool allUsed = all_of(search.mUses.begin(), search.mUses.end(), [](int uses) { return uses > 0; });
+        use(-1);
+        if (!allUsed)
+        {
+            return false;
+        }
+
+        int output = -1;
+        if (Matches(q))
+        {
+            output = (int)signals.size();
+        }
+        else if (twoOutputs && Matches(qn))
+        {
+            output = (int)signals.size() + 1;
+        }
+        if (output < 0)
+        {
+            return false;
+        }
+
+        search.mGates.push_back(gate);
+        search.mGateSignal.push_back((int)signals.size());
+        search.mOutput = output;
+        return true;
+    }
+
+    // Independent neighbours could be swapped, so keep them in order of output
+    if (gateIndex > 0)
+    {
+        int previous = gateIndex - 1;
+        bool dependent = false;
+        for (int i = 0; i < inputCount; i++)
+        {
+            dependent = dependent || search.mSignalGate[gate.mInputs[i]] == previous;
+        }
+        if (!dependent && !(signals[search.mGateSignal[previous]] < q))
+        {
+            return false;
+        }
+    }
+
+    // Each remaining gate can put at most two unused gates to use
+    use(1);
+    int unused = (int)count(search.mUses.begin(), search.mUses.end(), 0) + 1;
+    if (unused > 2 * (mDepth - 1 - depth))
+    {
+        use(-1);
+        return false;
+    }
+
+    search.mGates.push_back(gate);
+    search.mGateSignal.push_back((int)signals.size());
+    search.mUses.push_back(0);
+    signals.push_back(q);
+    search.mSignalGate.push_back(gateIndex);
+    if (twoOutputs)
+    {
+        signals.push_back(qn);
+        search.mSignalGate.push_back(gateIndex);
+    }
+
+    if (Place(search, depth + 1))
+    {
+        return true;
+    }
+
+    signals.resize(search.mGateSignal.back());
+    search.mSignalGate.resize(signals.size());
+    search.mGateSignal.pop_back();
+    search.mGates.pop_back();
+    search.mUses.pop_back();
+    use(-1);
+    return false;
+}
+
+/**
+ * Does a signal make Sparty kick the right products?
+ * @param bits Signal
+ * @return true if it matches on every product row
+ */
+bool CircuitSolver::Matches(const Bits &bits) const
+{
+    for (int w = 0; w < mWords; w++)
+    {
+        if (((bits[w] ^ mTarget[w]) & mCare[w]) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Evaluate a gate over every row. Flip-flops behave like the game's
+ * SRFlipFlop and DFlipFlop, both outputs start at zero.
+ * @param kind Kind of gate
+ * @param a First input
+ * @param b Second input, ignored by not
+ * @param q Output
+ * @param qn Inverted output of a flip-flop
+ * @return true if the gate has two outputs
+ */
+bool CircuitSolver::Evaluate(Kind kind, const Bits &a, const Bits &b, Bits &q, Bits &qn) const
+{
+    q.assign(mWords, 0);
+    switch (kind)
+    {
+    case Kind::And:
+        for (int w = 0; w < mWords; w++)
+        {
+            q[w] = a[w] & b[w];
+        }
+        return false;
+
+    case Kind::Or:
+        for (int w = 0; w < mWords; w++)
+        {
+            q[w] = a[w] | b[w];
+        }
+        return false;
+
+    case Kind::Not:
+        for (int w = 0; w < mWords; w++)
+        {
+            q[w] = ~a[w] & mValid[w];
+        }
+        return false;
+
+    default:
+        break;
+    }
+
+    qn.assign(mWords, 0);
+    bool qValue = false, qnValue = false;
+    for (int row = 0; row < mRows; row++)
+    {
+        int word = row / 64;
+        auto bit = uint64_t(1) << (row % 64);
+        bool first = (a[word] & bit) != 0;
+        bool second = (b[word] & bit) != 0;
+
+        if (kind == Kind::SR)
+        {
+            if (first != second)
+            {
+                qValue = first;
+                qnValue = second;
+            }
+        }
+        else if (second)
+        {
+            // D is copied while the clock is high
+            qValue = first;
+            qnValue = !first;
+        }
+
+        if (qValue)
+        {
+            q[word] |= bit;
+        }
+        if (qnValue)
+        {
+            qn[word] |= bit;
+        }
+    }
+    return true;
+}
+
+/**
+ * Name of a signal in a solution as used by wires in a level file
+ * @param result Solution
+ * @param signal Signal number
+ * @return Pin name
+ */
+wxString CircuitSolver::SignalName(const Result &result, int signal) const
+{
+    if (signal == 0)
+    {
+        return L"beam";
+    }
+
+    int sensors = (int)mInputs.size() - 1;
+    if (signal <= sensors)
+    {
+        return wxString::Format(L"sensor.%d", signal - 1);
+    }
+
+    int first = sensors + 1;
+    for (size_t g = 0; g < result.mGates.size(); g++)
+    {
+        int outputs = IsFlipFlop(result.mGates[g].mKind) ? 2 : 1;
+        if (signal < first + outputs)
+        {
+            return wxString::Format(L"gate.%d.%d", (int)g, signal - first);
+        }
+        first += outputs;
+    }
+    return wxString();
+}
+
+/**
+ * Add the gate and wire records for a solution to a level
+ * @param result Solution from Solve
+ * @param level Level to add to, should not already have gates
+ */
+void CircuitSolver::AddSolution(const Result &result, LoadLevel &level) const
+{
+    if (!result.mSolved)
+    {
+        return;
+    }
+
+    for (size_t g = 0; g < result.mGates.size(); g++)
+    {
+        auto location = LevelGenerator::GateLocation((int)g);
+        level.AddRecord({L"gate", KindNames[(int)result.mGates[g].mKind], wxString::Format(L"%d", location.x),
+                         wxString::Format(L"%d", location.y)});
+    }
+
+    for (size_t g = 0; g < result.mGates.size(); g++)
+    {
+        auto &gate = result.mGates[g];
+        int inputCount = gate.mKind == Kind::Not ? 1 : 2;
+        for (int i = 0; i < inputCount; i++)
+        {
+            level.AddRecord({L"wire", SignalName(result, gate.mInputs[i]), wxString::Format(L"gate.%d.%d", (int)g, i)});
+        }
+    }
+
+    level.AddRecord({L"wire", SignalName(result, result.mOutput), L"sparty"});
+}
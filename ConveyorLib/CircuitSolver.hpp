@@ -0,0 +1,137 @@
+/**
+ * @file CircuitSolver.hpp
+ * @author Alex Mueller
+ *
+ * Searches for the smallest circuit that solves a level
+ */
+
+#ifndef CIRCUITSOLVER_HPP
+#define CIRCUITSOLVER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+class LoadLevel;
+
+/**
+ * Finds the smallest circuit of and/or/not gates and flip-flops that
+ * wires the beam and sensor outputs to Sparty so he kicks exactly the
+ * products marked kick="yes".
+ *
+ * The level is turned into a list of rows: an idle row with nothing in
+ * front of the beam, then a row for the product in front of the beam,
+ * for each product in order. Every signal is a bit set over the rows,
+ * so a combinational gate evaluates every row with a few word
+ * operations. Flip-flops are evaluated row by row since they depend
+ * on the order. Only the product rows have to match, but the idle rows
+ * still matter for the flip-flops.
+ *
+ * Circuits are searched by iterative deepening on the number of gates,
+ * so the first circuit found is the smallest. The choices for the first
+ * gate are split across threads. Symmetric and redundant circuits are
+ * pruned: commutative inputs are ordered, a gate that computes a signal
+ * we already have is skipped, every gate must be used, and independent
+ * neighbouring gates must be in order of their outputs.
+ */
+class CircuitSolver {
+public:
+    /**
+     * Search settings
+     */
+    struct Options
+    {
+        /// Largest circuit to try
+        int mMaxGates = 5;
+        /// Number of threads, 0 for one per core
+        int mThreads = 0;
+        /// Try SR and D flip-flops too
+        bool mFlipFlops = true;
+    };
+
+    /// Kinds of gates, in the order they are tried
+    enum class Kind
+    {
+        And,
+        Or,
+        Not,
+        SR,
+        D
+    };
+
+    /**
+     * A gate in a solution
+     */
+    struct Gate
+    {
+        /// Kind of gate
+        Kind mKind;
+        /// Signals wired to the inputs, the second is unused for not
+        int mInputs[2];
+    };
+
+    /**
+     * Outcome of a search
+     */
+    struct Result
+    {
+        /// Was a circuit found?
+        bool mSolved = false;
+        /// Gates in the circuit, in evaluation order
+        std::vector<Gate> mGates;
+        /// Signal wired to Sparty
+        int mOutput = -1;
+        /// Number of circuits evaluated, a measure of how hard the level is
+        long long mCandidates = 0;
+        /// Time taken in seconds
+        double mSeconds = 0;
+    };
+
+    explicit CircuitSolver(const Options &options);
+
+    void SetLevel(LoadLevel &level);
+    Result Solve();
+    void AddSolution(const Result &result, LoadLevel &level) const;
+    wxString SignalName(const Result &result, int signal) const;
+
+    /**
+     * Number of rows in the truth table
+     * @return rows, two per product
+     */
+    int GetRowCount() const { return mRows; }
+
+private:
+    /// A signal value for every row
+    using Bits = std::vector<uint64_t>;
+
+    /// Search state of one worker thread
+    struct Search;
+
+    bool Matches(const Bits &bits) const;
+    bool Evaluate(Kind kind, const Bits &a, const Bits &b, Bits &q, Bits &qn) const;
+    void FirstGates(std::vector<Gate> &gates) const;
+    bool Place(Search &search, int depth) const;
+    bool Accept(Search &search, const Gate &gate, int depth) const;
+
+    /// Search settings
+    Options mOptions;
+    /// Number of rows
+    int mRows = 0;
+    /// Number of 64 bit words per signal
+    int mWords = 0;
+    /// Input signals: the beam then the sensor outputs
+    std::vector<Bits> mInputs;
+    /// Rows where Sparty should kick
+    Bits mTarget;
+    /// Rows that have to match, the product rows
+    Bits mCare;
+    /// Rows that exist, to keep the unused bits clear
+    Bits mValid;
+
+    /// Depth being searched
+    int mDepth = 0;
+    /// Lowest index of a first gate that led to a solution at this depth
+    std::atomic<int> mBestTask{0};
+};
+
+#endif // CIRCUITSOLVER_HPP
@@ -6,6 +6,7 @@
 
 #include "pch.h"
 #include "Conveyor.hpp"
+#include "Snapshot.hpp"
 #include <string>
 #include "SpartyBoots.hpp"
 
@@ -62,25 +63,26 @@ Conveyor::Conveyor(SpartyBoots *game, double x, double y, int height, int speed,
  * Draw the conveyor.
  * @param graphics
  */
-void Conveyor::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void Conveyor::Draw(DrawCommands &graphics)
 {
+    double scale = GetSpartyBoots()->getScale();
     int x = GetX(), y = GetY();
     if (mRunning)
     {
-        graphics->DrawBitmap(mPanelStopBitmap, x + mPanelX, y + mPanelY, PanelWidth, PanelHeight);
+        mPanelStopBitmap.Draw(graphics, scale, x + mPanelX, y + mPanelY, PanelWidth, PanelHeight);
     }
     else
     {
-        graphics->DrawBitmap(mPanelStartBitmap, x + mPanelX, y + mPanelY, PanelWidth, PanelHeight);
+        mPanelStartBitmap.Draw(graphics, scale, x + mPanelX, y + mPanelY, PanelWidth, PanelHeight);
     }
-    graphics->DrawBitmap(mBackgroundBitmap, x - (ConveyorWidth / 2), y - (mHeight / 2), ConveyorWidth, mHeight);
+    mBackgroundBitmap.Draw(graphics, scale, x - (ConveyorWidth / 2), y - (mHeight / 2), ConveyorWidth, mHeight);
 
-    graphics->PushState();
-    graphics->Clip(x - (ConveyorWidth / 2), y - (mHeight / 2), ConveyorWidth, mHeight);
-    graphics->DrawBitmap(mBeltBitmap, x - (ConveyorWidth / 2), y - (mHeight / 2) + (mBeltOffset % mHeight) - mHeight, ConveyorWidth,
+    graphics.PushState();
+    graphics.Clip(x - (ConveyorWidth / 2), y - (mHeight / 2), ConveyorWidth, mHeight);
+    mBeltBitmap.Draw(graphics, scale, x - (ConveyorWidth / 2), y - (mHeight / 2) + (mBeltOffset % mHeight) - mHeight, ConveyorWidth,
                          mHeight);
-    graphics->DrawBitmap(mBeltBitmap, x - (ConveyorWidth / 2), y - (mHeight / 2) + (mBeltOffset % mHeight), ConveyorWidth, mHeight);
-    graphics->PopState();
+    mBeltBitmap.Draw(graphics, scale, x - (ConveyorWidth / 2), y - (mHeight / 2) + (mBeltOffset % mHeight), ConveyorWidth, mHeight);
+    graphics.PopState();
 }
 
 /**
@@ -129,3 +131,25 @@ void Conveyor::SetProductClip(std::shared_ptr<Product> item)
 {
     item->UpdateClipRegion(wxRect(GetX() - ConveyorWidth / 2, GetY() - mHeight / 2, ConveyorWidth, mHeight));
 }
+
+/**
+ * Save the state that changes as the game runs
+ * @param writer Snapshot to write to
+ */
+void Conveyor::SaveState(SnapshotWriter &writer)
+{
+    Item::SaveState(writer);
+    writer.Write(mRunning);
+    writer.Write(mBeltOffset);
+}
+
+/**
+ * Restore the state saved by SaveState
+ * @param reader Snapshot to read from
+ */
+void Conveyor::LoadState(SnapshotReader &reader)
+{
+    Item::LoadState(reader);
+    reader.Read(mRunning);
+    reader.Read(mBeltOffset);
+}
@@ -8,6 +8,7 @@
 #define CONVEYORLIB_CONVEYOR_HPP
 
 #include "Item.hpp"
+#include "ScaledBitmap.hpp"
 #include "Product.h"
 /**
  * Conveyor Class
@@ -32,34 +33,36 @@ class Conveyor : public Item {
     wxImage mBackgroundImage;
 
     /// The bitmap for the conveyor background.
-    wxBitmap mBackgroundBitmap;
+    ScaledBitmap mBackgroundBitmap;
 
     /// The image for the conveyor belt.
     wxImage mBeltImage;
 
     /// The bitmap for the conveyor belt.
-    wxBitmap mBeltBitmap;
+    ScaledBitmap mBeltBitmap;
 
     /// The image for the panel (start).
     wxImage mPanelStartImage;
 
     /// The bitmap for the panel (start).
-    wxBitmap mPanelStartBitmap;
+    ScaledBitmap mPanelStartBitmap;
 
     /// The image for the panel (stop).
     wxImage mPanelStopImage;
 
     /// The bitmap for the panel (stop).
-    wxBitmap mPanelStopBitmap;
+    ScaledBitmap mPanelStopBitmap;
 
     /// The position of the conveyor belt.
     int mBeltOffset = 0;
 
 public:
     Conveyor(SpartyBoots *game, double x, double y, int height, int speed, int panelX, int panelY);
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void Draw(DrawCommands &graphics) override;
     bool HitTest(int x, int y) override;
     void Update(double elapsed) override;
+    void SaveState(SnapshotWriter &writer) override;
+    void LoadState(SnapshotReader &reader) override;
     void SetProductClip(std::shared_ptr<Product> item);
     /**
      * getter for the boolean that indicates if conveyor is running
@@ -44,24 +44,18 @@ DFlipFlop::DFlipFlop(SpartyBoots *spartyBoots) : LogicGate(spartyBoots)
     auto h = DFlipFlopSize.GetHeight(); // Height of the AND gate
 
     /// Creating a vector of pins and initializing them at the same time
-    mInputPins.push_back(std::make_shared<InputPin>(spartyBoots));
-    mInputPins.push_back(std::make_shared<InputPin>(spartyBoots));
-    mOutputPins.push_back(std::make_shared<OutputPin>(spartyBoots));
-    mOutputPins.push_back(std::make_shared<OutputPin>(spartyBoots));
+    AddInputPin();
+    AddInputPin();
+    AddOutputPin();
+    AddOutputPin();
 
     /// setting the pins location to be exactly where I drew them.
     mInputPins[0]->SetLocation(x - w / 2 - DefaultLineLength, y - h/4);
     mInputPins[1]->SetLocation(x - w / 2 - DefaultLineLength, y + h/4);
     mOutputPins[0]->SetLocation(x + w / 2 + DefaultLineLength, y - h/4);
     mOutputPins[1]->SetLocation(x + w / 2 + DefaultLineLength, y + h/4);
-
-    /// Adding the pins to spartyboots so that it recognizes it when hittesting
-    spartyBoots->Add(mInputPins[0]);
-    spartyBoots->Add(mOutputPins[0]);
-    spartyBoots->Add(mInputPins[1]);
-    spartyBoots->Add(mOutputPins[1]);
 }
-void DFlipFlop::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void DFlipFlop::Draw(DrawCommands &graphics)
 {
     auto x = GetX();
     auto y = GetY();
@@ -69,22 +63,22 @@ void DFlipFlop::Draw(std::shared_ptr<wxGraphicsContext> graphics)
     auto h = DFlipFlopSize.GetHeight();
 
     // Create a path for the D flip-flop body
-    auto path = graphics->CreatePath();
+    auto path = graphics.CreatePath();
     path.AddRectangle(x - w / 2, y - h / 2, w, h);
 
     // Draw the main body rectangle
-    graphics->SetPen(*wxBLACK_PEN);
-    graphics->SetBrush(*wxWHITE_BRUSH);
-    graphics->DrawPath(path);
+    graphics.SetPen(*wxBLACK_PEN);
+    graphics.SetBrush(*wxWHITE_BRUSH);
+    graphics.DrawPath(path);
 
     // Set up font for the labels
     wxFont font(15, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_BOLD, false, "Arial");
-    graphics->SetFont(font, *wxBLACK);
+    graphics.SetFont(font, *wxBLACK);
 
     // Draw labels "D", "Q", and "Q'"
-    graphics->DrawText("D", x - w / 2 + DFlipFlopLabelMargin, y - h / 4 - 8);
-    graphics->DrawText("Q", x + w / 2 - DFlipFlopLabelMargin - 15, y - h / 4 - 8);
-    graphics->DrawText("Q'", x + w / 2 - DFlipFlopLabelMargin - 15, y + h / 4 - 8);
+    graphics.DrawText("D", x - w / 2 + DFlipFlopLabelMargin, y - h / 4 - 8);
+    graphics.DrawText("Q", x + w / 2 - DFlipFlopLabelMargin - 15, y - h / 4 - 8);
+    graphics.DrawText("Q'", x + w / 2 - DFlipFlopLabelMargin - 15, y + h / 4 - 8);
 
     // Position the triangle so that its left side aligns with the rectangle's left edge
     wxPoint2DDouble p1(x - w / 2 + DFlipFlopClockSize, y + h / 4);               // Right point of the triangle
@@ -92,7 +86,7 @@ void DFlipFlop::Draw(std::shared_ptr<wxGraphicsContext> graphics)
     wxPoint2DDouble p3(x - w / 2, y + h / 4 + DFlipFlopClockSize / 2);           // Bottom corner aligned with left edge of the rectangle
 
     // Create a path for the hollow triangle
-    auto clockPath = graphics->CreatePath();
+    auto clockPath = graphics.CreatePath();
     clockPath.MoveToPoint(p1);
     clockPath.AddLineToPoint(p2);
     clockPath.AddLineToPoint(p3);
@@ -112,9 +106,9 @@ void DFlipFlop::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 
 
     // Draw the hollow triangle with only the outline
-    graphics->SetBrush(*wxTRANSPARENT_BRUSH);  // Set brush to transparent for a hollow effect
-    graphics->SetPen(*wxBLACK_PEN);            // Outline color
-    graphics->DrawPath(clockPath);
+    graphics.SetBrush(*wxTRANSPARENT_BRUSH);  // Set brush to transparent for a hollow effect
+    graphics.SetPen(*wxBLACK_PEN);            // Outline color
+    graphics.DrawPath(clockPath);
 }
 
 bool DFlipFlop::HitTest(int x, int y)
@@ -160,7 +154,7 @@ void DFlipFlop::GateCompute()
     }
 }
 
-void DFlipFlop::DrawPins(std::shared_ptr<wxGraphicsContext> graphics, int start_x, int start_y, int end_x, int end_y)
+void DFlipFlop::DrawPins(DrawCommands &graphics, int start_x, int start_y, int end_x, int end_y)
 {
 
 }
\ No newline at end of file
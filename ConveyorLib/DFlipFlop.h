@@ -23,10 +23,15 @@ class DFlipFlop : public LogicGate
 private:
 public:
     DFlipFlop(SpartyBoots *spartyBoots);
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void Draw(DrawCommands &graphics) override;
     bool HitTest(int x, int y) override;
     void GateCompute() override;
-    void DrawPins(std::shared_ptr<wxGraphicsContext> graphics, int start_x, int start_y, int end_x, int end_y) override;
+    /**
+     * Get the kind of gate
+     * @return Kind::D
+     */
+    Kind GetKind() const override { return Kind::D; }
+    void DrawPins(DrawCommands &graphics, int start_x, int start_y, int end_x, int end_y) override;
 };
 
 #endif //PROJECT1_CONVEYORLIB_DFLIPFLOP_H
@@ -0,0 +1,136 @@
+/**
+ * @file DrawCommands.cpp
+ * @author Alex Mueller
+ */
+
+#include "pch.h"
+#include "DrawCommands.hpp"
+
+/**
+ * Remove every command, ready to record the next frame
+ */
+void DrawCommands::Clear()
+{
+    mCommands.clear();
+    mPens.clear();
+    mBrushes.clear();
+    mFonts.clear();
+    mBitmaps.clear();
+    mTexts.clear();
+    mSegments.clear();
+}
+
+/**
+ * Set the pen lines and outlines are drawn with
+ * @param pen Pen to use
+ */
+void DrawCommands::SetPen(const wxPen &pen)
+{
+    Add(Op::SetPen, (unsigned int)mPens.size());
+    mPens.push_back(pen);
+}
+
+/**
+ * Set the brush shapes are filled with
+ * @param brush Brush to use
+ */
+void DrawCommands::SetBrush(const wxBrush &brush)
+{
+    Add(Op::SetBrush, (unsigned int)mBrushes.size());
+    mBrushes.push_back(brush);
+}
+
+/**
+ * Set the font text is drawn in
+ * @param font Font to use
+ * @param colour Color of the text
+ */
+void DrawCommands::SetFont(const wxFont &font, const wxColour &colour)
+{
+    Add(Op::SetFont, (unsigned int)mFonts.size());
+    mFonts.push_back({font, 0, wxString(), 0, colour});
+}
+
+/**
+ * Set the font text is drawn in, by its height in pixels
+ * @param pixelSize Height of the font in pixels
+ * @param faceName Name of the font
+ * @param flags wxFontFlag values, like wxFONTFLAG_BOLD
+ * @param colour Color of the text
+ */
+void DrawCommands::SetFont(double pixelSize, const wxString &faceName, int flags, const wxColour &colour)
+{
+    Add(Op::SetFont, (unsigned int)mFonts.size());
+    mFonts.push_back({wxFont(), pixelSize, faceName, flags, colour});
+}
+
+/**
+ * Draw a bitmap stretched to a rectangle
+ * @param bitmap Bitmap to draw
+ * @param x X of the top left
+ * @param y Y of the top left
+ * @param width Width
+ * @param height Height
+ */
+void DrawCommands::DrawBitmap(const wxBitmap &bitmap, double x, double y, double width, double height)
+{
+    Add(Op::DrawBitmap, (unsigned int)mBitmaps.size(), x, y, width, height);
+    mBitmaps.push_back(bitmap);
+}
+
+/**
+ * Draw text in the font
+ * @param text Text to draw
+ * @param x X of the top left
+ * @param y Y of the top left
+ */
+void DrawCommands::DrawText(const wxString &text, double x, double y)
+{
+    Add(Op::DrawText, (unsigned int)mTexts.size(), x, y);
+    mTexts.push_back(text);
+}
+
+/**
+ * Draw text centered on a point over a box filled with the brush.
+ * The size of the text is only known when it is rendered.
+ * @param text Text to draw
+ * @param centerX X of the center
+ * @param centerY Y of the center
+ * @param padding Space between the text and the left and right of the box
+ */
+void DrawCommands::DrawTextBox(const wxString &text, double centerX, double centerY, double padding)
+{
+    Add(Op::DrawTextBox, (unsigned int)mTexts.size(), centerX, centerY, padding);
+    mTexts.push_back(text);
+}
+
+/**
+ * Fill a path with the brush and outline it with the pen
+ * @param path Path to draw
+ */
+void DrawCommands::DrawPath(const Path &path)
+{
+    AddPath(Op::DrawPath, path);
+}
+
+/**
+ * Outline a path with the pen
+ * @param path Path to draw
+ */
+void DrawCommands::StrokePath(const Path &path)
+{
+    AddPath(Op::StrokePath, path);
+}
+
+/**
+ * Append a path command, copying the segments into the buffer
+ * @param op DrawPath or StrokePath
+ * @param path Path to add
+ */
+void DrawCommands::AddPath(Op op, const Path &path)
+{
+    auto &segments = path.GetSegments();
+    Add(op, (unsigned int)mSegments.size());
+    mCommands.back().mCount = (unsigned int)segments.size();
+    mSegments.insert(mSegments.end(), segments.begin(), segments.end());
+}
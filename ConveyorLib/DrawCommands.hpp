@@ -0,0 +1,329 @@
+/**
+ * @file DrawCommands.hpp
+ * @author Alex Mueller
+ *
+ * A frame recorded as a list of drawing operations
+ */
+
+#ifndef DRAWCOMMANDS_HPP
+#define DRAWCOMMANDS_HPP
+
+#include <memory>
+#include <vector>
+
+/**
+ * Command buffer the items draw into instead of a graphics context.
+ *
+ * The calls mirror the wxGraphicsContext calls the items used to make.
+ * Each one appends a small fixed size command. Pens, brushes, fonts,
+ * bitmaps, text and path segments go in side tables the command
+ * indexes. Nothing needs a graphics context until a Renderer draws
+ * the buffer, so a frame can be recorded anywhere. It can also be
+ * kept, inspected or rendered more than once.
+ */
+class DrawCommands {
+public:
+    /// The drawing operations
+    enum class Op : unsigned char
+    {
+        PushState,     ///< Save the transform, clip, pen, brush and font
+        PopState,      ///< Restore them
+        Translate,     ///< mA, mB: offset
+        Scale,         ///< mA, mB: scale
+        Rotate,        ///< mA: angle in radians
+        Clip,          ///< mA..mD: rectangle
+        SetPen,        ///< mIndex: pen
+        SetBrush,      ///< mIndex: brush
+        SetFont,       ///< mIndex: font
+        DrawRectangle, ///< mA..mD: rectangle
+        DrawEllipse,   ///< mA..mD: bounding rectangle
+        DrawBitmap,    ///< mIndex: bitmap, mA..mD: rectangle
+        StrokeLine,    ///< mA, mB to mC, mD
+        DrawText,      ///< mIndex: text, mA, mB: top left
+        DrawTextBox,   ///< mIndex: text, mA, mB: center, mC: padding
+        DrawPath,      ///< mIndex: first segment, mCount: segments
+        StrokePath     ///< mIndex: first segment, mCount: segments
+    };
+
+    /// One recorded operation
+    struct Command
+    {
+        /// What to do
+        Op mOp;
+        /// Number of path segments
+        unsigned int mCount;
+        /// Index into the side table for the operation
+        unsigned int mIndex;
+        /// Arguments
+        double mA, mB, mC, mD;
+    };
+
+    /// The kinds of path segment
+    enum class SegmentType : unsigned char
+    {
+        MoveTo,    ///< mX[0], mY[0]
+        LineTo,    ///< mX[0], mY[0]
+        CurveTo,   ///< Control points 0 and 1, end at 2
+        Rectangle, ///< mX[0], mY[0], width mX[1], height mY[1]
+        Close      ///< Close the subpath
+    };
+
+    /// One segment of a path
+    struct Segment
+    {
+        /// What kind of segment
+        SegmentType mType;
+        /// X of the points
+        double mX[3];
+        /// Y of the points
+        double mY[3];
+    };
+
+    /**
+     * A path built up by an item, the way a wxGraphicsPath is
+     */
+    class Path {
+    public:
+        /**
+         * Start a new subpath
+         * @param x X location
+         * @param y Y location
+         */
+        void MoveToPoint(double x, double y) { mSegments.push_back({SegmentType::MoveTo, {x}, {y}}); }
+        /**
+         * Start a new subpath
+         * @param point Location
+         */
+        void MoveToPoint(const wxPoint2DDouble &point) { MoveToPoint(point.m_x, point.m_y); }
+        /**
+         * Add a line from the current point
+         * @param x X of the end
+         * @param y Y of the end
+         */
+        void AddLineToPoint(double x, double y) { mSegments.push_back({SegmentType::LineTo, {x}, {y}}); }
+        /**
+         * Add a line from the current point
+         * @param point End of the line
+         */
+        void AddLineToPoint(const wxPoint2DDouble &point) { AddLineToPoint(point.m_x, point.m_y); }
+        /**
+         * Add a cubic Bezier curve from the current point
+         * @param cx1 X of the first control point
+         * @param cy1 Y of the first control point
+         * @param cx2 X of the second control point
+         * @param cy2 Y of the second control point
+         * @param x X of the end
+         * @param y Y of the end
+         */
+        void AddCurveToPoint(double cx1, double cy1, double cx2, double cy2, double x, double y)
+        {
+            mSegments.push_back({SegmentType::CurveTo, {cx1, cx2, x}, {cy1, cy2, y}});
+        }
+        /**
+         * Add a cubic Bezier curve from the current point
+         * @param c1 First control point
+         * @param c2 Second control point
+         * @param point End of the curve
+         */
+        void AddCurveToPoint(const wxPoint2DDouble &c1, const wxPoint2DDouble &c2, const wxPoint2DDouble &point)
+        {
+            AddCurveToPoint(c1.m_x, c1.m_y, c2.m_x, c2.m_y, point.m_x, point.m_y);
+        }
+        /**
+         * Add a closed rectangle
+         * @param x X of the top left
+         * @param y Y of the top left
+         * @param width Width
+         * @param height Height
+         */
+        void AddRectangle(double x, double y, double width, double height)
+        {
+            mSegments.push_back({SegmentType::Rectangle, {x, width}, {y, height}});
+        }
+        /**
+         * Close the current subpath
+         */
+        void CloseSubpath() { mSegments.push_back({SegmentType::Close, {}, {}}); }
+
+        /**
+         * The segments of the path
+         * @return segments
+         */
+        const std::vector<Segment> &GetSegments() const { return mSegments; }
+
+    private:
+        /// The segments, in order
+        std::vector<Segment> mSegments;
+    };
+
+    /// A font and its color
+    struct Font
+    {
+        /// The font, or not ok to make one from the fields below
+        wxFont mFont;
+        /// Height in pixels when there is no mFont
+        double mPixelSize;
+        /// Face name when there is no mFont
+        wxString mFaceName;
+        /// wxFontFlag values when there is no mFont
+        int mFlags;
+        /// Color of the text
+        wxColour mColour;
+    };
+
+    void Clear();
+
+    /**
+     * Start a path, to add with DrawPath or StrokePath
+     * @return empty path
+     */
+    Path CreatePath() const { return Path(); }
+
+    /// Save the transform, clip, pen, brush and font
+    void PushState() { Add(Op::PushState); }
+    /// Restore the state saved by the matching PushState
+    void PopState() { Add(Op::PopState); }
+    /**
+     * Move the origin
+     * @param dx X offset
+     * @param dy Y offset
+     */
+    void Translate(double dx, double dy) { Add(Op::Translate, 0, dx, dy); }
+    /**
+     * Scale the coordinates
+     * @param sx X scale
+     * @param sy Y scale
+     */
+    void Scale(double sx, double sy) { Add(Op::Scale, 0, sx, sy); }
+    /**
+     * Rotate the coordinates
+     * @param angle Angle in radians
+     */
+    void Rotate(double angle) { Add(Op::Rotate, 0, angle); }
+    /**
+     * Clip to a rectangle until the state is popped
+     * @param x X of the top left
+     * @param y Y of the top left
+     * @param width Width
+     * @param height Height
+     */
+    void Clip(double x, double y, double width, double height) { Add(Op::Clip, 0, x, y, width, height); }
+
+    void SetPen(const wxPen &pen);
+    void SetBrush(const wxBrush &brush);
+    void SetFont(const wxFont &font, const wxColour &colour);
+    void SetFont(double pixelSize, const wxString &faceName, int flags, const wxColour &colour);
+
+    /**
+     * Draw a rectangle with the pen and brush
+     * @param x X of the top left
+     * @param y Y of the top left
+     * @param width Width
+     * @param height Height
+     */
+    void DrawRectangle(double x, double y, double width, double height) { Add(Op::DrawRectangle, 0, x, y, width, height); }
+    /**
+     * Draw an ellipse with the pen and brush
+     * @param x X of the top left of the bounding rectangle
+     * @param y Y of the top left of the bounding rectangle
+     * @param width Width
+     * @param height Height
+     */
+    void DrawEllipse(double x, double y, double width, double height) { Add(Op::DrawEllipse, 0, x, y, width, height); }
+    /**
+     * Draw a line with the pen
+     * @param x1 X of the start
+     * @param y1 Y of the start
+     * @param x2 X of the end
+     * @param y2 Y of the end
+     */
+    void StrokeLine(double x1, double y1, double x2, double y2) { Add(Op::StrokeLine, 0, x1, y1, x2, y2); }
+
+    void DrawBitmap(const wxBitmap &bitmap, double x, double y, double width, double height);
+    void DrawText(const wxString &text, double x, double y);
+    void DrawTextBox(const wxString &text, double centerX, double centerY, double padding);
+    void DrawPath(const Path &path);
+    void StrokePath(const Path &path);
+
+    /**
+     * The recorded commands
+     * @return commands, in order
+     */
+    const std::vector<Command> &GetCommands() const { return mCommands; }
+
+    /**
+     * Pen of a SetPen command
+     * @param index Index from the command
+     * @return pen
+     */
+    const wxPen &GetPen(unsigned int index) const { return mPens[index]; }
+
+    /**
+     * Brush of a SetBrush command
+     * @param index Index from the command
+     * @return brush
+     */
+    const wxBrush &GetBrush(unsigned int index) const { return mBrushes[index]; }
+
+    /**
+     * Font of a SetFont command
+     * @param index Index from the command
+     * @return font
+     */
+    const Font &GetFont(unsigned int index) const { return mFonts[index]; }
+
+    /**
+     * Bitmap of a DrawBitmap command
+     * @param index Index from the command
+     * @return bitmap
+     */
+    const wxBitmap &GetBitmap(unsigned int index) const { return mBitmaps[index]; }
+
+    /**
+     * Text of a DrawText or DrawTextBox command
+     * @param index Index from the command
+     * @return text
+     */
+    const wxString &GetText(unsigned int index) const { return mTexts[index]; }
+
+    /**
+     * Segments of a path command, from mIndex for mCount segments
+     * @param index Index from the command
+     * @return first segment
+     */
+    const Segment *GetSegments(unsigned int index) const { return mSegments.data() + index; }
+
+private:
+    /**
+     * Append a command
+     * @param op Operation
+     * @param index Index into the side table
+     * @param a First argument
+     * @param b Second argument
+     * @param c Third argument
+     * @param d Fourth argument
+     */
+    void Add(Op op, unsigned int index = 0, double a = 0, double b = 0, double c = 0, double d = 0)
+    {
+        mCommands.push_back({op, 0, index, a, b, c, d});
+    }
+
+    void AddPath(Op op, const Path &path);
+
+    /// The commands, in order
+    std::vector<Command> mCommands;
+    /// Pens set
+    std::vector<wxPen> mPens;
+    /// Brushes set
+    std::vector<wxBrush> mBrushes;
+    /// Fonts set
+    std::vector<Font> mFonts;
+    /// Bitmaps drawn
+    std::vector<wxBitmap> mBitmaps;
+    /// Text drawn
+    std::vector<wxString> mTexts;
+    /// Segments of every path drawn
+    std::vector<Segment> mSegments;
+};
+
+#endif // DRAWCOMMANDS_HPP
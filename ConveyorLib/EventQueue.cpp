@@ -0,0 +1,40 @@
+/**
+ * @file EventQueue.cpp
+ * @author Alex Mueller
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "EventQueue.hpp"
+
+/**
+ * Add an event. Events that never happen are ignored.
+ * @param time Seconds from now, infinity if it never happens
+ * @param type What happens
+ * @param product The product, or nullptr for timers
+ */
+void EventQueue::Push(double time, Type type, Product *product)
+{
+    if (std::isfinite(time))
+    {
+        mEvents.push({std::max(time, 0.0), type, product});
+    }
+}
+
+/**
+ * Time it takes something moving at a constant speed to cover a distance
+ * @param distance Distance still to go in pixels, negative if already past
+ * @param speed Speed in pixels per second
+ * @return seconds, or infinity if it never gets there
+ */
+double EventQueue::TimeToCover(double distance, double speed)
+{
+    if (distance < 0 || speed <= 0)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    return distance / speed;
+}
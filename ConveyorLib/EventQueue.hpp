@@ -0,0 +1,90 @@
+/**
+ * @file EventQueue.hpp
+ * @author Alex Mueller
+ *
+ * The moments where something happens in the game, soonest first
+ */
+
+#ifndef EVENTQUEUE_HPP
+#define EVENTQUEUE_HPP
+
+#include <queue>
+#include <vector>
+
+class Product;
+
+/**
+ * Priority queue of the upcoming events in the game.
+ *
+ * Between events products only move at constant speed, so an update
+ * that ends just past the next event does everything a run of small
+ * updates would. Times are in seconds from now.
+ */
+class EventQueue {
+public:
+    /// What happens at an event
+    enum class Type
+    {
+        BeamEnter,   ///< A product starts breaking the beam
+        BeamExit,    ///< A product stops breaking the beam
+        Score,       ///< A product crosses the scoring line
+        LastProduct, ///< The last product passes the beam
+        Timer        ///< A level notice or the level end timer runs out
+    };
+
+    /// One event
+    struct Event
+    {
+        /// Seconds from now
+        double mTime;
+        /// What happens
+        Type mType;
+        /// The product, or nullptr for timers
+        Product *mProduct;
+
+        /**
+         * Order events so the soonest comes out of the queue first
+         * @param other Event to compare to
+         * @return true if this event is later
+         */
+        bool operator>(const Event &other) const { return mTime > other.mTime; }
+    };
+
+    void Push(double time, Type type, Product *product = nullptr);
+
+    /**
+     * Is the queue empty?
+     * @return true if there are no events
+     */
+    bool IsEmpty() const { return mEvents.empty(); }
+
+    /**
+     * Number of events in the queue
+     * @return events
+     */
+    int GetCount() const { return (int)mEvents.size(); }
+
+    /**
+     * The soonest event, the queue must not be empty
+     * @return event
+     */
+    const Event &Top() const { return mEvents.top(); }
+
+    /**
+     * Remove the soonest event
+     */
+    void Pop() { mEvents.pop(); }
+
+    /**
+     * Remove every event
+     */
+    void Clear() { mEvents = {}; }
+
+    static double TimeToCover(double distance, double speed);
+
+private:
+    /// The events, soonest on top
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> mEvents;
+};
+
+#endif // EVENTQUEUE_HPP
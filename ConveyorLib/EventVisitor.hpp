@@ -0,0 +1,132 @@
+/**
+ * @file EventVisitor.hpp
+ * @author Alex Mueller
+ *
+ * Visitor that schedules the next event of each product
+ */
+
+#ifndef EVENTVISITOR_HPP
+#define EVENTVISITOR_HPP
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include "Beam.hpp"
+#include "Conveyor.hpp"
+#include "EventQueue.hpp"
+#include "ItemVisitor.hpp"
+#include "LastProductVisitor.hpp"
+#include "Product.h"
+#include "ProductQueue.hpp"
+#include "Sparty.hpp"
+
+/**
+ * Visitor that works out when each product next does something.
+ *
+ * Uses the same tests as LastProductVisitor: a product breaks the beam
+ * while it is up to 50 pixels before it, scores once it is 10 pixels
+ * past it or kicked off the conveyor, and has passed once it is past
+ * the beam or kicked off.
+ */
+class EventVisitor : public ItemVisitor {
+public:
+    /**
+     * Add visiting conveyor
+     * @param conveyor
+     */
+    void VisitConveyor(Conveyor *conveyor) override
+    {
+        mIsActive = conveyor->IsRunning();
+        mConveyorCenter = conveyor->GetX() - 25;
+    }
+    /**
+     * Add visiting beam
+     * @param beam
+     */
+    void VisitBeam(Beam *beam) override
+    {
+        mBeamY = beam->GetY();
+    }
+    /**
+     * Add visiting sparty
+     * @param sparty
+     */
+    void VisitSparty(Sparty *sparty) override
+    {
+        mKickSpeed = sparty->GetKickSpeed();
+    }
+    /**
+     * Add visiting product, the events are worked out in Schedule
+     * from the products near the beam
+     * @param product
+     */
+    void VisitProduct(Product *product) override {}
+
+    /**
+     * Add the events of the products to a queue. Only the products in
+     * the window and the next one to reach the beam can have the soonest
+     * event, the rest follow them down the conveyor.
+     * @param queue Queue to add to
+     * @param products The products of the level
+     */
+    void Schedule(EventQueue &queue, ProductQueue &products)
+    {
+        // Nothing moves while the conveyor is stopped
+        if (!mIsActive)
+        {
+            return;
+        }
+
+        products.Advance(mBeamY);
+        std::vector<Product *> near(products.begin(), products.end());
+        if (products.GetNext() != nullptr)
+        {
+            near.push_back(products.GetNext());
+        }
+
+        for (auto product : near)
+        {
+            double speed = product->GetSpeed();
+            double y = product->GetY();
+            bool kicked = product->WasKick();
+
+            // Kicked products leave the conveyor sideways
+            double offConveyor = kicked ? EventQueue::TimeToCover(product->GetX() - mConveyorCenter, mKickSpeed)
+                                        : std::numeric_limits<double>::infinity();
+
+            if (!kicked)
+            {
+                queue.Push(EventQueue::TimeToCover(mBeamY - ProductQueue::BeamWindow - y, speed), EventQueue::Type::BeamEnter,
+                           product);
+                queue.Push(EventQueue::TimeToCover(mBeamY - y, speed), EventQueue::Type::BeamExit, product);
+            }
+
+            if (!product->GetScoreAccountedFor())
+            {
+                queue.Push(std::min(EventQueue::TimeToCover(mBeamY + LastProductVisitor::ScoreLine - y, speed), offConveyor),
+                           EventQueue::Type::Score, product);
+            }
+
+            if (product->IsLast() && y <= mBeamY && product->GetX() >= mConveyorCenter)
+            {
+                queue.Push(std::min(EventQueue::TimeToCover(mBeamY - y, speed), offConveyor),
+                           EventQueue::Type::LastProduct, product);
+            }
+        }
+    }
+
+private:
+    /// Whether the conveyor is running
+    bool mIsActive = false;
+
+    /// The Y position of the beam
+    double mBeamY = 0;
+
+    /// The center X of the conveyor
+    double mConveyorCenter = 0;
+
+    /// The speed of the kick
+    int mKickSpeed = 0;
+};
+
+#endif // EVENTVISITOR_HPP
@@ -0,0 +1,184 @@
+/**
+ * @file FrameStats.cpp
+ * @author Alex Mueller
+ */
+
+#include "pch.h"
+#include "FrameStats.hpp"
+#include "DrawCommands.hpp"
+
+/// Location of the HUD panel in window pixels
+const wxPoint HudPosition(10, 10);
+
+/// Size of the HUD panel in window pixels
+const wxSize HudSize(260, 170);
+
+/// Height of one line of HUD text in pixels
+const int HudLineHeight = 18;
+
+/// Height of the histogram graph in pixels
+const int HudGraphHeight = 40;
+
+/// Frame budget in milliseconds, the frame timer period
+const double FrameBudget = 30.0;
+
+/// Background of the HUD panel
+const wxColour HudBackground(0, 0, 0, 180);
+
+/// Color of the HUD text and histogram bars
+const wxColour HudTextColor(230, 255, 230);
+
+/// Color of histogram bars over the frame budget
+const wxColour HudOverBudgetColor(187, 0, 0);
+
+/**
+ * Constructor
+ */
+FrameStats::FrameStats()
+{
+    Reset();
+}
+
+/**
+ * Clear all collected frames
+ */
+void FrameStats::Reset()
+{
+    mFrames.fill(0);
+    mBuckets.fill(0);
+    mNext = 0;
+    mCount = 0;
+}
+
+/**
+ * Histogram bucket a frame time falls into
+ * @param frameMs Frame time in milliseconds
+ * @return bucket index
+ */
+int FrameStats::BucketFor(double frameMs) const
+{
+    int bucket = static_cast<int>(frameMs / BucketWidth);
+    if (bucket < 0)
+    {
+        return 0;
+    }
+    return bucket < BucketCount ? bucket : BucketCount - 1;
+}
+
+/**
+ * Record the timings of one frame. The oldest frame leaves
+ * the window and the histogram when it is full.
+ * @param updateMs Time spent in SpartyBoots::Update
+ * @param drawMs Time spent in SpartyBoots::OnDraw
+ */
+void FrameStats::AddFrame(double updateMs, double drawMs)
+{
+    mUpdateMs = updateMs;
+    mDrawMs = drawMs;
+
+    if (mCount == WindowSize)
+    {
+        mBuckets[BucketFor(mFrames[mNext])]--;
+    }
+    else
+    {
+        mCount++;
+    }
+
+    double frameMs = updateMs + drawMs;
+    mFrames[mNext] = frameMs;
+    mBuckets[BucketFor(frameMs)]++;
+    mNext = (mNext + 1) % WindowSize;
+}
+
+/**
+ * Frame time below which the given fraction of the window falls.
+ * Resolution is one histogram bucket.
+ * @param fraction Fraction in [0, 1], e.g. 0.95 for p95
+ * @return frame time in milliseconds
+ */
+double FrameStats::Percentile(double fraction) const
+{
+    if (mCount == 0)
+    {
+        return 0;
+    }
+
+    int target = static_cast<int>(fraction * mCount + 0.5);
+    if (target < 1)
+    {
+        target = 1;
+    }
+
+    int seen = 0;
+    for (int b = 0; b < BucketCount; b++)
+    {
+        seen += mBuckets[b];
+        if (seen >= target)
+        {
+            return (b + 1) * BucketWidth;
+        }
+    }
+
+    return BucketCount * BucketWidth;
+}
+
+/**
+ * Draw the HUD in window pixels
+ * @param graphics Graphics context to draw on
+ */
+void FrameStats::Draw(DrawCommands &graphics)
+{
+    double x = HudPosition.x;
+    double y = HudPosition.y;
+
+    graphics.SetPen(*wxTRANSPARENT_PEN);
+    graphics.SetBrush(wxBrush(HudBackground));
+    graphics.DrawRectangle(x, y, HudSize.GetWidth(), HudSize.GetHeight());
+
+    wxFont font(10, wxFONTFAMILY_TELETYPE, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL);
+    graphics.SetFont(font, HudTextColor);
+
+    double textX = x + 8;
+    double textY = y + 6;
+    graphics.DrawText(wxString::Format(L"update %6.2f ms  draw %6.2f ms", mUpdateMs, mDrawMs), textX, textY);
+    textY += HudLineHeight;
+    graphics.DrawText(wxString::Format(L"logic  %6.2f ms  items %d", mLogicMs, mItemCount), textX, textY);
+    textY += HudLineHeight;
+    graphics.DrawText(wxString::Format(L"p50 %5.2f  p95 %5.2f  p99 %5.2f", Percentile(0.50), Percentile(0.95), Percentile(0.99)),
+                       textX, textY);
+    textY += HudLineHeight;
+    graphics.DrawText(wxString::Format(L"frames %d  budget %.0f ms", mCount, FrameBudget), textX, textY);
+
+    //
+    // Histogram of the frame times, one bar per bucket
+    // up to twice the frame budget
+    //
+    int maxBucket = 0;
+    for (auto count : mBuckets)
+    {
+        maxBucket = std::max(maxBucket, count);
+    }
+    if (maxBucket == 0)
+    {
+        return;
+    }
+
+    double graphX = textX;
+    double graphBottom = y + HudSize.GetHeight() - 8;
+    double graphWidth = HudSize.GetWidth() - 16;
+    int shownBuckets = std::min(BucketCount, static_cast<int>(2 * FrameBudget / BucketWidth));
+    double barWidth = graphWidth / shownBuckets;
+
+    for (int b = 0; b < shownBuckets; b++)
+    {
+        if (mBuckets[b] == 0)
+        {
+            continue;
+        }
+
+        double barHeight = HudGraphHeight * double(mBuckets[b]) / maxBucket;
+        graphics.SetBrush(wxBrush(b * BucketWidth >= FrameBudget ? HudOverBudgetColor : HudTextColor));
+        graphics.DrawRectangle(graphX + b * barWidth, graphBottom - barHeight, barWidth, barHeight);
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * @file FrameStats.hpp
+ * @author Alex Mueller
+ *
+ * Rolling per-frame timing statistics for the performance HUD
+ */
+
+#ifndef FRAMESTATS_HPP
+#define FRAMESTATS_HPP
+
+#include <array>
+#include <chrono>
+#include <memory>
+
+class DrawCommands;
+
+/**
+ * Keeps a rolling window of frame timings and a histogram of
+ * frame times so we can report p50/p95/p99 without sorting.
+ */
+class FrameStats {
+public:
+    /// Number of frames kept in the rolling window
+    static const int WindowSize = 240;
+
+    /// Width of one histogram bucket in milliseconds
+    static constexpr double BucketWidth = 0.25;
+
+    /// Number of histogram buckets, the last one collects everything slower
+    static constexpr int BucketCount = 200;
+
+    /// Clock used to time the frame phases
+    using Clock = std::chrono::steady_clock;
+
+    FrameStats();
+
+    void AddFrame(double updateMs, double drawMs);
+    /**
+     * Set the time spent evaluating the logic gates this frame
+     * @param logicMs Time in milliseconds
+     */
+    void SetLogicTime(double logicMs) { mLogicMs = logicMs; }
+    /**
+     * Set the number of items on the board this frame
+     * @param count Number of items
+     */
+    void SetItemCount(int count) { mItemCount = count; }
+
+    /**
+     * Milliseconds elapsed since a time point
+     * @param start Time the phase started
+     * @return elapsed time in milliseconds
+     */
+    static double MillisecondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    double Percentile(double fraction) const;
+    void Reset();
+    void Draw(DrawCommands &graphics);
+
+    /**
+     * Number of frames currently in the window
+     * @return frame count
+     */
+    int GetFrameCount() const { return mCount; }
+
+private:
+    int BucketFor(double frameMs) const;
+
+    /// Update phase time of the most recent frame in milliseconds
+    double mUpdateMs = 0;
+    /// Draw phase time of the most recent frame in milliseconds
+    double mDrawMs = 0;
+    /// Logic evaluation time of the most recent frame in milliseconds
+    double mLogicMs = 0;
+    /// Number of items in the most recent frame
+    int mItemCount = 0;
+
+    /// Frame times in the rolling window, oldest overwritten first
+    std::array<double, WindowSize> mFrames;
+    /// Index where the next frame time is written
+    int mNext = 0;
+    /// Number of valid entries in mFrames
+    int mCount = 0;
+    /// Histogram of the frame times in the window
+    std::array<int, BucketCount> mBuckets;
+};
+
+#endif // FRAMESTATS_HPP
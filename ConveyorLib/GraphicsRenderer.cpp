@@ -0,0 +1,153 @@
+/**
+ * @file GraphicsRenderer.cpp
+ * @author Alex Mueller
+ */
+
+#include "pch.h"
+#include <wx/graphics.h>
+#include "GraphicsRenderer.hpp"
+
+/**
+ * Build the graphics path of a path command
+ * @param commands Buffer holding the command
+ * @param command DrawPath or StrokePath command
+ * @return path
+ */
+wxGraphicsPath GraphicsRenderer::MakePath(const DrawCommands &commands, const DrawCommands::Command &command)
+{
+    using SegmentType = DrawCommands::SegmentType;
+
+    wxGraphicsPath path = mGraphics->CreatePath();
+    auto segments = commands.GetSegments(command.mIndex);
+    for (unsigned int i = 0; i < command.mCount; i++)
+    {
+        auto &segment = segments[i];
+        switch (segment.mType)
+        {
+        case SegmentType::MoveTo:
+            path.MoveToPoint(segment.mX[0], segment.mY[0]);
+            break;
+
+        case SegmentType::LineTo:
+            path.AddLineToPoint(segment.mX[0], segment.mY[0]);
+            break;
+
+        case SegmentType::CurveTo:
+            path.AddCurveToPoint(segment.mX[0], segment.mY[0], segment.mX[1], segment.mY[1], segment.mX[2],
+                                 segment.mY[2]);
+            break;
+
+        case SegmentType::Rectangle:
+            path.AddRectangle(segment.mX[0], segment.mY[0], segment.mX[1], segment.mY[1]);
+            break;
+
+        case SegmentType::Close:
+            path.CloseSubpath();
+            break;
+        }
+    }
+
+    return path;
+}
+
+/**
+ * Draw the recorded commands on the graphics context
+ * @param commands Recorded commands
+ */
+void GraphicsRenderer::Render(const DrawCommands &commands)
+{
+    using Op = DrawCommands::Op;
+
+    for (auto &command : commands.GetCommands())
+    {
+        switch (command.mOp)
+        {
+        case Op::PushState:
+            mGraphics->PushState();
+            break;
+
+        case Op::PopState:
+            mGraphics->PopState();
+            break;
+
+        case Op::Translate:
+            mGraphics->Translate(command.mA, command.mB);
+            break;
+
+        case Op::Scale:
+            mGraphics->Scale(command.mA, command.mB);
+            break;
+
+        case Op::Rotate:
+            mGraphics->Rotate(command.mA);
+            break;
+
+        case Op::Clip:
+            mGraphics->Clip(command.mA, command.mB, command.mC, command.mD);
+            break;
+
+        case Op::SetPen:
+            mGraphics->SetPen(commands.GetPen(command.mIndex));
+            break;
+
+        case Op::SetBrush:
+            mGraphics->SetBrush(commands.GetBrush(command.mIndex));
+            break;
+
+        case Op::SetFont:
+        {
+            auto &font = commands.GetFont(command.mIndex);
+            if (font.mFont.IsOk())
+            {
+                mGraphics->SetFont(font.mFont, font.mColour);
+            }
+            else
+            {
+                mGraphics->SetFont(mGraphics->CreateFont(font.mPixelSize, font.mFaceName, font.mFlags, font.mColour));
+            }
+            break;
+        }
+
+        case Op::DrawRectangle:
+            mGraphics->DrawRectangle(command.mA, command.mB, command.mC, command.mD);
+            break;
+
+        case Op::DrawEllipse:
+            mGraphics->DrawEllipse(command.mA, command.mB, command.mC, command.mD);
+            break;
+
+        case Op::DrawBitmap:
+            mGraphics->DrawBitmap(commands.GetBitmap(command.mIndex), command.mA, command.mB, command.mC, command.mD);
+            break;
+
+        case Op::StrokeLine:
+            mGraphics->StrokeLine(command.mA, command.mB, command.mC, command.mD);
+            break;
+
+        case Op::DrawText:
+            mGraphics->DrawText(commands.GetText(command.mIndex), command.mA, command.mB);
+            break;
+
+        case Op::DrawTextBox:
+        {
+            auto &text = commands.GetText(command.mIndex);
+            double width, height;
+            mGraphics->GetTextExtent(text, &width, &height);
+
+            double x = command.mA - width / 2;
+            double y = command.mB - height / 2;
+            mGraphics->DrawRectangle(x - command.mC, y, width + 2 * command.mC, height);
+            mGraphics->DrawText(text, x, y);
+            break;
+        }
+
+        case Op::DrawPath:
+            mGraphics->DrawPath(MakePath(commands, command));
+            break;
+
+        case Op::StrokePath:
+            mGraphics->StrokePath(MakePath(commands, command));
+            break;
+        }
+    }
+}
@@ -0,0 +1,34 @@
+/**
+ * @file GraphicsRenderer.hpp
+ * @author Alex Mueller
+ *
+ * Draws recorded frames on a wxGraphicsContext
+ */
+
+#ifndef GRAPHICSRENDERER_HPP
+#define GRAPHICSRENDERER_HPP
+
+#include "DrawCommands.hpp"
+#include "Renderer.hpp"
+
+/**
+ * Renderer that replays the commands on a wxGraphicsContext
+ */
+class GraphicsRenderer : public Renderer {
+public:
+    /**
+     * Constructor
+     * @param graphics Graphics context to draw on, it must outlive the renderer
+     */
+    explicit GraphicsRenderer(wxGraphicsContext *graphics) : mGraphics(graphics) {}
+
+    void Render(const DrawCommands &commands) override;
+
+private:
+    wxGraphicsPath MakePath(const DrawCommands &commands, const DrawCommands::Command &command);
+
+    /// Graphics context to draw on
+    wxGraphicsContext *mGraphics;
+};
+
+#endif // GRAPHICSRENDERER_HPP
@@ -5,7 +5,12 @@
 
 #include "pch.h"
 #include "InputPin.h"
+#include "Snapshot.hpp"
 #include "OutputPin.h"
+#include "WireBatch.hpp"
+
+/// Diameter to draw the pin in pixels
+const int PinSize = 10;
 
 /**
  * Constructor
@@ -30,7 +35,7 @@ void InputPin::SetLine(PinConnector *line)
  * Draw AndGate with virtual pixel
  * @param graphics
  */
-void InputPin::Draw(std::shared_ptr<wxGraphicsContext> graphics) {}
+void InputPin::Draw(DrawCommands &graphics) {}
 
 /**
  * Draw the pins of AndGate by calling from LogicItem
@@ -42,14 +47,14 @@ void InputPin::Draw(std::shared_ptr<wxGraphicsContext> graphics) {}
  * @param end_y where pin end (and
  * where the pin is)
  */
-void InputPin::DrawPins(std::shared_ptr<wxGraphicsContext> graphics, int start_x, int start_y, int end_x, int end_y)
+void InputPin::DrawPins(DrawCommands &graphics, int start_x, int start_y, int end_x, int end_y)
 {
     // Create a path to draw the AND gate shape
-    auto path = graphics->CreatePath();
+    auto path = graphics.CreatePath();
 
     int pinRadius = PinSize / 2;
 
-    graphics->SetPen(*wxBLACK_PEN);
+    graphics.SetPen(*wxBLACK_PEN);
 
     //This part is in case the pin is connected to a line. When that happens, we update the pins' value and connected
     // if (mLine != nullptr)
@@ -69,16 +74,16 @@ void InputPin::DrawPins(std::shared_ptr<wxGraphicsContext> graphics, int start_x
     {
         if (getValue())
         {
-            graphics->SetBrush(ConnectionColorOne); // Gray color for the pin circles
+            graphics.SetBrush(WireBatch::ConnectionColorOne); // Gray color for the pin circles
         }
         else
         {
-            graphics->SetBrush(ConnectionColorZero); // Gray color for the pin circles
+            graphics.SetBrush(WireBatch::ConnectionColorZero); // Gray color for the pin circles
         }
     }
     else
     {
-        graphics->SetBrush(ConnectionColorUnknown); // Gray color for the pin circles
+        graphics.SetBrush(WireBatch::ConnectionColorUnknown); // Gray color for the pin circles
     }
 
     // Left pins (inputs) should be vertically aligned
@@ -90,10 +95,10 @@ void InputPin::DrawPins(std::shared_ptr<wxGraphicsContext> graphics, int start_x
     path.AddLineToPoint(endPin); // Draw the left vertical line
 
     // Draw the path
-    graphics->DrawPath(path);
+    graphics.DrawPath(path);
 
     // Draw the pins as circles
-    graphics->DrawEllipse(endPin.m_x - pinRadius, endPin.m_y - pinRadius, PinSize, PinSize); // First input pin
+    graphics.DrawEllipse(endPin.m_x - pinRadius, endPin.m_y - pinRadius, PinSize, PinSize); // First input pin
 }
 
 /**
@@ -163,3 +168,25 @@ bool InputPin::Catch(PinConnector *pinConnector, wxPoint lineEnd)
 
     return false;
 }
+
+/**
+ * Save the state that changes as the game runs
+ * @param writer Snapshot to write to
+ */
+void InputPin::SaveState(SnapshotWriter &writer)
+{
+    Item::SaveState(writer);
+    writer.Write(mConnected);
+    writer.Write(mValue);
+}
+
+/**
+ * Restore the state saved by SaveState
+ * @param reader Snapshot to read from
+ */
+void InputPin::LoadState(SnapshotReader &reader)
+{
+    Item::LoadState(reader);
+    reader.Read(mConnected);
+    reader.Read(mValue);
+}
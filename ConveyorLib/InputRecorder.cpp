@@ -0,0 +1,133 @@
+/**
+ * @file InputRecorder.cpp
+ * @author Alex Mueller
+ */
+
+#include "pch.h"
+#include "InputRecorder.hpp"
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include "SpartyBoots.hpp"
+
+using namespace std;
+
+/// Names of the event types in a saved log, in Type order
+const char *TypeNames[] = {"tick", "view", "grab", "drag", "release", "gate", "level", "rewind"};
+
+/**
+ * Save the log as text
+ * @param filename File to write
+ * @return true if successful
+ */
+bool InputRecorder::Save(const wxString &filename) const
+{
+    ofstream out(filename.ToStdString());
+    if (!out)
+    {
+        return false;
+    }
+
+    // Enough digits that the elapsed times read back exactly
+    out << setprecision(17);
+    for (auto &event : mEvents)
+    {
+        out << event.mTick << ' ' << TypeNames[(int)event.mType] << ' ' << event.mA << ' ' << event.mB;
+        if (!event.mText.IsEmpty())
+        {
+            out << ' ' << event.mText.ToUTF8().data();
+        }
+        out << '\n';
+    }
+
+    return bool(out);
+}
+
+/**
+ * Load a log saved with Save
+ * @param filename File to read
+ * @return false if the file could not be read
+ */
+bool InputRecorder::Load(const wxString &filename)
+{
+    ifstream in(filename.ToStdString());
+    if (!in)
+    {
+        return false;
+    }
+
+    mEvents.clear();
+    string line;
+    while (getline(in, line))
+    {
+        istringstream fields(line);
+        Event event;
+        string type, text;
+        if (!(fields >> event.mTick >> type >> event.mA >> event.mB))
+        {
+            continue;
+        }
+        fields >> text;
+        event.mText = wxString::FromUTF8(text.data(), text.length());
+
+        auto name = find_if(begin(TypeNames), end(TypeNames), [&type](const char *n) { return type == n; });
+        if (name == end(TypeNames))
+        {
+            return false;
+        }
+        event.mType = static_cast<Type>(name - begin(TypeNames));
+        mEvents.push_back(event);
+    }
+
+    return true;
+}
+
+/**
+ * Feed the log into a game without drawing it
+ * @param spartyBoots Game to replay into, normally newly created
+ * @return number of ticks replayed
+ */
+long InputRecorder::Replay(SpartyBoots &spartyBoots) const
+{
+    long ticks = 0;
+    for (auto &event : mEvents)
+    {
+        switch (event.mType)
+        {
+        case Type::Tick:
+            spartyBoots.Update(event.mA);
+            ticks++;
+            break;
+
+        case Type::View:
+            spartyBoots.SetViewSize((int)event.mA, (int)event.mB);
+            break;
+
+        case Type::Grab:
+            spartyBoots.Grab((int)event.mA, (int)event.mB);
+            break;
+
+        case Type::Drag:
+            spartyBoots.Drag((int)event.mA, (int)event.mB);
+            break;
+
+        case Type::Release:
+            spartyBoots.Release();
+            break;
+
+        case Type::Gate:
+            spartyBoots.AddGate(event.mText);
+            break;
+
+        case Type::Level:
+            spartyBoots.OnLevelSelect((int)event.mA);
+            break;
+
+        case Type::Rewind:
+            spartyBoots.Rewind((long)event.mA);
+            break;
+        }
+    }
+
+    return ticks;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file InputRecorder.hpp
+ * @author Alex Mueller
+ *
+ * Records the input into a SpartyBoots so it can be replayed exactly
+ */
+
+#ifndef INPUTRECORDER_HPP
+#define INPUTRECORDER_HPP
+
+#include <vector>
+
+class SpartyBoots;
+
+/**
+ * Log of every input into a SpartyBoots, stamped with the tick
+ * (number of Update calls) it arrived on.
+ *
+ * The frame times are inputs too, so replaying the log into a new
+ * SpartyBoots reproduces the recorded game exactly, as fast as the
+ * machine can run it. The log is saved as text, one event per line:
+ *
+ *     tick type a b text
+ */
+class InputRecorder {
+public:
+    /// Kinds of input
+    enum class Type
+    {
+        Tick,    ///< Update, a is the elapsed time
+        View,    ///< Window size, a and b are the width and height
+        Grab,    ///< Mouse down, a and b are the window position
+        Drag,    ///< Mouse drag, a and b are the window position
+        Release, ///< Mouse released
+        Gate,    ///< Gate added from the menu, text is the gate type
+        Level,   ///< Level selected, a is the level number
+        Rewind   ///< Rewind, a is the number of updates to go back
+    };
+
+    /**
+     * One recorded input
+     */
+    struct Event
+    {
+        /// Tick the input arrived on
+        long mTick = 0;
+        /// Kind of input
+        Type mType = Type::Tick;
+        /// First value
+        double mA = 0;
+        /// Second value
+        double mB = 0;
+        /// Text value
+        wxString mText;
+    };
+
+    /**
+     * Add an event to the log
+     * @param event Event to add
+     */
+    void Add(const Event &event) { mEvents.push_back(event); }
+
+    /**
+     * Get the recorded events
+     * @return events in the order they arrived
+     */
+    const std::vector<Event> &GetEvents() const { return mEvents; }
+
+    /// Clear the log
+    void Clear() { mEvents.clear(); }
+
+    bool Save(const wxString &filename) const;
+    bool Load(const wxString &filename);
+    long Replay(SpartyBoots &spartyBoots) const;
+
+private:
+    /// Recorded events
+    std::vector<Event> mEvents;
+};
+
+#endif // INPUTRECORDER_HPP
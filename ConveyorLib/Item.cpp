@@ -5,6 +5,7 @@
 #include "pch.h"
 #include "Item.hpp"
 #include "SpartyBoots.hpp"
+#include "Snapshot.hpp"
 /**
  * Destructor
  */
@@ -22,4 +23,24 @@ Item::Item(SpartyBoots *SpartyBoots): mSpartyBoots(SpartyBoots) {}
 void Item::MoveToFront()
 {
     mSpartyBoots->MoveToFront(this);
-}
\ No newline at end of file
+}
+
+/**
+ * Save the state that changes as the game runs
+ * @param writer Snapshot to write to
+ */
+void Item::SaveState(SnapshotWriter &writer)
+{
+    writer.Write(mX);
+    writer.Write(mY);
+}
+
+/**
+ * Restore the state saved by SaveState
+ * @param reader Snapshot to read from
+ */
+void Item::LoadState(SnapshotReader &reader)
+{
+    reader.Read(mX);
+    reader.Read(mY);
+}
@@ -9,10 +9,13 @@
 #define ITEM_H
 
 #include <memory>
+#include "DrawCommands.hpp"
 #include "ItemVisitor.hpp"
 #include "IDraggable.h"
 
 class PinConnector;
+class SnapshotWriter;
+class SnapshotReader;
 class SpartyBoots; // Forward declaration
 
 /**
@@ -24,6 +27,7 @@ private:
     SpartyBoots *mSpartyBoots; ///< Pointer to SpartyBoots
     double mX = 0; ///< X location for the center of the item
     double mY = 0; ///< Y location for the center of the item
+    int mOrderNode = -1; ///< Node of the item in the drawing order, see ItemStore
 
 public:
 
@@ -68,7 +72,7 @@ public:
    * draw function
    * @param dc
     */
-    virtual void Draw(std::shared_ptr<wxGraphicsContext> dc) = 0;
+    virtual void Draw(DrawCommands &dc) = 0;
     /**
     * Check if mouse click hit
     * @param x, y
@@ -117,6 +121,21 @@ public:
 
     virtual void MoveToFront() override;
 
+    /**
+     * Get the node of the item in the drawing order
+     * @return node, -1 if the item isn't in an ItemStore
+     */
+    int GetOrderNode() const { return mOrderNode; }
+
+    /**
+     * Set the node of the item in the drawing order
+     * @param node Node in the ItemStore
+     */
+    void SetOrderNode(int node) { mOrderNode = node; }
+
+    virtual void SaveState(SnapshotWriter &writer);
+    virtual void LoadState(SnapshotReader &reader);
+
 protected:
 
     Item(SpartyBoots *SpartyBoots);
@@ -0,0 +1,275 @@
+/**
+ * @file ItemStore.cpp
+ * @author Alex Mueller
+ */
+
+#include "pch.h"
+#include "ItemStore.hpp"
+#include "Beam.hpp"
+#include "Conveyor.hpp"
+#include "InputPin.h"
+#include "LogicGate.h"
+#include "OutputPin.h"
+#include "Product.h"
+#include "ScoreBoard.hpp"
+#include "Sensor.h"
+#include "Sparty.hpp"
+
+/**
+ * Remove every item
+ */
+void ItemStore::Clear()
+{
+    mOrder.clear();
+    mBack = -1;
+    mFront = -1;
+    mProducts.clear();
+    mGates.clear();
+    mConveyor = nullptr;
+    mBeam = nullptr;
+    mSensor = nullptr;
+    mSparty = nullptr;
+    mScoreBoard = nullptr;
+}
+
+/**
+ * Add a product in front of the other items
+ * @param product Product to add
+ */
+void ItemStore::Add(const std::shared_ptr<Product> &product)
+{
+    mProducts.push_back(product);
+    AddToOrder(product);
+}
+
+/**
+ * Add a gate in front of the other items
+ * @param gate Gate to add
+ */
+void ItemStore::Add(const std::shared_ptr<LogicGate> &gate)
+{
+    mGates.push_back(gate);
+    AddToOrder(gate);
+}
+
+/**
+ * Add the conveyor in front of the other items
+ * @param conveyor Conveyor to add
+ */
+void ItemStore::Add(const std::shared_ptr<Conveyor> &conveyor)
+{
+    mConveyor = conveyor;
+    AddToOrder(conveyor);
+}
+
+/**
+ * Add the beam in front of the other items
+ * @param beam Beam to add
+ */
+void ItemStore::Add(const std::shared_ptr<Beam> &beam)
+{
+    mBeam = beam;
+    AddToOrder(beam);
+}
+
+/**
+ * Add the sensor in front of the other items
+ * @param sensor Sensor to add
+ */
+void ItemStore::Add(const std::shared_ptr<Sensor> &sensor)
+{
+    mSensor = sensor;
+    AddToOrder(sensor);
+}
+
+/**
+ * Add Sparty in front of the other items
+ * @param sparty Sparty to add
+ */
+void ItemStore::Add(const std::shared_ptr<Sparty> &sparty)
+{
+    mSparty = sparty;
+    AddToOrder(sparty);
+}
+
+/**
+ * Add the scoreboard. It goes behind every other item.
+ * @param scoreboard Scoreboard to add
+ */
+void ItemStore::Add(const std::shared_ptr<ScoreBoard> &scoreboard)
+{
+    mScoreBoard = scoreboard;
+    AddToOrder(scoreboard, true);
+}
+
+/**
+ * Move an item in front of every other item
+ * @param item Item to move
+ */
+void ItemStore::MoveToFront(Item *item)
+{
+    int node = item->GetOrderNode();
+    if (node < 0 || node >= (int)mOrder.size() || mOrder[node].mItem.get() != item || node == mFront)
+    {
+        return;
+    }
+
+    Unlink(node);
+    LinkAtFront(node);
+}
+
+/**
+ * Give an item a node in the drawing order
+ * @param item Item to add
+ * @param atBack True to put it behind every other item, false in front
+ */
+void ItemStore::AddToOrder(const std::shared_ptr<Item> &item, bool atBack)
+{
+    int node = (int)mOrder.size();
+    mOrder.push_back({item, -1, -1});
+    item->SetOrderNode(node);
+
+    if (!atBack)
+    {
+        LinkAtFront(node);
+        return;
+    }
+
+    mOrder[node].mInFront = mBack;
+    if (mBack >= 0)
+    {
+        mOrder[mBack].mBehind = node;
+    }
+    else
+    {
+        mFront = node;
+    }
+    mBack = node;
+}
+
+/**
+ * Take a node out of the drawing order
+ * @param node Node to unlink
+ */
+void ItemStore::Unlink(int node)
+{
+    auto &unlinked = mOrder[node];
+    if (unlinked.mBehind >= 0)
+    {
+        mOrder[unlinked.mBehind].mInFront = unlinked.mInFront;
+    }
+    else
+    {
+        mBack = unlinked.mInFront;
+    }
+
+    if (unlinked.mInFront >= 0)
+    {
+        mOrder[unlinked.mInFront].mBehind = unlinked.mBehind;
+    }
+    else
+    {
+        mFront = unlinked.mBehind;
+    }
+
+    unlinked.mBehind = -1;
+    unlinked.mInFront = -1;
+}
+
+/**
+ * Put an unlinked node in front of every other one
+ * @param node Node to link
+ */
+void ItemStore::LinkAtFront(int node)
+{
+    mOrder[node].mBehind = mFront;
+    if (mFront >= 0)
+    {
+        mOrder[mFront].mInFront = node;
+    }
+    else
+    {
+        mBack = node;
+    }
+    mFront = node;
+}
+
+/**
+ * Hand the level items, the ones there is only one of, to a visitor.
+ * The products and gates are left to the caller, so it only goes
+ * through them if it needs them.
+ * @param visitor Visitor to visit with
+ */
+void ItemStore::VisitLevelItems(ItemVisitor &visitor) const
+{
+    if (mScoreBoard != nullptr)
+    {
+        visitor.VisitScoreboard(mScoreBoard.get());
+    }
+    if (mSensor != nullptr)
+    {
+        visitor.VisitSensor(mSensor.get());
+    }
+    if (mConveyor != nullptr)
+    {
+        visitor.VisitConveyor(mConveyor.get());
+    }
+    if (mBeam != nullptr)
+    {
+        visitor.VisitBeam(mBeam.get());
+    }
+    if (mSparty != nullptr)
+    {
+        visitor.VisitSparty(mSparty.get());
+    }
+}
+
+/**
+ * Call a function on every item, kind by kind. Unlike the drawing
+ * order, this order doesn't change as items are brought to the front.
+ * @param function Function to call
+ */
+void ItemStore::ForEach(const std::function<void(Item *)> &function) const
+{
+    Item *levelItems[] = {mScoreBoard.get(), mSensor.get(), mConveyor.get(), mBeam.get(), mSparty.get()};
+    for (auto item : levelItems)
+    {
+        if (item != nullptr)
+        {
+            function(item);
+        }
+    }
+
+    for (auto &product : mProducts)
+    {
+        function(product.get());
+    }
+    for (auto &gate : mGates)
+    {
+        function(gate.get());
+    }
+
+    // The pins aren't in the store, they are children of their items
+    auto pins = [&function](const PinOwner *owner) {
+        if (owner == nullptr)
+        {
+            return;
+        }
+
+        for (auto &pin : owner->GetInputPins())
+        {
+            function(pin.get());
+        }
+        for (auto &pin : owner->GetOutputPins())
+        {
+            function(pin.get());
+        }
+    };
+    pins(mSensor.get());
+    pins(mBeam.get());
+    pins(mSparty.get());
+    for (auto &gate : mGates)
+    {
+        pins(gate.get());
+    }
+}
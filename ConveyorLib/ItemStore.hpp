@@ -0,0 +1,239 @@
+/**
+ * @file ItemStore.hpp
+ * @author Alex Mueller
+ *
+ * The items of a level, kept by kind
+ */
+
+#ifndef ITEMSTORE_HPP
+#define ITEMSTORE_HPP
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+class Beam;
+class Conveyor;
+class Item;
+class ItemVisitor;
+class LogicGate;
+class Product;
+class ScoreBoard;
+class Sensor;
+class Sparty;
+
+/**
+ * Owns the items of a level.
+ *
+ * Each kind of item is kept in its own list, so each part of the game
+ * goes straight to the items it works on. The level items there is one
+ * of, the conveyor, beam, sensor, Sparty and scoreboard, are kept on
+ * their own.
+ *
+ * The drawing order, used for drawing and for finding what was clicked,
+ * is a doubly linked list through an array of nodes, one per item. Each
+ * item knows its node, so bringing it to the front unlinks it and links
+ * it in at the front without searching or moving any other item.
+ */
+class ItemStore {
+private:
+    /// An item's place in the drawing order
+    struct OrderNode
+    {
+        /// The item
+        std::shared_ptr<Item> mItem;
+        /// Node of the item behind it, -1 if it is at the back
+        int mBehind;
+        /// Node of the item in front of it, -1 if it is at the front
+        int mInFront;
+    };
+
+public:
+    /**
+     * Walks the drawing order in one direction
+     */
+    class OrderIterator {
+    public:
+        /**
+         * Constructor
+         * @param nodes The order nodes
+         * @param node Node to start at, -1 for the end
+         * @param forward True to walk back to front, false front to back
+         */
+        OrderIterator(const std::vector<OrderNode> &nodes, int node, bool forward)
+            : mNodes(&nodes), mNode(node), mForward(forward)
+        {
+        }
+
+        /**
+         * The item at the iterator
+         * @return item
+         */
+        const std::shared_ptr<Item> &operator*() const { return (*mNodes)[mNode].mItem; }
+
+        /**
+         * Move to the next item
+         * @return this iterator
+         */
+        OrderIterator &operator++()
+        {
+            auto &node = (*mNodes)[mNode];
+            mNode = mForward ? node.mInFront : node.mBehind;
+            return *this;
+        }
+
+        /**
+         * Compare iterators
+         * @param other Iterator to compare with
+         * @return true if they are at different items
+         */
+        bool operator!=(const OrderIterator &other) const { return mNode != other.mNode; }
+
+    private:
+        /// The order nodes
+        const std::vector<OrderNode> *mNodes;
+        /// Current node
+        int mNode;
+        /// Direction
+        bool mForward;
+    };
+
+    /**
+     * The drawing order walked one way, for range-based for loops
+     */
+    class OrderRange {
+    public:
+        /**
+         * Constructor
+         * @param nodes The order nodes
+         * @param first Node to start at
+         * @param forward True for back to front, false for front to back
+         */
+        OrderRange(const std::vector<OrderNode> &nodes, int first, bool forward)
+            : mNodes(nodes), mFirst(first), mForward(forward)
+        {
+        }
+
+        /**
+         * First item
+         * @return iterator
+         */
+        OrderIterator begin() const { return OrderIterator(mNodes, mFirst, mForward); }
+
+        /**
+         * Past the last item
+         * @return iterator
+         */
+        OrderIterator end() const { return OrderIterator(mNodes, -1, mForward); }
+
+    private:
+        /// The order nodes
+        const std::vector<OrderNode> &mNodes;
+        /// Node to start at
+        int mFirst;
+        /// Direction
+        bool mForward;
+    };
+
+    void Clear();
+
+    void Add(const std::shared_ptr<Product> &product);
+    void Add(const std::shared_ptr<LogicGate> &gate);
+    void Add(const std::shared_ptr<Conveyor> &conveyor);
+    void Add(const std::shared_ptr<Beam> &beam);
+    void Add(const std::shared_ptr<Sensor> &sensor);
+    void Add(const std::shared_ptr<Sparty> &sparty);
+    void Add(const std::shared_ptr<ScoreBoard> &scoreboard);
+
+    void MoveToFront(Item *item);
+    void VisitLevelItems(ItemVisitor &visitor) const;
+    void ForEach(const std::function<void(Item *)> &function) const;
+
+    /**
+     * Every item in drawing order, back to front
+     * @return range of items
+     */
+    OrderRange BackToFront() const { return OrderRange(mOrder, mBack, true); }
+
+    /**
+     * Every item in the order to test for clicks, front to back
+     * @return range of items
+     */
+    OrderRange FrontToBack() const { return OrderRange(mOrder, mFront, false); }
+
+    /**
+     * Number of items
+     * @return items
+     */
+    size_t GetCount() const { return mOrder.size(); }
+
+    /**
+     * The products, in the order they were added
+     * @return products
+     */
+    const std::vector<std::shared_ptr<Product>> &GetProducts() const { return mProducts; }
+
+    /**
+     * The gates, in the order they were added
+     * @return gates
+     */
+    const std::vector<std::shared_ptr<LogicGate>> &GetGates() const { return mGates; }
+
+    /**
+     * Get the conveyor
+     * @return conveyor or nullptr if the level has none
+     */
+    Conveyor *GetConveyor() const { return mConveyor.get(); }
+
+    /**
+     * Get the beam
+     * @return beam or nullptr if the level has none
+     */
+    Beam *GetBeam() const { return mBeam.get(); }
+
+    /**
+     * Get the sensor
+     * @return sensor or nullptr if the level has none
+     */
+    Sensor *GetSensor() const { return mSensor.get(); }
+
+    /**
+     * Get Sparty
+     * @return Sparty or nullptr if the level has none
+     */
+    Sparty *GetSparty() const { return mSparty.get(); }
+
+    /**
+     * Get the scoreboard
+     * @return scoreboard or nullptr if the level has none
+     */
+    ScoreBoard *GetScoreBoard() const { return mScoreBoard.get(); }
+
+private:
+    void AddToOrder(const std::shared_ptr<Item> &item, bool atBack = false);
+    void Unlink(int node);
+    void LinkAtFront(int node);
+
+    /// The drawing order nodes, in the order the items were added
+    std::vector<OrderNode> mOrder;
+    /// Node of the item at the back, -1 if there are no items
+    int mBack = -1;
+    /// Node of the item at the front, -1 if there are no items
+    int mFront = -1;
+    /// The products
+    std::vector<std::shared_ptr<Product>> mProducts;
+    /// The gates
+    std::vector<std::shared_ptr<LogicGate>> mGates;
+    /// The conveyor
+    std::shared_ptr<Conveyor> mConveyor;
+    /// The beam
+    std::shared_ptr<Beam> mBeam;
+    /// The sensor
+    std::shared_ptr<Sensor> mSensor;
+    /// Sparty
+    std::shared_ptr<Sparty> mSparty;
+    /// The scoreboard
+    std::shared_ptr<ScoreBoard> mScoreBoard;
+};
+
+#endif // ITEMSTORE_HPP
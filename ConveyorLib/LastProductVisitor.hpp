@@ -12,6 +12,7 @@
 #include "Conveyor.hpp"
 #include "ItemVisitor.hpp"
 #include "Product.h"
+#include "ProductQueue.hpp"
 #include "ScoreBoard.hpp"
 #include "Sensor.h"
 #include "Sparty.hpp"
@@ -21,11 +22,14 @@
  */
 class LastProductVisitor : public ItemVisitor {
 public:
+    /// Distance past the beam a product is scored
+    static constexpr double ScoreLine = 10;
+
     /**
      * Constructor for the Last Porduct Visitor
-     * @param currentTime
+     * @param elapsed The amount of time elapsed this tick
      */
-    explicit LastProductVisitor(double currentTime): mCurrentTime(currentTime) {}
+    explicit LastProductVisitor(double elapsed): mElapsed(elapsed) {}
     /**
      * getter for IsInBeam
      * @return mIsInBeam
@@ -46,16 +50,26 @@ public:
      * @return mProductInBeam
      */
     Product* GetProductInBeam() {return mProductInBeam; }
+    /**
+     * getter for every product that broke the beam this tick, in the
+     * order they reached it: the products a long tick carried all the
+     * way over the beam, then the product in the beam
+     * @param products Filled with the products, kept by the caller so
+     * its storage is reused from tick to tick
+     */
+    void GetProductsInBeam(std::vector<Product*> &products) const
+    {
+        products.assign(mProductsOverBeam.begin(), mProductsOverBeam.end());
+        if (mProductInBeam != nullptr)
+        {
+            products.push_back(mProductInBeam);
+        }
+    }
     /**
      * getter for sparty
      * @return mSparty
      */
     Sparty* GetSparty() { return mSparty; }
-    /**
-     * getter for gates
-     * @return mGates
-     */
-    std::vector<LogicGate*> GetGates() { return mGates; }
 
     /**
      * Add for scoreboard
@@ -91,6 +105,7 @@ public:
     void VisitConveyor(Conveyor *conveyor) override
     {
         mConveyorCenter = conveyor->GetX() - 25;
+        mIsActive = conveyor->IsRunning();
     }
     /**
      * Add for sparty
@@ -100,11 +115,6 @@ public:
     {
         mSparty = sparty;
     }
-
-    void VisitLogicGate(LogicGate *logicGate) override
-    {
-        mGates.push_back(logicGate);
-    }
     /**
      * Getter to check the result after visiting all products
      * @return
@@ -114,13 +124,42 @@ public:
         return mLastProductPassed;
     }
     /**
-     * Add for product
+     * Add for product. Products are checked in VisitProducts instead,
+     * only the ones near the beam need it.
+     * @param product
+     */
+    void VisitProduct(Product *product) override {}
+
+    /**
+     * Check the products near the beam, once everything else has been visited
+     * @param products The products of the level
+     */
+    void VisitProducts(ProductQueue &products)
+    {
+        products.Advance(mBeamY);
+        if (products.HasLastPassed())
+        {
+            mLastProductPassed = true;
+        }
+
+        for (auto product : products)
+        {
+            CheckProduct(product);
+        }
+    }
+
+private:
+    /**
+     * Check a product against the beam and the scoring line
      * @param product
      */
-    void VisitProduct(Product *product) override
+    void CheckProduct(Product *product)
     {
-        // Only check if this is marked as the last product
-        if (product->GetY() > (mBeamY + 10) || product->GetX() < mConveyorCenter)
+        bool overBeam = !(product->WasKick()) && MovedOverBeam(product);
+
+        // A product that went over the beam this tick is scored once
+        // it has had its chance to be kicked
+        if (!overBeam && (product->GetY() > (mBeamY + ScoreLine) || product->GetX() < mConveyorCenter))
         {
             if (!(product->GetScoreAccountedFor()))
             {
@@ -143,6 +182,11 @@ public:
                 mLastProductPassed = true;
             }
         }
+        if (overBeam)
+        {
+            mIsInBeam = true;
+            mProductsOverBeam.push_back(product);
+        }
         if (!(product->WasKick()) && (mBeamY - product->GetY() >= 0) && (mBeamY - product->GetY() <= 50))
         {
             // if (mSensor != nullptr)
@@ -169,9 +213,25 @@ public:
 
     }
 
-private:
-    /// The current time
-    double mCurrentTime = 0;
+    /**
+     * Did the product move over the whole 50 pixels before the beam
+     * since the last tick? A long tick can carry it from before the
+     * beam to past it without it ever being seen in the beam.
+     * @param product Product to check, already moved for this tick
+     * @return true if it went over the beam
+     */
+    bool MovedOverBeam(Product *product)
+    {
+        double y = product->GetY();
+        double previousY = mIsActive ? y - mElapsed * product->GetSpeed() : y;
+        return previousY < mBeamY - 50 && y > mBeamY;
+    }
+
+    /// The amount of time elapsed this tick
+    double mElapsed = 0;
+
+    /// Whether the conveyor moved the products this tick
+    bool mIsActive = false;
 
     /// The Y position of the beam
     double mBeamY = 0;
@@ -194,8 +254,8 @@ private:
     Sparty *mSparty = nullptr;
     ///The product in the beam
     Product* mProductInBeam = nullptr;
-    ///The gates in the game
-    std::vector<LogicGate*> mGates;
+    ///Products carried over the beam this tick
+    std::vector<Product*> mProductsOverBeam;
 };
 
 #endif // LASTPRODUCTVISITOR_HPP
@@ -0,0 +1,237 @@
+/**
+ * @file LevelGenerator.cpp
+ * @author Alex Mueller
+ */
+
+#include "pch.h"
+#include "LevelGenerator.hpp"
+#include "LoadLevel.h"
+#include <algorithm>
+
+using namespace std;
+
+/// Product shapes
+const vector<wxString> Shapes = {L"square", L"circle", L"diamond"};
+
+/// Product colors
+const vector<wxString> Colors = {L"red", L"green", L"blue", L"white"};
+
+/// Product contents, umich is left out since Sparty can't pick it up
+const vector<wxString> Contents = {L"izzo", L"smith", L"basketball", L"football"};
+
+/// Gate types used in generated circuits
+const vector<wxString> GateTypes = {L"and", L"or", L"not"};
+
+/// Signal number of the beam output
+const int BeamSignal = -1;
+
+/// Left column of the generated gates
+const int GateLeft = 450;
+
+/// Top row of the generated gates
+const int GateTop = 80;
+
+/// Horizontal distance between gates
+const int GateColumnWidth = 110;
+
+/// Vertical distance between gates
+const int GateRowHeight = 90;
+
+/// Number of gates in one column before starting the next
+const int GatesPerColumn = 8;
+
+/**
+ * Constructor
+ * @param options Settings for the generated level
+ */
+LevelGenerator::LevelGenerator(const Options &options) : mOptions(options), mRandom(options.mSeed)
+{
+    vector<wxString> properties;
+    properties.insert(properties.end(), Colors.begin(), Colors.end());
+    properties.insert(properties.end(), Shapes.begin(), Shapes.end());
+    properties.insert(properties.end(), Contents.begin(), Contents.end());
+    shuffle(properties.begin(), properties.end(), mRandom);
+
+    int count = max(1, min(mOptions.mSensorChildren, (int)properties.size()));
+    mSensorChildren.assign(properties.begin(), properties.begin() + count);
+}
+
+/**
+ * Generate the level records into a level document
+ * @param level Level to add the records to
+ */
+void LevelGenerator::Generate(LoadLevel &level)
+{
+    GenerateCircuit();
+
+    level.AddRecord({L"level", L"1150,800"});
+
+    vector<wxString> sensor = {L"sensor", L"155", L"430"};
+    sensor.insert(sensor.end(), mSensorChildren.begin(), mSensorChildren.end());
+    level.AddRecord(sensor);
+
+    level.AddRecord({L"conveyor", L"205", L"400", wxString::Format(L"%d", mOptions.mSpeed), L"800", L"60,-390"});
+
+    uniform_real_distribution<double> chance(0, 1);
+    for (int i = 0; i < mOptions.mProducts; i++)
+    {
+        auto placement = i == 0 ? wxString(L"100") : wxString::Format(L"+%d", mOptions.mSpacing);
+        auto shape = Pick(Shapes);
+        auto color = Pick(Colors);
+        wxString content = chance(mRandom) < mOptions.mContentFraction ? Pick(Contents) : wxString();
+
+        bool kick;
+        if (mGates.empty())
+        {
+            kick = chance(mRandom) < mOptions.mKickFraction;
+        }
+        else
+        {
+            kick = Evaluate({shape, color, content});
+        }
+
+        level.AddRecord({L"product", placement, shape, color, content, kick ? L"yes" : L"no"});
+    }
+
+    level.AddRecord({L"beam", L"297", L"437", L"-185"});
+    level.AddRecord({L"sparty", L"345", L"340", L"300", L"1100, 400", L"0.25", L"1000"});
+
+    auto instructions = wxString::Format(L"Generated level: %d products\n%d gates, seed %u", mOptions.mProducts,
+                                         (int)mGates.size(), mOptions.mSeed);
+    level.AddRecord({L"scoreboard", L"700", L"40", L"10", L"-5", instructions});
+
+    for (size_t g = 0; g < mGates.size(); g++)
+    {
+        auto location = GateLocation((int)g);
+        level.AddRecord({L"gate", mGates[g].mType, wxString::Format(L"%d", location.x),
+                         wxString::Format(L"%d", location.y)});
+    }
+
+    for (size_t g = 0; g < mGates.size(); g++)
+    {
+        auto &inputs = mGates[g].mInputs;
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            level.AddRecord({L"wire", SignalName(inputs[i]), wxString::Format(L"gate.%d.%d", (int)g, (int)i)});
+        }
+    }
+
+    if (!mGates.empty())
+    {
+        level.AddRecord({L"wire", SignalName((int)(mSensorChildren.size() + mGates.size() - 1)), L"sparty"});
+    }
+}
+
+/**
+ * Where to put a pre-wired gate so the gates don't overlap.
+ * Gates are laid out in columns between the conveyor and Sparty's pin.
+ * @param gate Gate number
+ * @return Location in virtual pixels
+ */
+wxPoint LevelGenerator::GateLocation(int gate)
+{
+    int column = gate / GatesPerColumn;
+    int row = gate % GatesPerColumn;
+    return wxPoint(GateLeft + column * GateColumnWidth, GateTop + row * GateRowHeight);
+}
+
+/**
+ * Pick one of a list of choices at random
+ * @param choices Choices to pick from
+ * @return The choice
+ */
+wxString LevelGenerator::Pick(const std::vector<wxString> &choices)
+{
+    uniform_int_distribution<size_t> index(0, choices.size() - 1);
+    return choices[index(mRandom)];
+}
+
+/**
+ * Generate a random circuit from the sensor outputs to Sparty.
+ *
+ * Each gate takes its inputs from the sensor or from earlier gates,
+ * so the circuit has no loops. The last gate ands the circuit with
+ * the beam so Sparty only kicks products in front of him.
+ */
+void LevelGenerator::GenerateCircuit()
+{
+    mGates.clear();
+    if (mOptions.mGates <= 0)
+    {
+        return;
+    }
+
+    int sensorCount = (int)mSensorChildren.size();
+    for (int g = 0; g < mOptions.mGates - 1; g++)
+    {
+        Gate gate;
+        gate.mType = Pick(GateTypes);
+        int inputCount = gate.mType == L"not" ? 1 : 2;
+
+        // Prefer the most recent signals so the gates build on each other
+        uniform_int_distribution<int> signal(max(0, sensorCount + g - 4), sensorCount + g - 1);
+        for (int i = 0; i < inputCount; i++)
+        {
+            gate.mInputs.push_back(signal(mRandom));
+        }
+        mGates.push_back(gate);
+    }
+
+    // A single gate circuit is just the beam and one sensor output
+    int last = mGates.empty() ? 0 : sensorCount + (int)mGates.size() - 1;
+    mGates.push_back({L"and", {BeamSignal, last}});
+}
+
+/**
+ * Evaluate the circuit for a product in front of the beam
+ * @param properties Product shape, color and content
+ * @return true if Sparty kicks the product
+ */
+bool LevelGenerator::Evaluate(const std::vector<wxString> &properties) const
+{
+    vector<bool> signals;
+    for (auto &child : mSensorChildren)
+    {
+        signals.push_back(find(properties.begin(), properties.end(), child) != properties.end());
+    }
+
+    auto value = [&signals](int signal) { return signal == BeamSignal ? true : bool(signals[signal]); };
+
+    for (auto &gate : mGates)
+    {
+        bool a = value(gate.mInputs[0]);
+        if (gate.mType == L"not")
+        {
+            signals.push_back(!a);
+        }
+        else if (gate.mType == L"and")
+        {
+            signals.push_back(a && value(gate.mInputs[1]));
+        }
+        else
+        {
+            signals.push_back(a || value(gate.mInputs[1]));
+        }
+    }
+
+    return signals.back();
+}
+
+/**
+ * Name of a signal as used by wires in a level file
+ * @param signal Signal number
+ * @return Pin name
+ */
+wxString LevelGenerator::SignalName(int signal) const
+{
+    int sensorCount = (int)mSensorChildren.size();
+    if (signal == BeamSignal)
+    {
+        return L"beam";
+    }
+    if (signal < sensorCount)
+    {
+        return wxString::Format(L"sensor.%d", signal);
+    }
+    return wxString::Format(L"gate.%d.0", signal - sensorCount);
+}
@@ -0,0 +1,79 @@
+/**
+ * @file LevelGenerator.hpp
+ * @author Alex Mueller
+ *
+ * Generates synthetic levels for stress testing and benchmarking
+ */
+
+#ifndef LEVELGENERATOR_HPP
+#define LEVELGENERATOR_HPP
+
+#include <random>
+#include <vector>
+
+class LoadLevel;
+
+/**
+ * Builds a random but valid level: a sensor panel, a conveyor full
+ * of products and an optional pre-wired circuit of and/or/not gates.
+ *
+ * The product kick flags are set by evaluating the generated circuit,
+ * so a generated level with gates is always solved by its own wiring.
+ */
+class LevelGenerator {
+public:
+    /**
+     * Settings for a generated level
+     */
+    struct Options
+    {
+        /// Number of products on the conveyor
+        int mProducts = 1000;
+        /// Number of properties on the sensor panel, up to the number of known properties
+        int mSensorChildren = 6;
+        /// Conveyor speed in pixels per second
+        int mSpeed = 100;
+        /// Distance between products in pixels
+        int mSpacing = 150;
+        /// Number of pre-wired gates, zero for an unwired level
+        int mGates = 8;
+        /// Fraction of products that carry content
+        double mContentFraction = 0.5;
+        /// Fraction of products kicked when there are no gates
+        double mKickFraction = 0.5;
+        /// Random seed, the same seed generates the same level
+        unsigned mSeed = 1;
+    };
+
+    explicit LevelGenerator(const Options &options);
+
+    void Generate(LoadLevel &level);
+
+    static wxPoint GateLocation(int gate);
+
+private:
+    /// A gate in the generated circuit
+    struct Gate
+    {
+        /// Gate type as used in the level file
+        wxString mType;
+        /// Signals wired to the inputs
+        std::vector<int> mInputs;
+    };
+
+    wxString Pick(const std::vector<wxString> &choices);
+    void GenerateCircuit();
+    bool Evaluate(const std::vector<wxString> &properties) const;
+    wxString SignalName(int signal) const;
+
+    /// Settings for this level
+    Options mOptions;
+    /// Random number generator
+    std::mt19937 mRandom;
+    /// Properties shown on the sensor panel
+    std::vector<wxString> mSensorChildren;
+    /// Generated gates, signals are the sensor outputs then the gate outputs
+    std::vector<Gate> mGates;
+};
+
+#endif // LEVELGENERATOR_HPP
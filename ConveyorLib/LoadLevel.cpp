@@ -5,14 +5,25 @@
 
 #include "pch.h"
 #include "LoadLevel.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <wx/tokenzr.h>
 #include "Item.hpp"
+#include "Trace.hpp"
 
 using namespace std;
 
+const char LoadLevel::BinaryMagic[4] = {'S', 'P', 'L', 'V'};
+
+/// Largest string or record we accept from a binary file
+const uint32_t BinaryMaxCount = 1 << 24;
+
 /**
  * Load the level from a XML file.
  *
  * Opens the XML file and reads the nodes, creating items as appropriate.
+ * Files that start with the binary level magic are read as binary levels.
  *
  * @param filename
  *
@@ -20,6 +31,13 @@ using namespace std;
  */
 void LoadLevel::Load(const wxString &filename)
 {
+    TRACE_SCOPE("LoadLevel::Load");
+
+    if (LoadBinary(filename))
+    {
+        return;
+    }
+
     wxXmlDocument xmlDoc;
     if (!xmlDoc.Load(filename))
     {
@@ -31,8 +49,7 @@ void LoadLevel::Load(const wxString &filename)
     auto root = xmlDoc.GetRoot();
 
     auto size = root->GetAttribute(L"size");
-    this->mLevelList.push_back(vector<wxString> {L"level", size});
-    this->mLevelSize.push_back(size);
+    AddRecord(vector<wxString> {L"level", size});
 
     //
     // Traverse the children of the root
@@ -50,17 +67,14 @@ void LoadLevel::Load(const wxString &filename)
             {
                 auto x = gameItem->GetAttribute(L"x");
                 auto y = gameItem->GetAttribute(L"y");
-                this->mLevelList.push_back(vector<wxString> {L"sensor", x, y});
-                this->mLevelSensor.push_back(x);
-                this->mLevelSensor.push_back(y);
+                vector<wxString> record {L"sensor", x, y};
                 // Get child elements of sensor
                 auto sensorChild = gameItem->GetChildren();
                 for (; sensorChild != nullptr; sensorChild = sensorChild->GetNext())
                 {
-                    auto childName = sensorChild->GetName();
-                    this->mLevelSensorChildren.push_back(childName);
+                    record.push_back(sensorChild->GetName());
                 }
-                // XmlSensor(child);
+                AddRecord(record);
             }
             else if (name == L"conveyor")
             {
@@ -69,12 +83,7 @@ void LoadLevel::Load(const wxString &filename)
                 auto speed = gameItem->GetAttribute(L"speed");
                 auto height = gameItem->GetAttribute(L"height");
                 auto panel = gameItem->GetAttribute(L"panel");
-                this->mLevelList.push_back(vector<wxString> {L"conveyor", x, y, speed, height, panel});
-                this->mLevelConveyer.push_back(x);
-                this->mLevelConveyer.push_back(y);
-                this->mLevelConveyer.push_back(speed);
-                this->mLevelConveyer.push_back(height);
-                this->mLevelConveyer.push_back(panel);
+                AddRecord(vector<wxString> {L"conveyor", x, y, speed, height, panel});
 
                 auto conveyorChild = gameItem->GetChildren();
                 for (; conveyorChild != nullptr; conveyorChild = conveyorChild->GetNext())
@@ -87,23 +96,16 @@ void LoadLevel::Load(const wxString &filename)
                         auto color = conveyorChild->GetAttribute(L"color");
                         auto content = conveyorChild->GetAttribute(L"content");
                         auto kick = conveyorChild->GetAttribute(L"kick");
-                        this->mLevelList.push_back(vector<wxString> {L"product", placement, shape, color, content, kick});
-                        this->mLevelProducts.push_back(vector<wxString> {placement, shape, color, content, kick});
-                        // XmlProduct(child);
+                        AddRecord(vector<wxString> {L"product", placement, shape, color, content, kick});
                     }
                 }
-                // XmlConveyor(child);
             }
             else if (name == L"beam")
             {
                 auto x = gameItem->GetAttribute(L"x");
                 auto y = gameItem->GetAttribute(L"y");
                 auto sender = gameItem->GetAttribute(L"sender");
-                this->mLevelList.push_back(vector<wxString> {L"beam", x, y, sender});
-                this->mLevelBeam.push_back(x);
-                this->mLevelBeam.push_back(y);
-                this->mLevelBeam.push_back(sender);
-                // XmlBeam(child);
+                AddRecord(vector<wxString> {L"beam", x, y, sender});
             }
             else if (name == L"sparty")
             {
@@ -113,14 +115,7 @@ void LoadLevel::Load(const wxString &filename)
                 auto pin = gameItem->GetAttribute(L"pin");
                 auto kickduration = gameItem->GetAttribute(L"kick-duration");
                 auto kickspeed = gameItem->GetAttribute(L"kick-speed");
-                this->mLevelList.push_back(vector<wxString> {L"sparty", x, y, height, pin, kickduration, kickspeed});
-                this->mLevelSparty.push_back(x);
-                this->mLevelSparty.push_back(y);
-                this->mLevelSparty.push_back(height);
-                this->mLevelSparty.push_back(pin);
-                this->mLevelSparty.push_back(kickduration);
-                this->mLevelSparty.push_back(kickspeed);
-                // XmlSparty(child);
+                AddRecord(vector<wxString> {L"sparty", x, y, height, pin, kickduration, kickspeed});
             }
             else if (name == L"scoreboard")
             {
@@ -128,12 +123,6 @@ void LoadLevel::Load(const wxString &filename)
                 auto y = gameItem->GetAttribute(L"y");
                 auto good = gameItem->GetAttribute(L"good", L"10");
                 auto bad = gameItem->GetAttribute(L"bad", L"0");
-                this->mLevelList.push_back(vector<wxString> {L"scoreboard", x, y, good, bad});
-                this->mLevelScoreboard.push_back(x);
-                this->mLevelScoreboard.push_back(y);
-                this->mLevelScoreboard.push_back(good);
-                this->mLevelScoreboard.push_back(bad);
-                // XmlScoreboard(child);
                 //  Get the text content
                 wxString instructions;
                 auto textNode = gameItem->GetChildren();
@@ -149,8 +138,300 @@ void LoadLevel::Load(const wxString &filename)
                     }
                     textNode = textNode->GetNext();
                 }
-                this->mLevelScoreboard.push_back(instructions);
+                AddRecord(vector<wxString> {L"scoreboard", x, y, good, bad, instructions});
+            }
+            else if (name == L"gate")
+            {
+                auto type = gameItem->GetAttribute(L"type");
+                auto x = gameItem->GetAttribute(L"x");
+                auto y = gameItem->GetAttribute(L"y");
+                AddRecord(vector<wxString> {L"gate", type, x, y});
+            }
+            else if (name == L"wire")
+            {
+                auto from = gameItem->GetAttribute(L"from");
+                auto to = gameItem->GetAttribute(L"to");
+                AddRecord(vector<wxString> {L"wire", from, to});
             }
         }
     }
 }
+
+/**
+ * Add one level record and sort its fields into the level vectors
+ * @param record Element name followed by its attributes
+ */
+void LoadLevel::AddRecord(const std::vector<wxString> &record)
+{
+    if (record.empty())
+    {
+        return;
+    }
+
+    mLevelList.push_back(record);
+
+    auto &name = record[0];
+    auto fields = record.begin() + 1;
+    if (name == L"level")
+    {
+        mLevelSize.insert(mLevelSize.end(), fields, record.end());
+    }
+    else if (name == L"sensor" && record.size() >= 3)
+    {
+        mLevelSensor.insert(mLevelSensor.end(), fields, fields + 2);
+        mLevelSensorChildren.insert(mLevelSensorChildren.end(), fields + 2, record.end());
+    }
+    else if (name == L"conveyor")
+    {
+        mLevelConveyer.insert(mLevelConveyer.end(), fields, record.end());
+    }
+    else if (name == L"product")
+    {
+        mLevelProducts.push_back(vector<wxString>(fields, record.end()));
+    }
+    else if (name == L"beam")
+    {
+        mLevelBeam.insert(mLevelBeam.end(), fields, record.end());
+    }
+    else if (name == L"sparty")
+    {
+        mLevelSparty.insert(mLevelSparty.end(), fields, record.end());
+    }
+    else if (name == L"scoreboard")
+    {
+        mLevelScoreboard.insert(mLevelScoreboard.end(), fields, record.end());
+    }
+    else if (name == L"gate")
+    {
+        mLevelGates.push_back(vector<wxString>(fields, record.end()));
+    }
+    else if (name == L"wire")
+    {
+        mLevelWires.push_back(vector<wxString>(fields, record.end()));
+    }
+}
+
+/**
+ * Read a little endian 32 bit value
+ * @param in Stream to read from
+ * @param value Value read
+ * @return true if successful
+ */
+static bool ReadUInt32(istream &in, uint32_t &value)
+{
+    unsigned char bytes[4];
+    if (!in.read(reinterpret_cast<char *>(bytes), 4))
+    {
+        return false;
+    }
+    value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (uint32_t(bytes[3]) << 24);
+    return true;
+}
+
+/**
+ * Write a little endian 32 bit value
+ * @param out Stream to write to
+ * @param value Value to write
+ */
+static void WriteUInt32(ostream &out, uint32_t value)
+{
+    char bytes[4] = {char(value & 0xff), char((value >> 8) & 0xff), char((value >> 16) & 0xff), char((value >> 24) & 0xff)};
+    out.write(bytes, 4);
+}
+
+/**
+ * Load a binary level file
+ * @param filename File to load
+ * @return false if the file is not a binary level
+ */
+bool LoadLevel::LoadBinary(const wxString &filename)
+{
+    ifstream in(filename.ToStdString(), ios::binary);
+    char magic[4];
+    if (!in.read(magic, 4) || memcmp(magic, BinaryMagic, 4) != 0)
+    {
+        return false;
+    }
+
+    uint32_t version, recordCount;
+    if (!ReadUInt32(in, version) || version != BinaryVersion || !ReadUInt32(in, recordCount))
+    {
+        wxMessageBox(L"Unable to load Level");
+        return true;
+    }
+
+    string bytes;
+    for (uint32_t r = 0; r < recordCount; r++)
+    {
+        uint32_t fieldCount;
+        if (!ReadUInt32(in, fieldCount) || fieldCount > BinaryMaxCount)
+        {
+            wxMessageBox(L"Unable to load Level");
+            return true;
+        }
+
+        vector<wxString> record;
+        record.reserve(fieldCount);
+        for (uint32_t f = 0; f < fieldCount; f++)
+        {
+            uint32_t length;
+            if (!ReadUInt32(in, length) || length > BinaryMaxCount)
+            {
+                wxMessageBox(L"Unable to load Level");
+                return true;
+            }
+            bytes.resize(length);
+            if (length > 0 && !in.read(&bytes[0], length))
+            {
+                wxMessageBox(L"Unable to load Level");
+                return true;
+            }
+            record.push_back(wxString::FromUTF8(bytes.data(), length));
+        }
+        AddRecord(record);
+    }
+
+    return true;
+}
+
+/**
+ * Save the level records in the binary level format
+ * @param filename File to write
+ * @return true if successful
+ */
+bool LoadLevel::SaveBinary(const wxString &filename) const
+{
+    ofstream out(filename.ToStdString(), ios::binary);
+    if (!out)
+    {
+        return false;
+    }
+
+    out.write(BinaryMagic, 4);
+    WriteUInt32(out, BinaryVersion);
+    WriteUInt32(out, static_cast<uint32_t>(mLevelList.size()));
+    for (auto &record : mLevelList)
+    {
+        WriteUInt32(out, static_cast<uint32_t>(record.size()));
+        for (auto &field : record)
+        {
+            auto utf8 = field.ToUTF8();
+            WriteUInt32(out, static_cast<uint32_t>(utf8.length()));
+            out.write(utf8.data(), utf8.length());
+        }
+    }
+
+    return bool(out);
+}
+
+/**
+ * Add attributes to an XML node from a record
+ * @param node Node to add to
+ * @param record Level record
+ * @param names Attribute names for the record fields after the element name
+ */
+static void AddAttributes(wxXmlNode *node, const vector<wxString> &record, const vector<wxString> &names)
+{
+    for (size_t i = 0; i < names.size() && i + 1 < record.size(); i++)
+    {
+        // Empty attributes are left out, like an optional attribute in a level file
+        if (!record[i + 1].IsEmpty())
+        {
+            node->AddAttribute(names[i], record[i + 1]);
+        }
+    }
+}
+
+/**
+ * Save the level records as a level XML file
+ * @param filename File to write
+ * @return true if successful
+ */
+bool LoadLevel::SaveXml(const wxString &filename) const
+{
+    wxXmlDocument xmlDoc;
+    auto root = new wxXmlNode(wxXML_ELEMENT_NODE, L"level");
+    xmlDoc.SetRoot(root);
+    auto items = new wxXmlNode(wxXML_ELEMENT_NODE, L"items");
+
+    // Products are children of the conveyor that precedes them
+    wxXmlNode *conveyor = nullptr;
+    for (auto &record : mLevelList)
+    {
+        auto &name = record[0];
+        if (name == L"level")
+        {
+            AddAttributes(root, record, {L"size"});
+        }
+        else if (name == L"sensor")
+        {
+            auto node = new wxXmlNode(wxXML_ELEMENT_NODE, L"sensor");
+            AddAttributes(node, record, {L"x", L"y"});
+            for (size_t i = 3; i < record.size(); i++)
+            {
+                node->AddChild(new wxXmlNode(wxXML_ELEMENT_NODE, record[i]));
+            }
+            items->AddChild(node);
+        }
+        else if (name == L"conveyor")
+        {
+            conveyor = new wxXmlNode(wxXML_ELEMENT_NODE, L"conveyor");
+            AddAttributes(conveyor, record, {L"x", L"y", L"speed", L"height", L"panel"});
+            items->AddChild(conveyor);
+        }
+        else if (name == L"product" && conveyor != nullptr)
+        {
+            auto node = new wxXmlNode(wxXML_ELEMENT_NODE, L"product");
+            AddAttributes(node, record, {L"placement", L"shape", L"color", L"content", L"kick"});
+            conveyor->AddChild(node);
+        }
+        else if (name == L"beam")
+        {
+            auto node = new wxXmlNode(wxXML_ELEMENT_NODE, L"beam");
+            AddAttributes(node, record, {L"x", L"y", L"sender"});
+            items->AddChild(node);
+        }
+        else if (name == L"sparty")
+        {
+            auto node = new wxXmlNode(wxXML_ELEMENT_NODE, L"sparty");
+            AddAttributes(node, record, {L"x", L"y", L"height", L"pin", L"kick-duration", L"kick-speed"});
+            items->AddChild(node);
+        }
+        else if (name == L"scoreboard")
+        {
+            auto node = new wxXmlNode(wxXML_ELEMENT_NODE, L"scoreboard");
+            AddAttributes(node, record, {L"x", L"y", L"good", L"bad"});
+            if (record.size() > 5)
+            {
+                // Newlines in the instructions become <br/> tags
+                wxStringTokenizer lines(record[5], L"\n");
+                bool first = true;
+                while (lines.HasMoreTokens())
+                {
+                    if (!first)
+                    {
+                        node->AddChild(new wxXmlNode(wxXML_ELEMENT_NODE, L"br"));
+                    }
+                    node->AddChild(new wxXmlNode(wxXML_TEXT_NODE, L"", lines.GetNextToken()));
+                    first = false;
+                }
+            }
+            items->AddChild(node);
+        }
+        else if (name == L"gate")
+        {
+            auto node = new wxXmlNode(wxXML_ELEMENT_NODE, L"gate");
+            AddAttributes(node, record, {L"type", L"x", L"y"});
+            items->AddChild(node);
+        }
+        else if (name == L"wire")
+        {
+            auto node = new wxXmlNode(wxXML_ELEMENT_NODE, L"wire");
+            AddAttributes(node, record, {L"from", L"to"});
+            items->AddChild(node);
+        }
+    }
+    root->AddChild(items);
+
+    return xmlDoc.Save(filename);
+}
@@ -11,6 +11,16 @@
 
 /**
  * load level class with vectors to store information
+ *
+ * Levels are read from XML or from the binary level format, which
+ * is the list of level records written out as length prefixed
+ * UTF-8 strings:
+ *
+ *     "SPLV" uint32 version, uint32 record count,
+ *     then per record: uint32 field count, per field: uint32 length, bytes
+ *
+ * All integers are little endian. A record is the same list of
+ * strings kept in mLevelList, starting with the element name.
  */
 class LoadLevel {
 private:
@@ -30,11 +40,26 @@ private:
     std::vector<wxString> mLevelSparty;
     /// vector that stores level Scoreboard info
     std::vector<wxString> mLevelScoreboard;
+    /// vector that stores pre-placed gates, each is type, x, y
+    std::vector<std::vector<wxString>> mLevelGates;
+    /// vector that stores pre-wired connections, each is from, to
+    std::vector<std::vector<wxString>> mLevelWires;
     /// vector that stores level list info
     std::vector<std::vector<wxString>> mLevelList;
 
+    bool LoadBinary(const wxString &filename);
+
 public:
+    /// Magic bytes at the start of a binary level file
+    static const char BinaryMagic[4];
+
+    /// Version of the binary level format
+    static const unsigned BinaryVersion = 1;
+
     void Load(const wxString &filename);
+    void AddRecord(const std::vector<wxString> &record);
+    bool SaveXml(const wxString &filename) const;
+    bool SaveBinary(const wxString &filename) const;
 
     /**
      *getter for level size info
@@ -92,6 +117,27 @@ public:
     {
         return mLevelScoreboard;
     }
+    /**
+     *getter for pre-placed gates
+     */
+    std::vector<std::vector<wxString>> GetLevelGates()
+    {
+        return mLevelGates;
+    }
+    /**
+     *getter for pre-wired connections
+     */
+    std::vector<std::vector<wxString>> GetLevelWires()
+    {
+        return mLevelWires;
+    }
+    /**
+     *getter for all level records in file order
+     */
+    const std::vector<std::vector<wxString>> &GetLevelList() const
+    {
+        return mLevelList;
+    }
 };
 
 #endif // LOADLEVEL_H
@@ -8,19 +8,24 @@
 #ifndef LOGICGATE_H
 #define LOGICGATE_H
 
-#include "LogicItem.hpp"
+#include "PinOwner.hpp"
 #include "InputPin.h"
 #include "OutputPin.h"
 
 /**
  * Specifically gates that utilizes logic and pins. Derived from logicitem
  */
-class LogicGate : public LogicItem {
-protected:
-    /// vector containing input pins
-    std::vector<std::shared_ptr<InputPin>> mInputPins;
-    /// vector containing output pins
-    std::vector<std::shared_ptr<OutputPin>> mOutputPins;
+class LogicGate : public PinOwner {
+public:
+    /// Kinds of gates, used when the wired gates are compiled into a LogicNetwork
+    enum class Kind
+    {
+        And,
+        Or,
+        Not,
+        SR,
+        D
+    };
 
 public:
     /**
@@ -32,22 +37,17 @@ public:
         visitor.VisitLogicGate(this);
     }
     /**
-     * getter for input pins
-     * @return mInputPins
-     */
-    std::vector<std::shared_ptr<InputPin>> GetInputPins() { return mInputPins; }
-    /**
-     * getter for output pins
-     * @return mOutputPins
+     * Get the kind of gate
+     * @return gate kind
      */
-    std::vector<std::shared_ptr<OutputPin>> GetOutputPins() { return mOutputPins; }
+    virtual Kind GetKind() const = 0;
 protected:
     /**
- *Call the constructor from logic item, subsequently item
+ *Call the constructor from pin owner, subsequently item
  *@param spartyBoots the mspartyboots object
 */
 
-    LogicGate(SpartyBoots *spartyBoots): LogicItem(spartyBoots) {}
+    LogicGate(SpartyBoots *spartyBoots): PinOwner(spartyBoots) {}
 };
 
 #endif // LOGICGATE_H
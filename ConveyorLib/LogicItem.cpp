@@ -4,6 +4,7 @@
  */
 #include "pch.h"
 #include "LogicItem.hpp"
+#include "PinOwner.hpp"
 
 /**
  * Draw the pins of AndGate by calling from LogicItem
@@ -13,10 +14,40 @@
  * @param end_x
  * @param end_y
  */
-void LogicItem::DrawPins(std::shared_ptr<wxGraphicsContext> graphics, int start_x, int start_y, int end_x, int end_y)
+void LogicItem::DrawPins(DrawCommands &graphics, int start_x, int start_y, int end_x, int end_y)
 {}
 
 /**
  * computes pin connections
  */
 void LogicItem::GateCompute() {}
+
+/**
+ * Set the location. A pin that moves tells its parent the box
+ * around its pins has to be found again.
+ * @param x X location
+ * @param y Y location
+ */
+void LogicItem::SetLocation(double x, double y)
+{
+    if (mParent != nullptr && (x != GetX() || y != GetY()))
+    {
+        mParent->InvalidatePinBounds();
+    }
+    Item::SetLocation(x, y);
+}
+
+/**
+ * Bring the item to the front. A pin brings its parent.
+ */
+void LogicItem::MoveToFront()
+{
+    if (mParent != nullptr)
+    {
+        mParent->MoveToFront();
+    }
+    else
+    {
+        Item::MoveToFront();
+    }
+}
@@ -9,20 +9,40 @@
 #define PROJECT1_CONVEYORLIB_LOGICITEM_H
 
 #include "Item.hpp"
+
+class PinOwner;
+
 /**
  * Item that utilizes logic + pins
+ *
+ * The pins are logic items too, children of the PinOwner they belong
+ * to. A pin only knows its owner, the owner keeps the pin lists.
  */
 
 class LogicItem : public Item {
 private:
+    friend class PinOwner;
+
+    /// Item this is a pin of, nullptr if it isn't a pin
+    PinOwner *mParent = nullptr;
+
 public:
 
-    virtual void DrawPins(std::shared_ptr<wxGraphicsContext> graphics, int start_x, int start_y, int end_x, int end_y) = 0;
+    virtual void DrawPins(DrawCommands &graphics, int start_x, int start_y, int end_x, int end_y) = 0;
     /**
      *Compute the logic. Depending on the object/gate
      */
     virtual void GateCompute();
 
+    void SetLocation(double x, double y) override;
+    void MoveToFront() override;
+
+    /**
+     * Get the item this is a pin of
+     * @return parent or nullptr if this isn't a pin
+     */
+    PinOwner *GetParent() const { return mParent; }
+
 protected:
     /**
      *Call the constructor from item
@@ -0,0 +1,753 @@
+/**
+ * @file LogicNetwork.cpp
+ * @author Alex Mueller
+ */
+
+#include "pch.h"
+#include "LogicNetwork.hpp"
+#include "Beam.hpp"
+#include "PinConnector.h"
+#include "Sensor.h"
+#include "Sparty.hpp"
+#include <algorithm>
+#include <unordered_map>
+
+using namespace std;
+
+/// Slot that is always false
+const int FalseSlot = 0;
+
+/// Slot that is always true
+const int TrueSlot = 1;
+
+/**
+ * Split a graph into strongly connected components with Tarjan's
+ * algorithm. It is iterative so long chains of gates can't overflow
+ * the stack.
+ * @param successors Nodes each node leads to
+ * @param include Nodes to include, others are ignored
+ * @return Components, each node before the nodes it leads to
+ */
+static vector<vector<int>> FindComponents(const vector<vector<int>> &successors, const vector<uint8_t> &include)
+{
+    int count = (int)successors.size();
+    vector<int> index(count, -1);
+    vector<int> low(count, 0);
+    vector<uint8_t> onStack(count, 0);
+    vector<int> stack;
+    vector<pair<int, size_t>> calls;
+    vector<vector<int>> components;
+    int next = 0;
+
+    for (int root = 0; root < count; root++)
+    {
+        if (!include[root] || index[root] >= 0)
+        {
+            continue;
+        }
+
+        index[root] = low[root] = next++;
+        stack.push_back(root);
+        onStack[root] = 1;
+        calls.emplace_back(root, 0);
+        while (!calls.empty())
+        {
+            int node = calls.back().first;
+            size_t edge = calls.back().second++;
+            if (edge < successors[node].size())
+            {
+                int to = successors[node][edge];
+                if (index[to] < 0)
+                {
+                    index[to] = low[to] = next++;
+                    stack.push_back(to);
+                    onStack[to] = 1;
+                    calls.emplace_back(to, 0);
+                }
+                else if (onStack[to])
+                {
+                    low[node] = min(low[node], index[to]);
+                }
+                continue;
+            }
+
+            if (low[node] == index[node])
+            {
+                vector<int> component;
+                int member;
+                do
+                {
+                    member = stack.back();
+                    stack.pop_back();
+                    onStack[member] = 0;
+                    component.push_back(member);
+                } while (member != node);
+
+                // Gates in a loop are swept in the order they were added
+                sort(component.begin(), component.end());
+                components.push_back(move(component));
+            }
+
+            calls.pop_back();
+            if (!calls.empty())
+            {
+                int caller = calls.back().first;
+                low[caller] = min(low[caller], low[node]);
+            }
+        }
+    }
+
+    // Tarjan finds a component after everything it leads to
+    reverse(components.begin(), components.end());
+    return components;
+}
+
+/**
+ * Compile the wired gates into operations
+ * @param sensor The level sensor or nullptr
+ * @param beam The level beam
+ * @param sparty Sparty, whose input pin is the result
+ * @param gates Every gate in the level
+ */
+void LogicNetwork::Build(Sensor *sensor, Beam *beam, Sparty *sparty, const std::vector<LogicGate *> &gates)
+{
+    mValues = {0, 1};
+    mValid = {1, 1};
+    mStatic = {1, 1};
+    mNegation = {TrueSlot, FalseSlot};
+    mCommon.clear();
+    mSources.clear();
+    mOperations.clear();
+    mDisplayOperations.clear();
+    mStateOutputs.clear();
+    mOutputs.clear();
+    mDrivers.clear();
+    mFanOutBegin = {0};
+    mFanOut.clear();
+    mLoops.clear();
+    mSparty = {sparty != nullptr ? sparty->getPin()[0].get() : nullptr, -1};
+    mGateCount = 0;
+
+    vector<OutputPin *> sources;
+    sources.push_back(beam->getPins()[0].get());
+    if (sensor != nullptr)
+    {
+        for (auto &pin : sensor->getPins())
+        {
+            sources.push_back(pin.get());
+        }
+    }
+
+    // Every wire, from the output pin to the input pin it caught
+    vector<pair<OutputPin *, InputPin *>> wires;
+    auto addWires = [&wires](OutputPin *pin) {
+        for (auto &connector : pin->getConnector())
+        {
+            if (connector->getCaught() != nullptr)
+            {
+                wires.emplace_back(pin, connector->getCaught());
+            }
+        }
+    };
+
+    unordered_map<OutputPin *, int> slots;
+    for (auto pin : sources)
+    {
+        addWires(pin);
+        int slot = NewSlot(pin, pin->isConnected());
+        slots[pin] = slot;
+        mSources.push_back({pin, slot, pin->isConnected()});
+    }
+    for (auto gate : gates)
+    {
+        for (auto &pin : gate->GetOutputPins())
+        {
+            addWires(pin.get());
+        }
+    }
+
+    unordered_map<InputPin *, OutputPin *> drivers;
+    for (auto &wire : wires)
+    {
+        drivers[wire.second] = wire.first;
+    }
+
+    unordered_map<OutputPin *, int> gateOf;
+    for (size_t g = 0; g < gates.size(); g++)
+    {
+        for (auto &pin : gates[g]->GetOutputPins())
+        {
+            gateOf[pin.get()] = (int)g;
+        }
+    }
+
+    // The pins driving each gate input, nullptr if it isn't wired
+    int count = (int)gates.size();
+    vector<vector<OutputPin *>> inputs(count);
+    vector<uint8_t> wired(count, 1);
+    for (int g = 0; g < count; g++)
+    {
+        for (auto &pin : gates[g]->GetInputPins())
+        {
+            auto driver = drivers.find(pin.get());
+            inputs[g].push_back(driver == drivers.end() ? nullptr : driver->second);
+            if (driver == drivers.end() || (slots.count(driver->second) == 0 && gateOf.count(driver->second) == 0))
+            {
+                wired[g] = 0;
+            }
+        }
+    }
+
+    // A gate never computes if anything before it has an input that isn't wired
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (int g = 0; g < count; g++)
+        {
+            for (auto driver : inputs[g])
+            {
+                auto from = gateOf.find(driver);
+                if (wired[g] && from != gateOf.end() && !wired[from->second])
+                {
+                    wired[g] = 0;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    vector<vector<int>> successors(count);
+    vector<uint8_t> selfLoop(count, 0);
+    for (int g = 0; g < count; g++)
+    {
+        for (auto driver : inputs[g])
+        {
+            auto from = gateOf.find(driver);
+            if (wired[g] && from != gateOf.end())
+            {
+                successors[from->second].push_back(g);
+                selfLoop[g] |= from->second == g;
+            }
+        }
+    }
+
+    auto inputSlot = [&slots](OutputPin *driver) { return driver == nullptr ? -1 : slots[driver]; };
+
+    for (auto &component : FindComponents(successors, wired))
+    {
+        int first = component[0];
+        if (component.size() == 1 && !selfLoop[first])
+        {
+            auto gate = gates[first];
+            int a = inputSlot(inputs[first][0]);
+            int b = inputs[first].size() > 1 ? inputSlot(inputs[first][1]) : -1;
+            auto &outputs = gate->GetOutputPins();
+            auto kind = gate->GetKind();
+            if (kind == LogicGate::Kind::SR || kind == LogicGate::Kind::D)
+            {
+                int q = NewSlot(outputs[0].get(), false);
+                int qn = NewSlot(outputs[1].get(), false);
+                mOperations.push_back({kind, a, b, q, qn});
+                mStateOutputs.push_back({outputs[0].get(), q});
+                mStateOutputs.push_back({outputs[1].get(), qn});
+                slots[outputs[0].get()] = q;
+                slots[outputs[1].get()] = qn;
+            }
+            else
+            {
+                slots[outputs[0].get()] = Combine(kind, a, b, outputs[0].get());
+            }
+
+            for (auto &pin : outputs)
+            {
+                mOutputs.push_back({pin.get(), slots[pin.get()]});
+            }
+            mGateCount++;
+            continue;
+        }
+
+        // A feedback loop: every output needs a slot before the inputs can be resolved
+        Loop loop;
+        for (int g : component)
+        {
+            for (auto &pin : gates[g]->GetOutputPins())
+            {
+                int slot = NewSlot(pin.get(), false);
+                slots[pin.get()] = slot;
+                loop.mSlots.push_back(slot);
+                mOutputs.push_back({pin.get(), slot});
+            }
+        }
+
+        loop.mBegin = (int)mOperations.size();
+        for (int g : component)
+        {
+            auto &outputs = gates[g]->GetOutputPins();
+            int a = inputSlot(inputs[g][0]);
+            int b = inputs[g].size() > 1 ? inputSlot(inputs[g][1]) : -1;
+            int qn = outputs.size() > 1 ? slots[outputs[1].get()] : -1;
+            mOperations.push_back({gates[g]->GetKind(), a, b, slots[outputs[0].get()], qn});
+            if (qn >= 0)
+            {
+                mStateOutputs.push_back({outputs[0].get(), slots[outputs[0].get()]});
+                mStateOutputs.push_back({outputs[1].get(), qn});
+            }
+
+            for (int input : {a, b})
+            {
+                if (input >= 0 && find(loop.mSlots.begin(), loop.mSlots.end(), input) == loop.mSlots.end() &&
+                    find(loop.mInputs.begin(), loop.mInputs.end(), input) == loop.mInputs.end())
+                {
+                    loop.mInputs.push_back(input);
+                }
+            }
+            mGateCount++;
+        }
+        loop.mEnd = (int)mOperations.size();
+        mLoops.push_back(loop);
+    }
+
+    // Room for the states of the longest loop sweep, so sweeping doesn't allocate
+    size_t states = 0;
+    for (auto &loop : mLoops)
+    {
+        states = max(states, (loop.mEnd - loop.mBegin + 1) * loop.mSlots.size());
+    }
+    mLoopStates.assign(states, 0);
+
+    // Bucket the wires by the slot that drives them, a counting sort, so
+    // each driver is one run however far apart its wires were found.
+    // Pins that share a slot, like the same gate placed twice, share a run.
+    vector<int> wireSlots(wires.size(), -1);
+    vector<int> runEnd(mValues.size() + 1, 0);
+    for (size_t w = 0; w < wires.size(); w++)
+    {
+        auto slot = slots.find(wires[w].first);
+        if (slot != slots.end())
+        {
+            wireSlots[w] = slot->second;
+            runEnd[slot->second + 1]++;
+        }
+    }
+    for (size_t s = 1; s < runEnd.size(); s++)
+    {
+        runEnd[s] += runEnd[s - 1];
+    }
+
+    mFanOut.resize(runEnd.back());
+    vector<int> next(runEnd.begin(), runEnd.end() - 1);
+    for (size_t w = 0; w < wires.size(); w++)
+    {
+        if (wireSlots[w] < 0)
+        {
+            continue;
+        }
+
+        mFanOut[next[wireSlots[w]]++] = wires[w].second;
+        if (wires[w].second == mSparty.mPin)
+        {
+            mSparty.mSlot = wireSlots[w];
+        }
+    }
+
+    for (int s = 0; s < (int)mValues.size(); s++)
+    {
+        if (runEnd[s + 1] > runEnd[s])
+        {
+            mDrivers.push_back(s);
+            mFanOutBegin.push_back(runEnd[s + 1]);
+        }
+    }
+
+    if (mOptimize)
+    {
+        RemoveDeadGates();
+    }
+
+    mCommon.clear();
+    mBuilt = true;
+    mEvaluated = false;
+    mDisplayStale = true;
+}
+
+/**
+ * Add a slot for an output pin, starting with the value the pin has
+ * @param pin The pin
+ * @param isStatic Does the slot always compute?
+ * @return slot
+ */
+int LogicNetwork::NewSlot(OutputPin *pin, bool isStatic)
+{
+    mValues.push_back(pin->getValue());
+    mValid.push_back(pin->isConnected());
+    mStatic.push_back(isStatic);
+    mNegation.push_back(-1);
+    return (int)mValues.size() - 1;
+}
+
+/**
+ * Add an and, or or not gate, reusing a slot we already have if we can
+ * @param kind Kind of gate
+ * @param a First input slot
+ * @param b Second input slot, unused for not
+ * @param pin Gate output pin
+ * @return Slot holding the gate output
+ */
+int LogicNetwork::Combine(LogicGate::Kind kind, int a, int b, OutputPin *pin)
+{
+    bool isStatic = mStatic[a] && (kind == LogicGate::Kind::Not || mStatic[b]);
+    if (!isStatic || !mOptimize)
+    {
+        int slot = NewSlot(pin, false);
+        mOperations.push_back({kind, a, b, slot, -1});
+        return slot;
+    }
+
+    if (kind == LogicGate::Kind::Not)
+    {
+        // Covers not of a constant and not not x
+        if (mNegation[a] >= 0)
+        {
+            return mNegation[a];
+        }
+        b = -1;
+    }
+    else
+    {
+        if (a > b)
+        {
+            swap(a, b);
+        }
+
+        bool isAnd = kind == LogicGate::Kind::And;
+        if (a == b)
+        {
+            return a;
+        }
+        if (a == FalseSlot)
+        {
+            return isAnd ? FalseSlot : b;
+        }
+        if (a == TrueSlot)
+        {
+            return isAnd ? b : TrueSlot;
+        }
+        if (mNegation[a] == b)
+        {
+            return isAnd ? FalseSlot : TrueSlot;
+        }
+    }
+
+    auto common = mCommon.find({kind, a, b});
+    if (common != mCommon.end())
+    {
+        return common->second;
+    }
+
+    int slot = NewSlot(pin, true);
+    mOperations.push_back({kind, a, b, slot, -1});
+    mCommon[{kind, a, b}] = slot;
+    if (kind == LogicGate::Kind::Not)
+    {
+        mNegation[slot] = a;
+        mNegation[a] = slot;
+    }
+    return slot;
+}
+
+/**
+ * Move the operations that don't lead to Sparty, a flip-flop or a loop
+ * to the display list, they are only needed for drawing
+ */
+void LogicNetwork::RemoveDeadGates()
+{
+    vector<uint8_t> live(mValues.size(), 0);
+    if (mSparty.mSlot >= 0)
+    {
+        live[mSparty.mSlot] = 1;
+    }
+
+    // Loops hold state, so they are always kept
+    vector<uint8_t> keep(mOperations.size(), 0);
+    for (auto &loop : mLoops)
+    {
+        fill(keep.begin() + loop.mBegin, keep.begin() + loop.mEnd, 1);
+    }
+
+    for (int i = (int)mOperations.size() - 1; i >= 0; i--)
+    {
+        auto &operation = mOperations[i];
+        if (keep[i] || operation.mQn >= 0 || live[operation.mQ])
+        {
+            keep[i] = 1;
+            live[operation.mA] = 1;
+            if (operation.mB >= 0)
+            {
+                live[operation.mB] = 1;
+            }
+        }
+    }
+
+    vector<Operation> operations;
+    vector<int> moved(mOperations.size() + 1);
+    for (size_t i = 0; i < mOperations.size(); i++)
+    {
+        moved[i] = (int)operations.size();
+        (keep[i] ? operations : mDisplayOperations).push_back(mOperations[i]);
+    }
+    moved[mOperations.size()] = (int)operations.size();
+    mOperations = move(operations);
+
+    for (auto &loop : mLoops)
+    {
+        loop.mBegin = moved[loop.mBegin];
+        loop.mEnd = moved[loop.mEnd];
+    }
+}
+
+/**
+ * Largest number of input pins one output drives
+ * @return fan-out, 0 if nothing is wired
+ */
+int LogicNetwork::GetMaxFanOut() const
+{
+    int fanOut = 0;
+    for (size_t d = 0; d < mDrivers.size(); d++)
+    {
+        fanOut = max(fanOut, mFanOutBegin[d + 1] - mFanOutBegin[d]);
+    }
+    return fanOut;
+}
+
+/**
+ * Has a beam or sensor output been connected since the network was
+ * built? That changes which gates always compute, so the network has
+ * to be built again.
+ * @return true if the network is out of date
+ */
+bool LogicNetwork::SourcesChanged() const
+{
+    for (auto &source : mSources)
+    {
+        if (source.mPin->isConnected() != source.mConnected)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Compute the circuit for the current beam and sensor outputs.
+ * Running the circuit twice on the same inputs gives the same result,
+ * so nothing is done if the inputs haven't changed. That isn't true
+ * while a loop is oscillating.
+ */
+void LogicNetwork::Evaluate()
+{
+    bool changed = !mEvaluated || mOscillating > 0;
+    for (auto &source : mSources)
+    {
+        uint8_t value = source.mPin->getValue();
+        if (mValues[source.mSlot] != value)
+        {
+            mValues[source.mSlot] = value;
+            changed = true;
+        }
+    }
+    if (!changed)
+    {
+        return;
+    }
+
+    mOscillating = 0;
+    size_t loop = 0;
+    for (int i = 0; i < (int)mOperations.size();)
+    {
+        if (loop < mLoops.size() && mLoops[loop].mBegin == i)
+        {
+            if (!RunLoop(mLoops[loop]))
+            {
+                mOscillating++;
+            }
+            i = mLoops[loop++].mEnd;
+        }
+        else
+        {
+            Step(mOperations[i++]);
+        }
+    }
+    mEvaluated = true;
+    mDisplayStale = true;
+
+    for (auto &output : mStateOutputs)
+    {
+        output.mPin->setValue(mValues[output.mSlot]);
+        output.mPin->setConnect(mValid[output.mSlot]);
+    }
+    if (mSparty.mSlot >= 0)
+    {
+        mSparty.mPin->setValue(mValues[mSparty.mSlot]);
+        mSparty.mPin->setConnect(mValid[mSparty.mSlot]);
+    }
+}
+
+/**
+ * Set every pin in the circuit from the last evaluation, for drawing
+ */
+void LogicNetwork::Publish()
+{
+    if (!mBuilt || !mDisplayStale)
+    {
+        return;
+    }
+
+    Run(mDisplayOperations);
+    for (auto &output : mOutputs)
+    {
+        output.mPin->setValue(mValues[output.mSlot]);
+        output.mPin->setConnect(mValid[output.mSlot]);
+    }
+    for (size_t d = 0; d < mDrivers.size(); d++)
+    {
+        bool value = mValues[mDrivers[d]];
+        bool valid = mValid[mDrivers[d]];
+        for (int w = mFanOutBegin[d]; w < mFanOutBegin[d + 1]; w++)
+        {
+            mFanOut[w]->setValue(value);
+            mFanOut[w]->setConnect(valid);
+        }
+    }
+    mDisplayStale = false;
+}
+
+/**
+ * Run a list of operations in order, without loops
+ * @param operations Operations to run
+ */
+void LogicNetwork::Run(const std::vector<Operation> &operations)
+{
+    for (auto &op : operations)
+    {
+        Step(op);
+    }
+}
+
+/**
+ * Compute one gate. A gate only computes when all of its inputs have
+ * been computed, otherwise it holds its value, the same as the
+ * GateCompute functions.
+ * @param op The gate
+ * @return true if an output changed
+ */
+bool LogicNetwork::Step(const Operation &op)
+{
+    auto &value = mValues;
+    auto &valid = mValid;
+    uint8_t q = value[op.mQ];
+    uint8_t qn = op.mQn >= 0 ? value[op.mQn] : 0;
+
+    switch (op.mKind)
+    {
+    case LogicGate::Kind::And:
+        if (valid[op.mA] && valid[op.mB])
+        {
+            value[op.mQ] = value[op.mA] & value[op.mB];
+            valid[op.mQ] = 1;
+        }
+        break;
+
+    case LogicGate::Kind::Or:
+        if (valid[op.mA] && valid[op.mB])
+        {
+            value[op.mQ] = value[op.mA] | value[op.mB];
+            valid[op.mQ] = 1;
+        }
+        break;
+
+    case LogicGate::Kind::Not:
+        if (valid[op.mA])
+        {
+            value[op.mQ] = !value[op.mA];
+            valid[op.mQ] = 1;
+        }
+        break;
+
+    case LogicGate::Kind::SR:
+        // Set or reset when exactly one of S and R is high
+        if (valid[op.mA] && valid[op.mB] && value[op.mA] != value[op.mB])
+        {
+            value[op.mQ] = value[op.mA];
+            value[op.mQn] = value[op.mB];
+            valid[op.mQ] = valid[op.mQn] = 1;
+        }
+        break;
+
+    case LogicGate::Kind::D:
+        // Level sensitive, Q follows D while the clock is high
+        if (valid[op.mA] && valid[op.mB] && value[op.mB])
+        {
+            value[op.mQ] = value[op.mA];
+            value[op.mQn] = !value[op.mA];
+            valid[op.mQ] = valid[op.mQn] = 1;
+        }
+        break;
+    }
+
+    return value[op.mQ] != q || (op.mQn >= 0 && value[op.mQn] != qn);
+}
+
+/**
+ * Sweep a feedback loop until it settles
+ * @param loop The loop
+ * @return false if it is oscillating
+ */
+bool LogicNetwork::RunLoop(const Loop &loop)
+{
+    for (int input : loop.mInputs)
+    {
+        if (!mValid[input])
+        {
+            // Hold until everything feeding the loop has computed
+            return true;
+        }
+    }
+    for (int slot : loop.mSlots)
+    {
+        mValid[slot] = 1;
+    }
+
+    // A change needs at most one sweep per gate to go around the loop.
+    // The loop oscillates if a sweep puts it back in an earlier state.
+    size_t size = loop.mSlots.size();
+    auto states = mLoopStates.begin();
+    auto state = states;
+    int sweeps = loop.mEnd - loop.mBegin + 1;
+    for (int sweep = 0; sweep < sweeps; sweep++)
+    {
+        bool changed = false;
+        for (int i = loop.mBegin; i < loop.mEnd; i++)
+        {
+            changed |= Step(mOperations[i]);
+        }
+        if (!changed)
+        {
+            return true;
+        }
+
+        for (size_t s = 0; s < size; s++)
+        {
+            state[s] = mValues[loop.mSlots[s]];
+        }
+        for (auto earlier = states; earlier != state; earlier += size)
+        {
+            if (equal(earlier, earlier + size, state))
+            {
+                return false;
+            }
+        }
+        state += size;
+    }
+    return false;
+}
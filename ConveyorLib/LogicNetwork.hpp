@@ -0,0 +1,233 @@
+/**
+ * @file LogicNetwork.hpp
+ * @author Alex Mueller
+ *
+ * The wired gates compiled into a flat, optimized list of operations
+ */
+
+#ifndef LOGICNETWORK_HPP
+#define LOGICNETWORK_HPP
+
+#include <map>
+#include <tuple>
+#include <vector>
+#include "LogicGate.h"
+
+class Sensor;
+class Beam;
+class Sparty;
+
+/**
+ * The circuit the player wired, reduced to what has to be evaluated.
+ *
+ * Build splits the gate graph into strongly connected components and
+ * orders them so every gate comes after the gates feeding it. Gates
+ * with an input that isn't wired, or that is fed from such a gate,
+ * never compute and are left out. Every signal gets a slot, and the
+ * gates become a list of operations on those slots.
+ *
+ * A component with more than one gate, or a gate wired to itself, is a
+ * feedback loop like a latch built from gates. A loop starts computing
+ * once everything feeding it from outside has computed, from the values
+ * its pins hold. It is swept until nothing changes. If it hasn't settled
+ * after one sweep per gate, or it comes back to a state it was already
+ * in, it is oscillating and is left where the last sweep put it.
+ *
+ * Building runs an optimizer pass over the gates outside loops:
+ *
+ * - constant propagation, like x and not x, or x or 1
+ * - double negation removal, not not x is x
+ * - common subexpressions, gates with the same inputs share a slot
+ * - dead gates, gates that don't lead to Sparty or a flip-flop
+ *
+ * The optimizer only rewrites gates that always compute. Flip-flops
+ * and anything after them only compute once they are set, and hold
+ * their old value until then, so those are kept as they are. It can be
+ * turned off to check it doesn't change what the circuit computes.
+ *
+ * An output pin can drive any number of input pins. The wires are kept
+ * as a compressed sparse row table: the slot of every output pin that
+ * is wired, and for each one a run of the input pins it drives in one
+ * array. Setting the wired pins is a single pass over that array.
+ *
+ * Evaluate runs the live operations every update and only writes the
+ * pins the game needs: Sparty's input and the flip-flop outputs. If
+ * the beam and sensor haven't changed since the last update it does
+ * nothing at all. Dead gates and the values of every other pin are
+ * only needed to draw the circuit, so Publish fills them in before
+ * drawing. The drawn circuit is unchanged.
+ *
+ * The network holds raw pointers to the pins, so it has to be
+ * invalidated whenever the wiring or the items change.
+ */
+class LogicNetwork {
+public:
+    void Build(Sensor *sensor, Beam *beam, Sparty *sparty, const std::vector<LogicGate *> &gates);
+    void Evaluate();
+    void Publish();
+    bool SourcesChanged() const;
+
+    /**
+     * Throw the network away, the wiring or the items changed
+     */
+    void Invalidate() { mBuilt = false; }
+
+    /**
+     * Turn the optimizer pass on or off, it is on by default
+     * @param optimize true to optimize when the network is built
+     */
+    void SetOptimize(bool optimize)
+    {
+        mOptimize = optimize;
+        mBuilt = false;
+    }
+
+    /**
+     * Has the network been built since it was last invalidated?
+     * @return true if built
+     */
+    bool IsBuilt() const { return mBuilt; }
+
+    /**
+     * Number of wired gates that compute
+     * @return gates
+     */
+    int GetGateCount() const { return mGateCount; }
+
+    /**
+     * Number of operations evaluated every update
+     * @return operations
+     */
+    int GetOperationCount() const { return (int)mOperations.size(); }
+
+    /**
+     * Number of feedback loops in the circuit
+     * @return loops
+     */
+    int GetLoopCount() const { return (int)mLoops.size(); }
+
+    /**
+     * Number of loops that didn't settle the last time the circuit was evaluated
+     * @return oscillating loops
+     */
+    int GetOscillatingCount() const { return mOscillating; }
+
+    /**
+     * Number of wires from a computed output to an input pin
+     * @return wires
+     */
+    int GetWireCount() const { return (int)mFanOut.size(); }
+
+    /**
+     * Largest number of input pins one output drives
+     * @return fan-out
+     */
+    int GetMaxFanOut() const;
+
+private:
+    /// One gate on the slots
+    struct Operation
+    {
+        /// Kind of gate
+        LogicGate::Kind mKind;
+        /// Input slots, the second is unused for not
+        int mA;
+        /// Second input slot
+        int mB;
+        /// Output slot
+        int mQ;
+        /// Inverted output slot, flip-flops only
+        int mQn;
+    };
+
+    /// A pin that shows the value of a slot
+    template <class Pin>
+    struct PinSlot
+    {
+        /// The pin
+        Pin *mPin;
+        /// Slot it shows
+        int mSlot;
+    };
+
+    /// Operations that feed back into each other
+    struct Loop
+    {
+        /// First operation of the loop
+        int mBegin = 0;
+        /// One past the last operation of the loop
+        int mEnd = 0;
+        /// Slots from outside the loop it reads
+        std::vector<int> mInputs;
+        /// Slots the loop sets
+        std::vector<int> mSlots;
+    };
+
+    /// A beam or sensor output that the network starts from
+    struct Source
+    {
+        /// The pin
+        OutputPin *mPin;
+        /// Slot it sets
+        int mSlot;
+        /// Was it connected when the network was built?
+        bool mConnected;
+    };
+
+    int NewSlot(OutputPin *pin, bool isStatic);
+    int Combine(LogicGate::Kind kind, int a, int b, OutputPin *pin);
+    void RemoveDeadGates();
+    void Run(const std::vector<Operation> &operations);
+    bool Step(const Operation &op);
+    bool RunLoop(const Loop &loop);
+
+    /// Has the network been built?
+    bool mBuilt = false;
+    /// Does Build run the optimizer pass?
+    bool mOptimize = true;
+    /// Has Evaluate run since the network was built?
+    bool mEvaluated = false;
+    /// Do the pins need to be updated for drawing?
+    bool mDisplayStale = false;
+    /// Number of wired gates that compute
+    int mGateCount = 0;
+    /// Loops that didn't settle in the last evaluation
+    int mOscillating = 0;
+
+    /// Value of each slot
+    std::vector<uint8_t> mValues;
+    /// Has each slot been computed, like OutputPin::isConnected
+    std::vector<uint8_t> mValid;
+
+    /// Beam and sensor outputs
+    std::vector<Source> mSources;
+    /// Operations evaluated every update, in order
+    std::vector<Operation> mOperations;
+    /// Operations only needed for drawing
+    std::vector<Operation> mDisplayOperations;
+    /// Flip-flop outputs, they hold the circuit state
+    std::vector<PinSlot<OutputPin>> mStateOutputs;
+    /// Every gate output
+    std::vector<PinSlot<OutputPin>> mOutputs;
+    /// Slot of every output pin that drives a wire
+    std::vector<int> mDrivers;
+    /// Where the input pins of each driver start in mFanOut, one more than the drivers
+    std::vector<int> mFanOutBegin;
+    /// The input pins wired to each driver, driver by driver
+    std::vector<InputPin *> mFanOut;
+    /// Sparty's input pin
+    PinSlot<InputPin> mSparty{nullptr, -1};
+    /// Feedback loops, in the order they are evaluated
+    std::vector<Loop> mLoops;
+    /// Values of the slots of a loop after each sweep, room for the longest sweep
+    std::vector<uint8_t> mLoopStates;
+
+    /// Can the slot be optimized, it always computes
+    std::vector<uint8_t> mStatic;
+    /// Slot holding the inverse of each slot, or -1
+    std::vector<int> mNegation;
+    /// Slots of the gates built so far, by kind and inputs
+    std::map<std::tuple<LogicGate::Kind, int, int>, int> mCommon;
+};
+
+#endif // LOGICNETWORK_HPP
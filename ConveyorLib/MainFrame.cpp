@@ -7,6 +7,7 @@
 #include "MainFrame.hpp"
 #include "ids.hpp"
 #include "SpartyBootsView.hpp"
+#include "Trace.hpp"
 
 /**
  * Initialize the MainFrame window.
@@ -33,10 +34,12 @@ void MainFrame::Initialize()
 
     auto levelMenu = new wxMenu();
     auto gateMenu = new wxMenu();
+    auto viewMenu = new wxMenu();
     auto helpMenu = new wxMenu();
 
     menuBar->Append(levelMenu, L"&Level Select");
     menuBar->Append(gateMenu, L"&Gates");
+    menuBar->Append(viewMenu, L"&View");
     menuBar->Append(helpMenu, L"&Help");
 
     levelMenu->Append(wxID_EXIT, "E&xit\tAlt-X", "Quit this program");
@@ -46,6 +49,9 @@ void MainFrame::Initialize()
     gateMenu->Append(IDM_NOTGATE, "&Not Gate");
     gateMenu->Append(IDM_SRFLIPFLOP, "&SR Flip Flop");
     gateMenu->Append(IDM_DFLIPFLOP, "&D Flip Flop");
+    viewMenu->AppendCheckItem(IDM_PERFHUD, "&Performance HUD\tF3", "Show frame timing statistics");
+    viewMenu->AppendCheckItem(IDM_RECORDINPUT, "&Record Input\tF4", "Restart the level and record input to input.log");
+    viewMenu->Append(IDM_REWIND, "Re&wind\tF5", "Go back about three seconds");
     levelMenu->Append(IDM_LEVEL1, "Level 1");
     levelMenu->Append(IDM_LEVEL2, "Level 2");
     levelMenu->Append(IDM_LEVEL3, "Level 3");
@@ -77,10 +83,12 @@ void MainFrame::OnAbout(wxCommandEvent &event)
 
 /**
  * Handle a close event. Stop the animation and destroy this window.
+ * Trace builds write the recorded timings to trace.json here.
  * @param event The Close event
  */
 void MainFrame::OnClose(wxCloseEvent& event)
 {
     mSpartyBootsView->Stop();
+    TRACE_WRITE("trace.json");
     Destroy();
 }
\ No newline at end of file
@@ -0,0 +1,54 @@
+/**
+ * @file MotionVisitor.hpp
+ * @author Alex Mueller
+ *
+ * Visitor that finds whether anything in the level is moving
+ */
+
+#ifndef MOTIONVISITOR_HPP
+#define MOTIONVISITOR_HPP
+#include "Conveyor.hpp"
+#include "ItemVisitor.hpp"
+#include "Product.h"
+#include "Sparty.hpp"
+
+/**
+ * Visitor that finds out if any item is moving on its own,
+ * the conveyor running or Sparty swinging the boot
+ */
+class MotionVisitor : public ItemVisitor {
+public:
+    /**
+     * Add visiting conveyor
+     * @param conveyor
+     */
+    void VisitConveyor(Conveyor *conveyor) override
+    {
+        mIsMoving = mIsMoving || conveyor->IsRunning();
+    }
+    /**
+     * Add visiting for sparty
+     * @param sparty
+     */
+    void VisitSparty(Sparty *sparty) override
+    {
+        mIsMoving = mIsMoving || sparty->IsKicking();
+    }
+    /**
+     * Add visiting product, products only move with the conveyor
+     * @param product
+     */
+    void VisitProduct(Product *product) override {}
+
+    /**
+     * Is anything moving?
+     * @return true if an item is moving
+     */
+    bool IsMoving() const { return mIsMoving; }
+
+private:
+    /// Whether an item is moving
+    bool mIsMoving = false;
+};
+
+#endif // MOTIONVISITOR_HPP
@@ -43,26 +43,22 @@ NotGate::NotGate(SpartyBoots *spartyBoots): LogicGate(spartyBoots)
     auto h = NotGateSize.GetHeight(); // Height of the AND gate
 
     /// Creating a vector of pins and initializing them at the same time
-    mInputPins.push_back(std::make_shared<InputPin>(spartyBoots));
-    mOutputPins.push_back(std::make_shared<OutputPin>(spartyBoots));
+    AddInputPin();
+    AddOutputPin();
 
     /// setting the pins location to be exactly where I drew them.
     mInputPins[0]->SetLocation(x - w / 2 - DefaultLineLength, y);
     mOutputPins[0]->SetLocation(x + w / 2 + DefaultLineLength, y);
-
-    /// Adding the pins to spartyboots so that it recognizes it when hittesting
-    spartyBoots->Add(mInputPins[0]);
-    spartyBoots->Add(mOutputPins[0]);
 }
 
 /**
  * Draws the Not Gate
  * @param graphics
  */
-void NotGate::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void NotGate::Draw(DrawCommands &graphics)
 {
     // Create a path to draw the NOT gate shape
-    auto path = graphics->CreatePath();
+    auto path = graphics.CreatePath();
 
     // The location and size
     auto x = GetX();
@@ -82,11 +78,11 @@ void NotGate::Draw(std::shared_ptr<wxGraphicsContext> graphics)
     path.AddLineToPoint(p1); // Close back to the bottom left
 
     // Set pen and brush for drawing the NOT gate triangle
-    graphics->SetPen(*wxBLACK_PEN);
-    graphics->SetBrush(*wxWHITE_BRUSH);
+    graphics.SetPen(*wxBLACK_PEN);
+    graphics.SetBrush(*wxWHITE_BRUSH);
 
     // Draw the triangle path
-    graphics->DrawPath(path);
+    graphics.DrawPath(path);
 
     // Draw the small circle at the output of the NOT gate
     double circleRadius = 5;                         // Radius of the circle
@@ -104,9 +100,9 @@ void NotGate::Draw(std::shared_ptr<wxGraphicsContext> graphics)
     mOutputPins[0]->DrawPins(graphics, x + w / 2, y, x + w / 2 + DefaultLineLength, y);
 
     // Draw the circle
-    graphics->SetBrush(*wxWHITE_BRUSH); // Set brush to fill the circle
-    graphics->SetPen(*wxBLACK_PEN);
-    graphics->DrawEllipse(circleCenterX - circleRadius, circleCenterY - circleRadius, 2 * circleRadius, 2 * circleRadius);
+    graphics.SetBrush(*wxWHITE_BRUSH); // Set brush to fill the circle
+    graphics.SetPen(*wxBLACK_PEN);
+    graphics.DrawEllipse(circleCenterX - circleRadius, circleCenterY - circleRadius, 2 * circleRadius, 2 * circleRadius);
 
 }
 
@@ -118,7 +114,7 @@ void NotGate::Draw(std::shared_ptr<wxGraphicsContext> graphics)
  * @param end_x
  * @param end_y
  */
-void NotGate::DrawPins(std::shared_ptr<wxGraphicsContext> graphics, int start_x, int start_y, int end_x, int end_y)
+void NotGate::DrawPins(DrawCommands &graphics, int start_x, int start_y, int end_x, int end_y)
 {
 }
 
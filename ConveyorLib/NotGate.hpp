@@ -15,21 +15,26 @@
 #include "OutputPin.h"
 /**
  *Class NotGates
-* Derived from LogicGate, which is derived from LogicItem, which is derived from Item
+* Derived from LogicGate, which is derived from PinOwner, LogicItem and Item
 * */
 class NotGate : public LogicGate {
 private:
 public:
     /// Constructor
     NotGate(SpartyBoots *spartyBoots);
-    void DrawPins(std::shared_ptr<wxGraphicsContext> graphics, int start_x, int start_y, int end_x, int end_y) override;
+    void DrawPins(DrawCommands &graphics, int start_x, int start_y, int end_x, int end_y) override;
     /// Draw this NOT gate
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void Draw(DrawCommands &graphics) override;
     bool HitTest(int x, int y) override;
     /**
     *Compute the logic. Depending on the object/gate
     ** */
     void GateCompute() override;
+    /**
+     * Get the kind of gate
+     * @return Kind::Not
+     */
+    Kind GetKind() const override { return Kind::Not; }
 };
 
 #endif // PROJECT1_CONVEYORLIB_NOTGATE_H
@@ -42,10 +42,10 @@ OrGate::OrGate(SpartyBoots *spartyBoots): LogicGate(spartyBoots)
     auto h = OrGateSize.GetHeight(); // Height of the AND gate
 
     /// Creating a vector of pins and initializing them at the same time
-    mInputPins.push_back(std::make_shared<InputPin>(spartyBoots));
-    mInputPins.push_back(std::make_shared<InputPin>(spartyBoots));
+    AddInputPin();
+    AddInputPin();
 
-    mOutputPins.push_back(std::make_shared<OutputPin>(spartyBoots));
+    AddOutputPin();
 
     /// setting the pins location to be exactly where I drew them.
     mInputPins[0]->SetLocation(x - w / 2 - DefaultLineLength, y + h / 4);
@@ -54,21 +54,16 @@ OrGate::OrGate(SpartyBoots *spartyBoots): LogicGate(spartyBoots)
     mOutputPins[0]->SetLocation(x + w / 2 + DefaultLineLength, y);
 
 
-
-    /// Adding the pins to spartyboots so that it recognizes it when hittesting
-    spartyBoots->Add(mInputPins[0]);
-    spartyBoots->Add(mInputPins[1]);
-    spartyBoots->Add(mOutputPins[0]);
 }
 
 /**
  * Draw the OR gate
  * @param graphics
  */
-void OrGate::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void OrGate::Draw(DrawCommands &graphics)
 {
     // Create a path to draw the gate shape
-    auto path = graphics->CreatePath();
+    auto path = graphics.CreatePath();
 
     // The the location and size
     auto x = GetX();
@@ -94,9 +89,9 @@ void OrGate::Draw(std::shared_ptr<wxGraphicsContext> graphics)
     path.CloseSubpath();
 
     // Draw the path
-    graphics->SetPen(*wxBLACK_PEN);
-    graphics->SetBrush(*wxWHITE_BRUSH);
-    graphics->DrawPath(path);
+    graphics.SetPen(*wxBLACK_PEN);
+    graphics.SetBrush(*wxWHITE_BRUSH);
+    graphics.DrawPath(path);
 
     // // Compute value of input and change output accordingly
     // GateCompute();
@@ -122,7 +117,7 @@ void OrGate::Draw(std::shared_ptr<wxGraphicsContext> graphics)
  * @param end_x where pin end (and where the pin is)
  * @param end_y where pin end (and where the pin is)
  */
-void OrGate::DrawPins(std::shared_ptr<wxGraphicsContext> graphics, int start_x, int start_y, int end_x, int end_y)
+void OrGate::DrawPins(DrawCommands &graphics, int start_x, int start_y, int end_x, int end_y)
 {
 }
 
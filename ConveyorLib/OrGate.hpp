@@ -21,13 +21,18 @@ class OrGate : public LogicGate {
 private:
 public:
     OrGate(SpartyBoots *spartyBoots);
-    void DrawPins(std::shared_ptr<wxGraphicsContext> graphics, int start_x, int start_y, int end_x, int end_y) override;
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void DrawPins(DrawCommands &graphics, int start_x, int start_y, int end_x, int end_y) override;
+    void Draw(DrawCommands &graphics) override;
     bool HitTest(int x, int y) override;
     /**
     *Compute the logic. Depending on the object/gate
     ** */
     void GateCompute() override;
+    /**
+     * Get the kind of gate
+     * @return Kind::Or
+     */
+    Kind GetKind() const override { return Kind::Or; }
 };
 
 // need this comment to commit for some reason feel free to delete
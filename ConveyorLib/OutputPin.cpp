@@ -5,19 +5,27 @@
 
 
 #include "pch.h"
+#include <algorithm>
 #include "OutputPin.h"
+#include "Snapshot.hpp"
 #include "SpartyBoots.hpp"
+#include "WireBatch.hpp"
 
-OutputPin::OutputPin(SpartyBoots *spartyBoots): LogicItem(spartyBoots)
-{
-    mConnector.push_back(std::make_shared<PinConnector>(spartyBoots, this));
-}
+/// Diameter to draw the pin in pixels
+const int PinSize = 10;
+
+/**
+ * Constructor. The pin has no connectors until a wire is
+ * dragged from it.
+ * @param spartyBoots
+ */
+OutputPin::OutputPin(SpartyBoots *spartyBoots): LogicItem(spartyBoots) {}
 
 /**
  * Draw AndGate with virtual pixel
  * @param graphics
  */
-void OutputPin::Draw(std::shared_ptr<wxGraphicsContext> graphics) {}
+void OutputPin::Draw(DrawCommands &graphics) {}
 
 /**
  * Draw the pins of AndGate by calling from LogicItem
@@ -29,28 +37,28 @@ void OutputPin::Draw(std::shared_ptr<wxGraphicsContext> graphics) {}
  * @param end_y where pin end (and
  * where the pin is)
  */
-void OutputPin::DrawPins(std::shared_ptr<wxGraphicsContext> graphics, int start_x, int start_y, int end_x, int end_y)
+void OutputPin::DrawPins(DrawCommands &graphics, int start_x, int start_y, int end_x, int end_y)
 {
     // Create a path to draw the AND gate shape
-    auto path = graphics->CreatePath();
+    auto path = graphics.CreatePath();
 
     int pinRadius = PinSize / 2;
 
-    graphics->SetPen(*wxBLACK_PEN);
+    graphics.SetPen(*wxBLACK_PEN);
     if (mConnected)
     {
         if (getValue())
         {
-            graphics->SetBrush(ConnectionColorOne); // Gray color for the pin circles
+            graphics.SetBrush(WireBatch::ConnectionColorOne); // Gray color for the pin circles
         }
         else
         {
-            graphics->SetBrush(ConnectionColorZero); // Gray color for the pin circles
+            graphics.SetBrush(WireBatch::ConnectionColorZero); // Gray color for the pin circles
         }
     }
     else
     {
-        graphics->SetBrush(ConnectionColorUnknown); // Gray color for the pin circles
+        graphics.SetBrush(WireBatch::ConnectionColorUnknown); // Gray color for the pin circles
     }
 
     // Left pins (inputs) should be vertically aligned
@@ -62,27 +70,13 @@ void OutputPin::DrawPins(std::shared_ptr<wxGraphicsContext> graphics, int start_
     path.AddLineToPoint(endPin); // Draw the left vertical line
 
     // Draw the path
-    graphics->DrawPath(path);
+    graphics.DrawPath(path);
 
     // Draw the pins as circles
-    graphics->DrawEllipse(endPin.m_x - pinRadius, endPin.m_y - pinRadius, PinSize, PinSize); // First input pin
-
-    //check if all the connectors are connected. If yes, create a new pinConnector so you can link multiple inputs to 1 output
-    // int count = 0;
-    // for (auto connector : mConnector) {
-    //     if (connector->getCaught() == nullptr)
-    //     {
-    //         count++;
-    //     }
-    // }
-    // if (count == 0)
-    // {
-    //     mConnector.insert(mConnector.begin(), std::make_shared<PinConnector>(GetSpartyBoots(), this));
-    // }
-
-
-    //Draw the connectors
-    for (auto connector : mConnector) {
+    graphics.DrawEllipse(endPin.m_x - pinRadius, endPin.m_y - pinRadius, PinSize, PinSize); // First input pin
+
+    //Draw the connectors, one for every input pin this output drives
+    for (const auto &connector : mConnector) {
         connector->Draw(graphics);
     }
 }
@@ -120,37 +114,72 @@ bool OutputPin::HitTest(int x, int y)
 }
 
 void OutputPin::Accept(ItemVisitor &visitor) {}
+
+/**
+ * Wire this output to an input pin as if the free connector
+ * had been dragged onto it. Used for pre-wired levels.
+ * @param inputPin Input pin to connect to
+ */
+void OutputPin::Connect(InputPin *inputPin)
+{
+    auto connector = std::make_shared<PinConnector>(GetSpartyBoots(), this);
+    AddConnector(connector);
+    connector->SetCaught(inputPin);
+}
 /**
- * updates values of pins
+ * Start a new wire if the pin was clicked on. Connectors are only
+ * made for wires that are dragged or drawn, any left that caught
+ * nothing are dropped first.
+ * @param x X location clicked on
+ * @param y Y location clicked on
+ * @return the new connector or nullptr if the pin wasn't hit
  */
-void OutputPin::UpdateValues(){
-    for (auto connection : mConnector)
+std::shared_ptr<IDraggable> OutputPin::HitDraggable(int x, int y)
+{
+    if (!HitTest(x, y))
     {
-        //updating value every input pin of the connection from outputPin
-        if (connection->getCaught() != nullptr)
-        {
-            connection->getCaught()->setValue(mValue);
-            connection->getCaught()->setConnect(mConnected);
-        }
+        return nullptr;
     }
 
+    mConnector.erase(std::remove_if(mConnector.begin(), mConnector.end(),
+            [](const std::shared_ptr<PinConnector> &connector) {
+                return connector->getCaught() == nullptr && !connector->IsDragging();
+            }), mConnector.end());
+
+    auto connector = std::make_shared<PinConnector>(GetSpartyBoots(), this);
+    AddConnector(connector);
+    return connector;
 }
 
 /**
- *
- * @param x
- * @param y
- * @return
+ * Remove a connector, when its wire no longer goes anywhere
+ * @param connection Connector to remove
  */
-std::shared_ptr<IDraggable> OutputPin::HitDraggable(int x, int y)
+void OutputPin::RemoveConnector(PinConnector *connection)
 {
-    for (auto pinConnector : mConnector)
-    {
-        if(pinConnector->HitTest(x, y))
-        {
-            return pinConnector;
-        }
-    }
+    mConnector.erase(std::remove_if(mConnector.begin(), mConnector.end(),
+            [connection](const std::shared_ptr<PinConnector> &connector) { return connector.get() == connection; }),
+        mConnector.end());
+}
+
+/**
+ * Save the state that changes as the game runs
+ * @param writer Snapshot to write to
+ */
+void OutputPin::SaveState(SnapshotWriter &writer)
+{
+    Item::SaveState(writer);
+    writer.Write(mConnected);
+    writer.Write(mValue);
+}
 
-    return nullptr;
-}
\ No newline at end of file
+/**
+ * Restore the state saved by SaveState
+ * @param reader Snapshot to read from
+ */
+void OutputPin::LoadState(SnapshotReader &reader)
+{
+    Item::LoadState(reader);
+    reader.Read(mConnected);
+    reader.Read(mValue);
+}
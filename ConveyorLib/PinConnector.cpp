@@ -7,7 +7,6 @@
 #include "PinConnector.h"
 #include "SpartyBoots.hpp"
 #include "OutputPin.h"
-#include <cmath>
 
 
 ///Pin radius to click
@@ -16,21 +15,6 @@ int pinRadius = 5;
 /// Diameter to draw the pin in pixels
 const int PinSize = 10;
 
-/// Color to use for drawing a zero connection wire
-const wxColour ConnectionColorZero = *wxBLACK;
-
-/// Color to use for drawing a one connection wire
-const wxColour ConnectionColorOne = *wxRED;
-
-/// Color to use for drawing an unknown state connection wire
-const wxColour ConnectionColorUnknown = wxColour(128, 128, 128);
-
-/// Maximum offset of Bezier control points relative to line ends
-static constexpr double BezierMaxOffset = 200;
-
-/// Line with for drawing lines between pins
-static const int LineWidth = 3;
-
 /// Default length of line from the pin
 static const int DefaultLineLength = 20;
 
@@ -51,6 +35,7 @@ void PinConnector::SetLocation(double x, double y)
         // Release any previous catch
         mCaught->SetLine(nullptr);
         mCaught = nullptr;
+        GetSpartyBoots()->WiringChanged();
     }
     mLineEnd = wxPoint(int(x), int(y));
 }
@@ -58,69 +43,38 @@ void PinConnector::SetLocation(double x, double y)
 /**
  * Draw this fishing rod.
  *
- * This is just used in development to see where the
- * rod end is supposed to be.
+ * The wire is added to the frame's wire batch, which strokes all the
+ * wires of a color at once after the items are drawn. The curve to a
+ * caught pin is only worked out again when one of the pins moved.
  *
  * @param graphics graphics to draw on
  */
-void PinConnector::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void PinConnector::Draw(DrawCommands &graphics)
 {
-    double connectorX = mOwner->GetX();
-    double connectorY = mOwner->GetY();
-
-    graphics->SetPen(graphics->CreatePen(wxGraphicsPenInfo (ConnectionColorUnknown, 3)));
+    wxPoint2DDouble p1(mOwner->GetX(), mOwner->GetY());
+    auto &wires = GetSpartyBoots()->GetWires();
 
     if (mDragging)
     {
-        // Define points p1 and p4
-        wxPoint2DDouble p1(connectorX, connectorY);
-        wxPoint2DDouble p4(mLineEnd.x, mLineEnd.y);
-
-        // Calculate offset
-        double distance = std::hypot(p4.m_x - p1.m_x, p4.m_y - p1.m_y);
-        double offset = std::min(BezierMaxOffset, distance);
-
-        // Define points p2 and p3 for curvature control
-        wxPoint2DDouble p2(p1.m_x + offset, p1.m_y);
-        wxPoint2DDouble p3(p4.m_x - offset, p4.m_y);
-
-        // Create and draw Bezier curve path
-        wxGraphicsPath path = graphics->CreatePath();
-        path.MoveToPoint(p1.m_x, p1.m_y);
-        path.AddCurveToPoint(p2.m_x, p2.m_y, p3.m_x, p3.m_y, p4.m_x, p4.m_y);
-
-        graphics->StrokePath(path);
+        wires.Add(WireBatch::State::Unknown, WireBatch::MakeCurve(p1, wxPoint2DDouble(mLineEnd.x, mLineEnd.y)));
     }
 
     if (mCaught != nullptr)
     {
+        wxPoint2DDouble p4(mCaught->GetX(), mCaught->GetY());
+        if (!mCurveValid || mCurve.mP1.m_x != p1.m_x || mCurve.mP1.m_y != p1.m_y ||
+            mCurve.mP4.m_x != p4.m_x || mCurve.mP4.m_y != p4.m_y)
+        {
+            mCurve = WireBatch::MakeCurve(p1, p4);
+            mCurveValid = true;
+        }
 
+        auto state = WireBatch::State::Unknown;
         if (mCaught->isConnected())
         {
-            if (mCaught->getValue())
-            {
-                graphics->SetPen(graphics->CreatePen(wxGraphicsPenInfo (ConnectionColorOne, 3)));
-            }
-            else
-            {
-                graphics->SetPen(graphics->CreatePen(wxGraphicsPenInfo (ConnectionColorZero, 3)));
-            }
+            state = mCaught->getValue() ? WireBatch::State::One : WireBatch::State::Zero;
         }
-
-        wxPoint2DDouble p1(connectorX, connectorY);
-        wxPoint2DDouble p4(mCaught->GetX(), mCaught->GetY());
-
-        double distance = std::hypot(p4.m_x - p1.m_x, p4.m_y - p1.m_y);
-        double offset = std::min(BezierMaxOffset, distance);
-
-        wxPoint2DDouble p2(p1.m_x + offset, p1.m_y);
-        wxPoint2DDouble p3(p4.m_x - offset, p4.m_y);
-
-        wxGraphicsPath path = graphics->CreatePath();
-        path.MoveToPoint(p1.m_x, p1.m_y);
-        path.AddCurveToPoint(p2.m_x, p2.m_y, p3.m_x, p3.m_y, p4.m_x, p4.m_y);
-
-        graphics->StrokePath(path);
+        wires.Add(state, mCurve);
     }
 }
 
@@ -148,6 +102,13 @@ void PinConnector::Release()
     }
 
     mDragging = false;
+
+    // A wire that caught nothing isn't drawn, so the connector goes.
+    // Whoever grabbed it still holds a reference until the release ends.
+    if (mCaught == nullptr)
+    {
+        mOwner->RemoveConnector(this);
+    }
 }
 
 /**
@@ -167,13 +128,12 @@ void PinConnector::SetCaught(InputPin* caught)
     if(mCaught != nullptr)
     {
         mCaught->SetLine(this);
-        //Creating new connection as this one gets tethered
-        this->getOwner()->AddConnector(std::make_shared<PinConnector>(this->GetSpartyBoots(), this->getOwner()));
     }
 
+    GetSpartyBoots()->WiringChanged();
 }
 
 void PinConnector::MoveToFront()
 {
-    mOwner->GetSpartyBoots()->MoveToFront(mOwner);
+    mOwner->MoveToFront();
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #define PINCONNECTOR_H
 
 #include "Item.hpp"
+#include "WireBatch.hpp"
 
 class InputPin;
 class OutputPin;
@@ -30,6 +31,12 @@ private:
 
     /// Pin that owns this connector
     OutputPin* mOwner = nullptr;
+
+    /// Curve of the wire to the caught pin, kept until either end moves
+    WireBatch::Curve mCurve;
+
+    /// Is mCurve the curve between where the pins are now?
+    bool mCurveValid = false;
 public:
     /**
      * Constructor for pin connector
@@ -47,8 +54,13 @@ public:
      * @return mCaught
      */
     InputPin* getCaught(){ return mCaught; }
+    /**
+     * Is the wire being dragged?
+     * @return true if dragging
+     */
+    bool IsDragging() const { return mDragging; }
     void SetLocation(double x, double y) override;
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void Draw(DrawCommands &graphics) override;
     bool HitTest(int x, int y) override;
     void Accept(ItemVisitor &visitor) {};
     void Release() override;
@@ -0,0 +1,117 @@
+/**
+ * @file PinOwner.cpp
+ * @author Alex Mueller
+ */
+#include "pch.h"
+#include <algorithm>
+#include <limits>
+#include "PinOwner.hpp"
+#include "InputPin.h"
+#include "OutputPin.h"
+
+/// Distance from the center of a pin it can still be clicked
+const double PinHitRadius = 5;
+
+/**
+ * Add an input pin as a child of this item
+ */
+void PinOwner::AddInputPin()
+{
+    auto pin = std::make_shared<InputPin>(GetSpartyBoots());
+    pin->mParent = this;
+    mInputPins.push_back(pin);
+    mPinBoundsValid = false;
+}
+
+/**
+ * Add an output pin as a child of this item
+ */
+void PinOwner::AddOutputPin()
+{
+    auto pin = std::make_shared<OutputPin>(GetSpartyBoots());
+    pin->mParent = this;
+    mOutputPins.push_back(pin);
+    mPinBoundsValid = false;
+}
+
+/**
+ * Find the box around the pins
+ */
+void PinOwner::UpdatePinBounds()
+{
+    mPinLeft = mPinTop = std::numeric_limits<double>::infinity();
+    mPinRight = mPinBottom = -std::numeric_limits<double>::infinity();
+
+    auto extend = [this](const Item &pin) {
+        mPinLeft = std::min(mPinLeft, pin.GetX() - PinHitRadius);
+        mPinTop = std::min(mPinTop, pin.GetY() - PinHitRadius);
+        mPinRight = std::max(mPinRight, pin.GetX() + PinHitRadius);
+        mPinBottom = std::max(mPinBottom, pin.GetY() + PinHitRadius);
+    };
+    for (auto &pin : mInputPins)
+    {
+        extend(*pin);
+    }
+    for (auto &pin : mOutputPins)
+    {
+        extend(*pin);
+    }
+
+    mPinBoundsValid = true;
+}
+
+/**
+ * Is a point in the box around the pins?
+ * @param x X location
+ * @param y Y location
+ * @return true if it is, false if it can't be on a pin
+ */
+bool PinOwner::PinBoundsContain(double x, double y)
+{
+    if (!mPinBoundsValid)
+    {
+        UpdatePinBounds();
+    }
+
+    return x >= mPinLeft && x <= mPinRight && y >= mPinTop && y <= mPinBottom;
+}
+
+/**
+ * Find a pin, or the wire end of an output pin, at a location.
+ * The box around the pins is tested first, so most clicks only
+ * look at the item.
+ * @param x X location
+ * @param y Y location
+ * @return the thing hit or nullptr if none
+ */
+std::shared_ptr<IDraggable> PinOwner::HitDraggable(int x, int y)
+{
+    if ((mInputPins.empty() && mOutputPins.empty()) || !PinBoundsContain(x, y))
+    {
+        return nullptr;
+    }
+
+    for (auto &pin : mOutputPins)
+    {
+        auto connector = pin->HitDraggable(x, y);
+        if (connector != nullptr)
+        {
+            return connector;
+        }
+
+        if (pin->HitTest(x, y))
+        {
+            return pin;
+        }
+    }
+
+    for (auto &pin : mInputPins)
+    {
+        if (pin->HitTest(x, y))
+        {
+            return pin;
+        }
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file PinOwner.hpp
+ * @author Alex Mueller
+ *
+ * A logic item that has pins, the gates, sensor, beam and Sparty
+ */
+
+#ifndef PINOWNER_HPP
+#define PINOWNER_HPP
+
+#include <vector>
+#include "LogicItem.hpp"
+
+class InputPin;
+class OutputPin;
+
+/**
+ * Logic item that owns pins.
+ *
+ * The pins are its children. They aren't items of the game on their
+ * own, the owner draws them, finds clicks on them and comes to the
+ * front when one is grabbed. The pin lists and the box around the pins
+ * are kept here so the pins themselves don't carry them.
+ */
+class PinOwner : public LogicItem {
+private:
+    /// Box around the pins, so a click far from them skips them
+    double mPinLeft = 0, mPinTop = 0, mPinRight = 0, mPinBottom = 0;
+    /// Is the box around where the pins are now?
+    bool mPinBoundsValid = false;
+
+    void UpdatePinBounds();
+
+protected:
+    /// vector containing input pins
+    std::vector<std::shared_ptr<InputPin>> mInputPins;
+    /// vector containing output pins
+    std::vector<std::shared_ptr<OutputPin>> mOutputPins;
+
+    void AddInputPin();
+    void AddOutputPin();
+
+    /**
+     *Call the constructor from logic item
+     *@param spartyBoots the mspartyboots object
+     */
+    PinOwner(SpartyBoots *spartyBoots) : LogicItem(spartyBoots) {}
+
+public:
+    std::shared_ptr<IDraggable> HitDraggable(int x, int y) override;
+    bool PinBoundsContain(double x, double y);
+
+    /**
+     * A pin moved, the box around the pins has to be found again
+     */
+    void InvalidatePinBounds() { mPinBoundsValid = false; }
+
+    /**
+     * getter for input pins
+     * @return mInputPins
+     */
+    const std::vector<std::shared_ptr<InputPin>> &GetInputPins() const { return mInputPins; }
+    /**
+     * getter for output pins
+     * @return mOutputPins
+     */
+    const std::vector<std::shared_ptr<OutputPin>> &GetOutputPins() const { return mOutputPins; }
+};
+
+#endif // PINOWNER_HPP
@@ -0,0 +1,80 @@
+/**
+ * @file PixelDiff.cpp
+ * @author Alex Mueller
+ */
+
+#include "pch.h"
+#include <cstdlib>
+#include "PixelDiff.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define PIXELDIFF_SSE2
+#endif
+
+/**
+ * Count the pixels where any channel differs by more than a tolerance
+ * @param a First buffer, four bytes a pixel
+ * @param b Second buffer, four bytes a pixel
+ * @param pixels Number of pixels in each buffer
+ * @param tolerance Largest difference in a channel that still matches
+ * @return number of pixels that differ
+ */
+int PixelDiff::CountDifferent(const unsigned char *a, const unsigned char *b, int pixels, int tolerance)
+{
+    int count = 0;
+    int done = 0;
+
+#ifdef PIXELDIFF_SSE2
+    const __m128i limit = _mm_set1_epi8((char)(unsigned char)(tolerance < 0 ? 0 : tolerance > 255 ? 255 : tolerance));
+    const __m128i zero = _mm_setzero_si128();
+    for (; done + 4 <= pixels; done += 4)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i *)(a + done * 4));
+        __m128i y = _mm_loadu_si128((const __m128i *)(b + done * 4));
+
+        // |x - y| from the two saturated differences, then how far past the tolerance
+        __m128i diff = _mm_or_si128(_mm_subs_epu8(x, y), _mm_subs_epu8(y, x));
+        __m128i over = _mm_subs_epu8(diff, limit);
+
+        // A bit per channel, set where the channel matches
+        int same = _mm_movemask_epi8(_mm_cmpeq_epi8(over, zero));
+        for (int pixel = 0; pixel < 4; pixel++)
+        {
+            if (((same >> (pixel * 4)) & 0xf) != 0xf)
+            {
+                count++;
+            }
+        }
+    }
+#endif
+
+    return count + CountDifferentScalar(a + done * 4, b + done * 4, pixels - done, tolerance);
+}
+
+/**
+ * Count the pixels where any channel differs by more than a tolerance,
+ * a byte at a time
+ * @param a First buffer, four bytes a pixel
+ * @param b Second buffer, four bytes a pixel
+ * @param pixels Number of pixels in each buffer
+ * @param tolerance Largest difference in a channel that still matches
+ * @return number of pixels that differ
+ */
+int PixelDiff::CountDifferentScalar(const unsigned char *a, const unsigned char *b, int pixels, int tolerance)
+{
+    int count = 0;
+    for (int i = 0; i < pixels * 4; i += 4)
+    {
+        for (int channel = 0; channel < 4; channel++)
+        {
+            if (std::abs(a[i + channel] - b[i + channel]) > tolerance)
+            {
+                count++;
+                break;
+            }
+        }
+    }
+
+    return count;
+}
@@ -0,0 +1,23 @@
+/**
+ * @file PixelDiff.hpp
+ * @author Alex Mueller
+ *
+ * Compares rendered frames pixel by pixel
+ */
+
+#ifndef PIXELDIFF_HPP
+#define PIXELDIFF_HPP
+
+/**
+ * Counts the pixels that differ between two RGBA buffers.
+ *
+ * Frames are compared 16 bytes at a time with SSE2 where the compiler
+ * has it, otherwise a byte at a time.
+ */
+class PixelDiff {
+public:
+    static int CountDifferent(const unsigned char *a, const unsigned char *b, int pixels, int tolerance = 0);
+    static int CountDifferentScalar(const unsigned char *a, const unsigned char *b, int pixels, int tolerance = 0);
+};
+
+#endif // PIXELDIFF_HPP
@@ -5,7 +5,10 @@
 
 #include "pch.h"
 #include "Product.h"
+#include "SpartyBoots.hpp"
+#include "Snapshot.hpp"
 #include <wx/graphics.h>
+#include "Trace.hpp"
 
 /// Default product size in pixels
 std::wstring ProductDefaultSize = L"80";
@@ -149,19 +152,37 @@ Product::Product(SpartyBoots *spartyBoots, wxString placement, wxString shape, w
         // Handle error or set default
         mContentProperty = Properties::None;
     }
+
+    // The drawing only depends on the three properties, pack them into
+    // one number for the sprite cache
+    mSpriteKey = ((int)mShapeProperty * PropertyCount + (int)mColorProperty) * PropertyCount +
+        (int)mContentProperty;
 }
 
 /**
- * Draws the product on screen.
+ * Draws the product on screen. The products are blitted from sprites
+ * after the items are drawn, so this only adds it to them.
  * @param graphics The graphics context
  */
-void Product::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void Product::Draw(DrawCommands &graphics)
 {
-    graphics->PushState();
-    if (mClipRegion.GetWidth() > 0)
-        graphics->Clip(wxRegion(mClipRegion));
+    if (mDormant)
+    {
+        return;
+    }
+
+    GetSpartyBoots()->GetProductSprites().Add(this);
+}
 
-    // draw product...
+/**
+ * Draws the shape and content of the product, without the clip.
+ * Used to render the sprite of the product.
+ * @param graphics The graphics context
+ * @param x X of the top left of the shape
+ * @param y Y of the top left of the shape
+ */
+void Product::DrawShape(DrawCommands &graphics, double x, double y)
+{
     // Set color based on the product's color property
     wxColour color;
     switch (mColorProperty)
@@ -182,26 +203,26 @@ void Product::Draw(std::shared_ptr<wxGraphicsContext> graphics)
         color = *wxLIGHT_GREY;
         break; // Default color
     }
-    graphics->SetBrush(wxBrush(color));
-    graphics->SetPen(wxPen(color));
+    graphics.SetBrush(wxBrush(color));
+    graphics.SetPen(wxPen(color));
 
     // Draw shape based on the property
     if (mShapeProperty == Properties::Square)
     {
-        graphics->DrawRectangle(GetX(), GetY(), 50, 50);
+        graphics.DrawRectangle(x, y, 50, 50);
     }
     else if (mShapeProperty == Properties::Circle)
     {
-        graphics->DrawEllipse(GetX(), GetY(), 50, 50);
+        graphics.DrawEllipse(x, y, 50, 50);
     }
     else if (mShapeProperty == Properties::Diamond)
     {
         // Translate to the center of the rectangle to rotate
-        graphics->PushState();
-        graphics->Translate(GetX() + 25, GetY() + 25); // Move to the center of the rectangle
-        graphics->Rotate(wxDegToRad(45));              // Rotate 45 degrees
-        graphics->DrawRectangle(-25, -25, 50, 50);
-        graphics->PopState();
+        graphics.PushState();
+        graphics.Translate(x + 25, y + 25); // Move to the center of the rectangle
+        graphics.Rotate(wxDegToRad(45));    // Rotate 45 degrees
+        graphics.DrawRectangle(-25, -25, 50, 50);
+        graphics.PopState();
     }
 
     if (mContentBitmap.IsOk())
@@ -214,10 +235,8 @@ void Product::Draw(std::shared_ptr<wxGraphicsContext> graphics)
         int offsetX = (size - imageSize) / 2;
         int offsetY = (size - imageSize) / 2;
 
-        graphics->DrawBitmap(mContentBitmap, GetX() + offsetX, GetY() + offsetY, imageSize, imageSize);
+        graphics.DrawBitmap(mContentBitmap, x + offsetX, y + offsetY, imageSize, imageSize);
     }
-
-    graphics->PopState();
 }
 
 /**
@@ -228,6 +247,11 @@ void Product::Draw(std::shared_ptr<wxGraphicsContext> graphics)
  */
 bool Product::HitTest(int x, int y)
 {
+    if (mDormant)
+    {
+        return false;
+    }
+
     int testX = x - GetX();
     int testY = y - GetY();
     if (((testX < 50 && testX >= 0) && (testY < 50 && testY >= 0)) && (mContentProperty == Properties::Wolverine))
@@ -247,11 +271,32 @@ void Product::UpdateClipRegion(const wxRect &rect)
     mClipRegion = rect;
 }
 
+/**
+ * Make the product dormant once it has been scored and has moved
+ * completely out of the clip region. Products only move down and to
+ * the left, so it never comes back into view.
+ */
+void Product::RetireIfGone()
+{
+    if (mDormant || !mScoreDrawn || mClipRegion.GetWidth() <= 0)
+    {
+        return;
+    }
+
+    if (GetX() + ShapeSize + SpriteMargin < mClipRegion.GetLeft() ||
+        GetY() - SpriteMargin > mClipRegion.GetBottom())
+    {
+        mDormant = true;
+    }
+}
+
 /**
  * function for loading bitmap image
  */
 void Product::LoadContentImage()
 {
+    TRACE_SCOPE("DecodeImages Product");
+
     auto imageIt = PropertiesToContentImages.find(mContentProperty);
     if (imageIt != PropertiesToContentImages.end())
     {
@@ -263,4 +308,26 @@ void Product::LoadContentImage()
     }
 }
 
+/**
+ * Save the state that changes as the game runs
+ * @param writer Snapshot to write to
+ */
+void Product::SaveState(SnapshotWriter &writer)
+{
+    Item::SaveState(writer);
+    writer.Write(mWasKicked);
+    writer.Write(mScoreDrawn);
+    writer.Write(mDormant);
+}
 
+/**
+ * Restore the state saved by SaveState
+ * @param reader Snapshot to read from
+ */
+void Product::LoadState(SnapshotReader &reader)
+{
+    Item::LoadState(reader);
+    reader.Read(mWasKicked);
+    reader.Read(mScoreDrawn);
+    reader.Read(mDormant);
+}
@@ -7,6 +7,8 @@
 
 #ifndef PRODUCT_H
 #define PRODUCT_H
+#include <array>
+#include <functional>
 #include <map>
 #include "Item.hpp"
 /**
@@ -34,6 +36,9 @@ public:
         Wolverine
     };
 
+    /// Number of values in the Properties enum
+    static constexpr int PropertyCount = (int)Properties::Wolverine + 1;
+
     /// The property types
     enum class Types
     {
@@ -52,9 +57,25 @@ public:
     /// Mapping from content properties to their associated image
     static const std::map<Properties, std::wstring> PropertiesToContentImages;
     Product(SpartyBoots *spartyBoots, wxString placement, wxString shape, wxString color, wxString content, wxString kick);
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    /// Size of the square a product is drawn in, in pixels
+    static constexpr int ShapeSize = 50;
+    /// Space around the shape in a sprite, how far a diamond, the square
+    /// rotated 45 degrees, reaches past that square
+    static constexpr int SpriteMargin = 11;
+    /// Size of a product sprite in virtual pixels
+    static constexpr int SpriteSize = ShapeSize + 2 * SpriteMargin;
+
+    void Draw(DrawCommands &graphics) override;
+    void DrawShape(DrawCommands &graphics, double x, double y);
     bool HitTest(int x, int y) override;
     void UpdateClipRegion(const wxRect &rect);
+    /**
+     * Get the clip region for drawing on the conveyor belt
+     * @return clip rectangle, zero width if not clipped
+     */
+    const wxRect &GetClipRegion() const { return mClipRegion; }
+    void SaveState(SnapshotWriter &writer) override;
+    void LoadState(SnapshotReader &reader) override;
     /**
      * Getter for placement
      * @return mPlacement
@@ -105,9 +126,24 @@ public:
      */
     void Accept(ItemVisitor &visitor) override
     {
-        visitor.VisitProduct(this);
+        if (!mDormant)
+        {
+            visitor.VisitProduct(this);
+        }
     }
 
+    /**
+     * Is the product dormant? A dormant product has been scored and has
+     * left the conveyor for good, so it isn't updated or drawn any more.
+     * @return true if dormant
+     */
+    bool IsDormant() const
+    {
+        return mDormant;
+    }
+
+    void RetireIfGone();
+
     /**
      * check if object needs to be kicked
      * @return mkick
@@ -152,6 +188,22 @@ public:
         return {mContent, mShape, mColor};
     }
 
+    /**
+     * The same properties as GetContent, without copying them
+     * @return content, shape and color
+     */
+    std::array<std::reference_wrapper<const wxString>, 3> GetProperties() const
+    {
+        return {std::cref(mContent), std::cref(mShape), std::cref(mColor)};
+    }
+
+    /**
+     * Key of the sprite this product is drawn from, the same for all
+     * products with the same shape, color and content
+     * @return sprite key
+     */
+    int GetSpriteKey() const { return mSpriteKey; }
+
     /**
      * Sets mWasKicked
      */
@@ -160,6 +212,8 @@ public:
 private:
     /// The clip region for drawing on the conveyor belt.
     wxRect mClipRegion;
+    /// scored and off the conveyor
+    bool mDormant = false;
     /// set as last product
     bool mLastProduct = false;
     /// placement
@@ -182,6 +236,8 @@ private:
     Properties mShapeProperty = Properties::None;
     Properties mColorProperty = Properties::None;
     Properties mContentProperty = Properties::None;
+    /// Shape, color and content packed into one number
+    int mSpriteKey = 0;
     /// bitmap
     wxBitmap mContentBitmap;
     /// score has been acounted for
@@ -0,0 +1,65 @@
+/**
+ * @file ProductQueue.cpp
+ * @author Alex Mueller
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include "ProductQueue.hpp"
+#include "Product.h"
+
+/**
+ * Remove every product, the items were cleared
+ */
+void ProductQueue::Clear()
+{
+    mProducts.clear();
+    Reset();
+}
+
+/**
+ * Add a product. Products lower on the conveyor reach the beam first,
+ * so a product placed after one lower down goes in ahead of it.
+ * @param product Product to add
+ */
+void ProductQueue::Add(Product *product)
+{
+    auto loc = std::upper_bound(mProducts.begin(), mProducts.end(), product,
+                                [](Product *a, Product *b) { return a->GetY() > b->GetY(); });
+    mProducts.insert(loc, product);
+    Reset();
+}
+
+/**
+ * Move the window back to the start, the products moved other than
+ * by the conveyor, like restoring a snapshot. The next Advance finds
+ * the window again.
+ */
+void ProductQueue::Reset()
+{
+    mHead = 0;
+    mTail = 0;
+    mLastPassed = false;
+}
+
+/**
+ * Move the window along after the products have moved
+ * @param beamY Y location of the beam
+ */
+void ProductQueue::Advance(double beamY)
+{
+    int count = (int)mProducts.size();
+    while (mHead < count && mProducts[mHead]->GetScoreAccountedFor())
+    {
+        if (mProducts[mHead]->IsLast())
+        {
+            mLastPassed = true;
+        }
+        mHead++;
+    }
+
+    while (mTail < count && mProducts[mTail]->GetY() >= beamY - BeamWindow)
+    {
+        mTail++;
+    }
+}
@@ -0,0 +1,86 @@
+/**
+ * @file ProductQueue.hpp
+ * @author Alex Mueller
+ *
+ * The products of a level in the order they reach the beam
+ */
+
+#ifndef PRODUCTQUEUE_HPP
+#define PRODUCTQUEUE_HPP
+
+#include <vector>
+
+class Product;
+
+/**
+ * The products in the order they reach the beam, with a window around it.
+ *
+ * Every product moves at the conveyor speed, so they reach the beam in
+ * the order they are placed on the conveyor. Products before the window
+ * have been scored and are finished. Products after it haven't reached
+ * the beam yet. Only the products in the window, usually one or two,
+ * have to be checked against the beam and the scoring line each update.
+ *
+ * The items own the products, the queue only points at them.
+ */
+class ProductQueue {
+public:
+    /// Distance before the beam a product starts breaking it
+    static constexpr double BeamWindow = 50;
+
+    void Clear();
+    void Add(Product *product);
+    void Reset();
+    void Advance(double beamY);
+
+    /// Iterator over the products
+    using Iterator = std::vector<Product *>::const_iterator;
+
+    /**
+     * First product in the window
+     * @return iterator
+     */
+    Iterator begin() const { return mProducts.begin() + mHead; }
+
+    /**
+     * One past the last product in the window
+     * @return iterator
+     */
+    Iterator end() const { return mProducts.begin() + (mTail > mHead ? mTail : mHead); }
+
+    /**
+     * The next product to reach the beam
+     * @return product or nullptr if every product has reached it
+     */
+    Product *GetNext() const { return mTail < (int)mProducts.size() ? mProducts[mTail] : nullptr; }
+
+    /**
+     * Has a last product been scored and left the window?
+     * @return true if it has
+     */
+    bool HasLastPassed() const { return mLastPassed; }
+
+    /**
+     * Number of products
+     * @return products
+     */
+    int GetCount() const { return (int)mProducts.size(); }
+
+    /**
+     * Number of products in the window
+     * @return products
+     */
+    int GetWindowSize() const { return (int)(end() - begin()); }
+
+private:
+    /// The products, in the order they reach the beam
+    std::vector<Product *> mProducts;
+    /// First product that hasn't been scored
+    int mHead = 0;
+    /// First product that hasn't reached the beam
+    int mTail = 0;
+    /// Has a last product left the window?
+    bool mLastPassed = false;
+};
+
+#endif // PRODUCTQUEUE_HPP
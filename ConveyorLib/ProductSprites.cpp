@@ -0,0 +1,111 @@
+/**
+ * @file ProductSprites.cpp
+ * @author Alex Mueller
+ */
+
+#include "pch.h"
+#include <cmath>
+#include <cstring>
+#include <wx/graphics.h>
+#include "ProductSprites.hpp"
+#include "DrawCommands.hpp"
+#include "GraphicsRenderer.hpp"
+#include "Product.h"
+
+/**
+ * Blit the products collected this frame and start collecting the next
+ * @param graphics Graphics context to draw on, in virtual pixels
+ * @param scale Scale from virtual pixels to the screen
+ */
+void ProductSprites::Draw(DrawCommands &graphics, double scale)
+{
+    if (scale != mScale)
+    {
+        mSprites.clear();
+        mScale = scale;
+    }
+
+    // Products on the same conveyor share a clip
+    bool clipped = false;
+    wxRect clip;
+    for (auto product : mProducts)
+    {
+        if (!clipped || product->GetClipRegion() != clip)
+        {
+            if (clipped)
+            {
+                graphics.PopState();
+            }
+
+            clip = product->GetClipRegion();
+            graphics.PushState();
+            if (clip.GetWidth() > 0)
+                graphics.Clip(clip.GetX(), clip.GetY(), clip.GetWidth(), clip.GetHeight());
+            clipped = true;
+        }
+
+        double x = product->GetX() - Product::SpriteMargin;
+        double y = product->GetY() - Product::SpriteMargin;
+        auto sprite = mUseSprites ? GetSprite(product, scale) : nullptr;
+        if (sprite != nullptr)
+        {
+            graphics.DrawBitmap(*sprite, x, y, sprite->GetWidth() / scale, sprite->GetHeight() / scale);
+        }
+        else
+        {
+            product->DrawShape(graphics, product->GetX(), product->GetY());
+        }
+    }
+
+    if (clipped)
+    {
+        graphics.PopState();
+    }
+
+    mProducts.clear();
+}
+
+/**
+ * Get the sprite for a product, rendering it the first time
+ * @param product Product to get the sprite for
+ * @param scale Scale from virtual pixels to the screen
+ * @return sprite, or nullptr if it can't be rendered
+ */
+const wxBitmap *ProductSprites::GetSprite(Product *product, double scale)
+{
+    int key = product->GetSpriteKey();
+    auto found = mSprites.find(key);
+    if (found != mSprites.end())
+    {
+        return &found->second;
+    }
+
+    int size = (int)std::ceil(Product::SpriteSize * scale);
+    if (size <= 0)
+    {
+        return nullptr;
+    }
+
+    wxImage image(size, size);
+    image.InitAlpha();
+    if (image.GetAlpha() == nullptr)
+    {
+        return nullptr;
+    }
+    memset(image.GetAlpha(), 0, size * size);
+
+    // The context writes back to the image when it is destroyed
+    std::shared_ptr<wxGraphicsContext> graphics(wxGraphicsContext::Create(image));
+    if (graphics == nullptr)
+    {
+        return nullptr;
+    }
+
+    DrawCommands shape;
+    shape.Scale(scale, scale);
+    product->DrawShape(shape, Product::SpriteMargin, Product::SpriteMargin);
+    GraphicsRenderer(graphics.get()).Render(shape);
+    graphics.reset();
+
+    return &(mSprites[key] = wxBitmap(image));
+}
@@ -0,0 +1,62 @@
+/**
+ * @file ProductSprites.hpp
+ * @author Alex Mueller
+ *
+ * The products drawn in a frame, blitted from sprites rendered once
+ */
+
+#ifndef PRODUCTSPRITES_HPP
+#define PRODUCTSPRITES_HPP
+
+#include <map>
+#include <memory>
+#include <vector>
+
+class DrawCommands;
+class Product;
+
+/**
+ * Collects the products as they draw and blits them at the end of the
+ * item drawing, each from a sprite of its shape, color and content.
+ *
+ * There are only a few combinations of shape, color and content, so each
+ * one is rendered once at the current scale and kept. The sprites are
+ * rendered again when the scale changes. The conveyor clip is set once
+ * for all the products on it instead of once per product.
+ */
+class ProductSprites {
+public:
+    /**
+     * Add a product to blit at the end of the item drawing
+     * @param product Product to draw
+     */
+    void Add(Product *product) { mProducts.push_back(product); }
+
+    void Draw(DrawCommands &graphics, double scale);
+
+    /**
+     * Set whether the products are blitted from sprites or drawn as shapes
+     * @param use True to use sprites
+     */
+    void SetUseSprites(bool use) { mUseSprites = use; }
+
+    /**
+     * Number of sprites rendered at the current scale
+     * @return sprites
+     */
+    int GetSpriteCount() const { return (int)mSprites.size(); }
+
+private:
+    const wxBitmap *GetSprite(Product *product, double scale);
+
+    /// Sprites by Product::GetSpriteKey
+    std::map<int, wxBitmap> mSprites;
+    /// Are the products blitted from sprites?
+    bool mUseSprites = true;
+    /// Scale the sprites were rendered at
+    double mScale = 0;
+    /// Products collected this frame
+    std::vector<Product *> mProducts;
+};
+
+#endif // PRODUCTSPRITES_HPP
@@ -54,6 +54,7 @@ public:
         {
             product->SetLocation((product->GetX() - (mElapsed * mKickSpeed)), (product->GetY()));
         }
+        product->RetireIfGone();
     }
 
 
@@ -0,0 +1,30 @@
+/**
+ * @file Renderer.hpp
+ * @author Alex Mueller
+ *
+ * Something that draws a recorded frame
+ */
+
+#ifndef RENDERER_HPP
+#define RENDERER_HPP
+
+class DrawCommands;
+
+/**
+ * Draws the commands recorded in a DrawCommands buffer.
+ *
+ * GraphicsRenderer draws them on a wxGraphicsContext for the window.
+ * SoftwareRenderer draws them into memory with no display at all.
+ */
+class Renderer {
+public:
+    virtual ~Renderer() = default;
+
+    /**
+     * Draw the commands, in order
+     * @param commands Recorded commands
+     */
+    virtual void Render(const DrawCommands &commands) = 0;
+};
+
+#endif // RENDERER_HPP
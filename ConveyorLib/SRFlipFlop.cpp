@@ -46,31 +46,25 @@ SRFlipFlop::SRFlipFlop(SpartyBoots *spartyBoots) : LogicGate(spartyBoots)
     auto h = SRFlipFlopSize.GetHeight(); // Height of the AND gate
 
     /// Creating a vector of pins and initializing them at the same time
-    mInputPins.push_back(std::make_shared<InputPin>(spartyBoots));
-    mInputPins.push_back(std::make_shared<InputPin>(spartyBoots));
-    mOutputPins.push_back(std::make_shared<OutputPin>(spartyBoots));
-    mOutputPins.push_back(std::make_shared<OutputPin>(spartyBoots));
+    AddInputPin();
+    AddInputPin();
+    AddOutputPin();
+    AddOutputPin();
 
     /// setting the pins location to be exactly where I drew them.
     mInputPins[0]->SetLocation(x - w / 2 - DefaultLineLength, y - h/4);
     mInputPins[1]->SetLocation(x - w / 2 - DefaultLineLength, y + h/4);
     mOutputPins[0]->SetLocation(x + w / 2 + DefaultLineLength, y - h/4);
     mOutputPins[1]->SetLocation(x + w / 2 + DefaultLineLength, y + h/4);
-
-    /// Adding the pins to spartyboots so that it recognizes it when hittesting
-    spartyBoots->Add(mInputPins[0]);
-    spartyBoots->Add(mOutputPins[0]);
-    spartyBoots->Add(mInputPins[1]);
-    spartyBoots->Add(mOutputPins[1]);
 }
 
 /**
  * Draw the SR flip-flop gate shape and labels.
  * @param graphics The device context to draw on
  */
-void SRFlipFlop::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void SRFlipFlop::Draw(DrawCommands &graphics)
 {
-    auto path = graphics->CreatePath();
+    auto path = graphics.CreatePath();
 
     auto x = GetX();
     auto y = GetY();
@@ -80,13 +74,13 @@ void SRFlipFlop::Draw(std::shared_ptr<wxGraphicsContext> graphics)
     // Draw the rectangular body of the flip-flop
     path.AddRectangle(x - w / 2, y - h / 2, w, h);
 
-    graphics->SetPen(*wxBLACK_PEN);
-    graphics->SetBrush(*wxWHITE_BRUSH);
-    graphics->DrawPath(path);
+    graphics.SetPen(*wxBLACK_PEN);
+    graphics.SetBrush(*wxWHITE_BRUSH);
+    graphics.DrawPath(path);
 
     // Draw labels "S", "R", "Q", and "Q'" inside the flip-flop
     wxFont font(15, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_BOLD, false, "Arial");
-    graphics->SetFont(font, *wxBLACK);
+    graphics.SetFont(font, *wxBLACK);
 
     /// setting the pins location to be exactly where I drew them.
     mInputPins[0]->SetLocation(x - w / 2 - DefaultLineLength, y - h/4);
@@ -100,10 +94,10 @@ void SRFlipFlop::Draw(std::shared_ptr<wxGraphicsContext> graphics)
     mOutputPins[1]->DrawPins(graphics, x + w / 2, y + h/4, x + w / 2 + DefaultLineLength, y + h/4);
 
 
-    graphics->DrawText("S", x - w / 2 + SRFlipFlopLabelMargin, y + h / 4 - 8);
-    graphics->DrawText("R", x - w / 2 + SRFlipFlopLabelMargin, y - h / 4 - 8);
-    graphics->DrawText("Q", x + w / 2 - SRFlipFlopLabelMargin - 15, y + h / 4 - 8);
-    graphics->DrawText("Q'", x + w / 2 - SRFlipFlopLabelMargin - 15, y - h / 4 - 8);
+    graphics.DrawText("S", x - w / 2 + SRFlipFlopLabelMargin, y + h / 4 - 8);
+    graphics.DrawText("R", x - w / 2 + SRFlipFlopLabelMargin, y - h / 4 - 8);
+    graphics.DrawText("Q", x + w / 2 - SRFlipFlopLabelMargin - 15, y + h / 4 - 8);
+    graphics.DrawText("Q'", x + w / 2 - SRFlipFlopLabelMargin - 15, y - h / 4 - 8);
 }
 
 /**
@@ -165,7 +159,7 @@ void SRFlipFlop::GateCompute()
     }
 }
 
-void SRFlipFlop::DrawPins(std::shared_ptr<wxGraphicsContext> graphics, int start_x, int start_y, int end_x, int end_y)
+void SRFlipFlop::DrawPins(DrawCommands &graphics, int start_x, int start_y, int end_x, int end_y)
 {
 
 }
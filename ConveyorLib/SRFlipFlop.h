@@ -24,14 +24,19 @@ private:
 public:
 
     SRFlipFlop(SpartyBoots *spartyBoots);
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void Draw(DrawCommands &graphics) override;
     bool HitTest(int x, int y)override;
-    void DrawPins(std::shared_ptr<wxGraphicsContext> graphics,
+    void DrawPins(DrawCommands &graphics,
                   int start_x,
                   int start_y,
                   int end_x,
                   int end_y) override;
     void GateCompute()override;
+    /**
+     * Get the kind of gate
+     * @return Kind::SR
+     */
+    Kind GetKind() const override { return Kind::SR; }
 };
 
 #endif //PROJECT1_CONVEYORLIB_SRFLIPFLOP_H
@@ -0,0 +1,39 @@
+/**
+ * @file ScaledBitmap.cpp
+ * @author Alex Mueller
+ */
+
+#include "pch.h"
+#include <cmath>
+#include "ScaledBitmap.hpp"
+#include "DrawCommands.hpp"
+
+/**
+ * Draw the image, resampling it first if its size on screen changed
+ * @param graphics Graphics context to draw on, in virtual pixels
+ * @param scale Scale from virtual pixels to the screen
+ * @param x X of the top left in virtual pixels
+ * @param y Y of the top left in virtual pixels
+ * @param width Width in virtual pixels
+ * @param height Height in virtual pixels
+ */
+void ScaledBitmap::Draw(DrawCommands &graphics, double scale, double x, double y, double width,
+                        double height)
+{
+    int pixelWidth = (int)std::lround(width * scale);
+    int pixelHeight = (int)std::lround(height * scale);
+    if (pixelWidth <= 0 || pixelHeight <= 0 || !mImage.IsOk())
+    {
+        return;
+    }
+
+    if (pixelWidth != mWidth || pixelHeight != mHeight)
+    {
+        mBitmap = wxBitmap(mImage.Scale(pixelWidth, pixelHeight, wxIMAGE_QUALITY_HIGH));
+        mWidth = pixelWidth;
+        mHeight = pixelHeight;
+    }
+
+    // Whole screen pixels, so the bitmap is copied one to one
+    graphics.DrawBitmap(mBitmap, x, y, mWidth / scale, mHeight / scale);
+}
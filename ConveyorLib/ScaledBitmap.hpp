@@ -0,0 +1,45 @@
+/**
+ * @file ScaledBitmap.hpp
+ * @author Alex Mueller
+ *
+ * An image kept resampled to the size it is drawn on screen
+ */
+
+#ifndef SCALEDBITMAP_HPP
+#define SCALEDBITMAP_HPP
+
+#include <memory>
+
+class DrawCommands;
+
+/**
+ * An image that is resampled once to the size it covers on screen.
+ *
+ * Drawing a full size image under the view scale makes the graphics
+ * context filter it on every frame. This keeps a bitmap of the image
+ * at its on screen size and only resamples it when that size changes,
+ * like when the window is resized, so each frame is a plain blit.
+ */
+class ScaledBitmap {
+public:
+    /**
+     * Constructor
+     * @param image Full size image to draw
+     */
+    ScaledBitmap(const wxImage &image) : mImage(image) {}
+
+    void Draw(DrawCommands &graphics, double scale, double x, double y, double width,
+              double height);
+
+private:
+    /// The full size image
+    wxImage mImage;
+    /// The image resampled to the size it was last drawn
+    wxBitmap mBitmap;
+    /// Width of mBitmap in screen pixels
+    int mWidth = 0;
+    /// Height of mBitmap in screen pixels
+    int mHeight = 0;
+};
+
+#endif // SCALEDBITMAP_HPP
@@ -4,6 +4,7 @@
  */
 #include "pch.h"
 #include "ScoreBoard.hpp"
+#include "Snapshot.hpp"
 
 /// Size of the scoreboard in virtual pixels
 const wxSize ScoreboardSize(380, 100);
@@ -45,7 +46,7 @@ ScoreBoard::ScoreBoard(SpartyBoots *spartyBoots, int x, int y, wxString level, i
  * drawing of scoreboard
  * @param graphics
  */
-void ScoreBoard::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void ScoreBoard::Draw(DrawCommands &graphics)
 {
     // Use the initialized location from the constructor (scoreboardX and scoreboardY)
     // auto x = 700;  // Get X coordinate
@@ -56,15 +57,14 @@ void ScoreBoard::Draw(std::shared_ptr<wxGraphicsContext> graphics)
     auto h = ScoreboardSize.GetHeight(); // Adjusted height for all text to fit comfortably
 
     // Set up the pen and brush for the scoreboard (customize as needed)
-    graphics->SetPen(*wxBLACK_PEN);
-    graphics->SetBrush(*wxWHITE_BRUSH);
+    graphics.SetPen(*wxBLACK_PEN);
+    graphics.SetBrush(*wxWHITE_BRUSH);
 
     // Draw the rectangle for the scoreboard
-    graphics->DrawRectangle(mX - w / 2, mY - h / 2, w, h);
+    graphics.DrawRectangle(mX - w / 2, mY - h / 2, w, h);
 
     // Set up the font for "Level" and "Game" (size 25)
-    auto font = graphics->CreateFont(25, L"Arial", wxFONTFLAG_BOLD, wxColour(24, 69, 59));
-    graphics->SetFont(font);
+    graphics.SetFont(25, L"Arial", wxFONTFLAG_BOLD, wxColour(24, 69, 59));
 
     // Draw the "Level" and "Game" information on separate lines
     wxString score = wxString::Format("%d", mScore);
@@ -72,18 +72,17 @@ void ScoreBoard::Draw(std::shared_ptr<wxGraphicsContext> graphics)
     wxString gameText = L"Game: " + score;    // Default game text
 
     // Position the larger text for "Level" and "Game"
-    graphics->DrawText(levelText, mX - w / 2 + 10, mY - h / 2 + 10);                        // Top-left, for "Level"
-    graphics->DrawText(gameText, mX + w / 2 - gameText.length() * 15 - 5, mY - h / 2 + 10); // Top-right, for "Game"
+    graphics.DrawText(levelText, mX - w / 2 + 10, mY - h / 2 + 10);                        // Top-left, for "Level"
+    graphics.DrawText(gameText, mX + w / 2 - gameText.length() * 15 - 5, mY - h / 2 + 10); // Top-right, for "Game"
 
     // Set up a smaller font for the instructions (size 15)
-    font = graphics->CreateFont(15, L"Arial", wxFONTFLAG_BOLD, *wxBLACK);
-    graphics->SetFont(font);
+    graphics.SetFont(15, L"Arial", wxFONTFLAG_BOLD, *wxBLACK);
 
     // Instruction text below "Level" and "Game"
     wxString instructions = mInstructions; // Instruction text
 
     // Position the instructions text
-    graphics->DrawText(instructions, mX - w / 2 + 10, mY - h / 2 + SpacingScoresToInstructions); // Centered, multi-line instructions
+    graphics.DrawText(instructions, mX - w / 2 + 10, mY - h / 2 + SpacingScoresToInstructions); // Centered, multi-line instructions
 }
 
 /**
@@ -97,3 +96,23 @@ bool ScoreBoard::HitTest(int x, int y)
     // do we even need a hit test on this class since it needs no click interaction?
     return false;
 }
+
+/**
+ * Save the state that changes as the game runs
+ * @param writer Snapshot to write to
+ */
+void ScoreBoard::SaveState(SnapshotWriter &writer)
+{
+    Item::SaveState(writer);
+    writer.Write(mScore);
+}
+
+/**
+ * Restore the state saved by SaveState
+ * @param reader Snapshot to read from
+ */
+void ScoreBoard::LoadState(SnapshotReader &reader)
+{
+    Item::LoadState(reader);
+    reader.Read(mScore);
+}
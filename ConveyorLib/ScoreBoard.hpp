@@ -32,8 +32,10 @@ private:
 public:
     ScoreBoard(SpartyBoots *spartyBoots, int x, int y, wxString level, int good, int bad, wxString instructions);
 
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void Draw(DrawCommands &graphics) override;
     bool HitTest(int x, int y) override;
+    void SaveState(SnapshotWriter &writer) override;
+    void LoadState(SnapshotReader &reader) override;
     /**
      * Accept a visitor
      * @param visitor The visitor to accept
@@ -58,6 +60,14 @@ public:
     {
         return mBad;
     };
+    /**
+     * The score so far
+     * @return score
+     */
+    int GetScore() const
+    {
+        return mScore;
+    }
     /**
      * Updates the score on the scoreboard
      * @param good
@@ -6,6 +6,7 @@
 #include "pch.h"
 #include "Sensor.h"
 #include "SpartyBoots.hpp"
+#include "Product.h"
 
 /// The image file for the sensor cable
 const std::wstring SensorCableImage = L"sensor-cable.png";
@@ -96,7 +97,7 @@ static const int DefaultLineLength = 20;
  * @param y
  * @param children
  */
-Sensor::Sensor(SpartyBoots *spartyBoots, int x, int y, std::vector<wxString> children): LogicItem(spartyBoots),
+Sensor::Sensor(SpartyBoots *spartyBoots, int x, int y, std::vector<wxString> children): PinOwner(spartyBoots),
     mSensorCableImage(L"images/" + SensorCableImage, wxBITMAP_TYPE_ANY), mSensorCableBitmap(mSensorCableImage),
     mSensorCameraImage(L"images/" + SensorCameraImage, wxBITMAP_TYPE_ANY), mSensorCameraBitmap(mSensorCameraImage),
     mWolverineImage(L"images/" + WolverineImage, wxBITMAP_TYPE_ANY), mWolverineBitmap(mWolverineImage),
@@ -116,8 +117,7 @@ Sensor::Sensor(SpartyBoots *spartyBoots, int x, int y, std::vector<wxString> chi
     for(auto child : mChildren)
     {
         /// Creating a vector of pins and initializing them at the same time
-        mOutputPins.push_back(std::make_shared<OutputPin>(spartyBoots));
-        spartyBoots->Add(mOutputPins[index]);
+        AddOutputPin();
         // Increment index for the next iteration
         ++index;
     }
@@ -128,12 +128,13 @@ Sensor::Sensor(SpartyBoots *spartyBoots, int x, int y, std::vector<wxString> chi
  * Draw Sensor.
  * @param graphics
  */
-void Sensor::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void Sensor::Draw(DrawCommands &graphics)
 {
+    double scale = GetSpartyBoots()->getScale();
 
 
-    graphics->DrawBitmap(mSensorCableBitmap, mX - CableWidth/2 - 10, mY - CableHeight/2, CableWidth, CableHeight);
-    graphics->DrawBitmap(mSensorCameraBitmap, mX - CableWidth/2 - 10, mY - CameraHeight/2, CableWidth, CameraHeight);
+    mSensorCableBitmap.Draw(graphics, scale, mX - CableWidth/2 - 10, mY - CableHeight/2, CableWidth, CableHeight);
+    mSensorCameraBitmap.Draw(graphics, scale, mX - CableWidth/2 - 10, mY - CameraHeight/2, CableWidth, CameraHeight);
 
     int offsetY = PanelRectOffsetY;
 
@@ -141,56 +142,56 @@ void Sensor::Draw(std::shared_ptr<wxGraphicsContext> graphics)
     for(auto child : mChildren)
     {
         wxPen panelPen(*wxBLACK, 2);
-        graphics->SetPen(panelPen);
-        if (child == L"red"){graphics->SetBrush(OhioStateRed);}
-        else if (child == L"green"){graphics->SetBrush(MSUGreen);}
-        else if (child == L"blue"){graphics->SetBrush(UofMBlue);}
-        else if (child == L"white"){graphics->SetBrush(*wxWHITE);}
+        graphics.SetPen(panelPen);
+        if (child == L"red"){graphics.SetBrush(OhioStateRed);}
+        else if (child == L"green"){graphics.SetBrush(MSUGreen);}
+        else if (child == L"blue"){graphics.SetBrush(UofMBlue);}
+        else if (child == L"white"){graphics.SetBrush(*wxWHITE);}
         else
         {
-            graphics->SetBrush(PanelBackgroundColor);
+            graphics.SetBrush(PanelBackgroundColor);
         }
-        graphics->DrawRectangle(mX - CableWidth/2 - 10 + CableWidth, mY + PanelOffsetY + offsetY, PropertySize.x, PropertySize.y);
+        graphics.DrawRectangle(mX - CableWidth/2 - 10 + CableWidth, mY + PanelOffsetY + offsetY, PropertySize.x, PropertySize.y);
         ///This little part is for setting location and drawing output pins
         mOutputPins[index]->SetLocation(mX - CableWidth/2 - 10 + CableWidth + PropertySize.x + DefaultLineLength, mY + PanelOffsetY + offsetY + PropertySize.y/2);
         mOutputPins[index]->DrawPins(graphics, mX - CableWidth/2 - 10 + CableWidth + PropertySize.x, mY + PanelOffsetY + offsetY + PropertySize.y/2, mX - CableWidth/2 - 10 + CableWidth + PropertySize.x + DefaultLineLength, mY + PanelOffsetY + offsetY + PropertySize.y/2);
         mOutputPins[index]->setConnect(true);
         if (child == L"basketball")
         {
-            graphics->DrawBitmap(mBasketballBitmap, mX + CableWidth/2 + (PropertySize.x/4) - 10, mY + PanelOffsetY + offsetY, PropertySize.x/2, PropertySize.y);
+            mBasketballBitmap.Draw(graphics, scale, mX + CableWidth/2 + (PropertySize.x/4) - 10, mY + PanelOffsetY + offsetY, PropertySize.x/2, PropertySize.y);
         }
         if (child == L"football")
         {
-            graphics->DrawBitmap(mFootballBitmap,mX + CableWidth/2 + (PropertySize.x/4) - 10, mY + PanelOffsetY + offsetY, PropertySize.x/2, PropertySize.y);
+            mFootballBitmap.Draw(graphics, scale, mX + CableWidth/2 + (PropertySize.x/4) - 10, mY + PanelOffsetY + offsetY, PropertySize.x/2, PropertySize.y);
         }
         if (child == L"izzo")
         {
-            graphics->DrawBitmap(mIzzoBitmap, mX + CableWidth/2 + (PropertySize.x/4) - 10, mY + PanelOffsetY + offsetY, PropertySize.x/2, PropertySize.y);
+            mIzzoBitmap.Draw(graphics, scale, mX + CableWidth/2 + (PropertySize.x/4) - 10, mY + PanelOffsetY + offsetY, PropertySize.x/2, PropertySize.y);
         }
         if (child == L"smith")
         {
-            graphics->DrawBitmap(mSmithBitmap, mX + CableWidth/2 + (PropertySize.x/4) - 10, mY + PanelOffsetY + offsetY, PropertySize.x/2, PropertySize.y);
+            mSmithBitmap.Draw(graphics, scale, mX + CableWidth/2 + (PropertySize.x/4) - 10, mY + PanelOffsetY + offsetY, PropertySize.x/2, PropertySize.y);
         }
         if (child == L"wolverine")
         {
-            graphics->DrawBitmap(mWolverineBitmap, mX + CableWidth/2 + (PropertySize.x/4) - 10, mY + PanelOffsetY + offsetY, PropertySize.x/2, PropertySize.y);
+            mWolverineBitmap.Draw(graphics, scale, mX + CableWidth/2 + (PropertySize.x/4) - 10, mY + PanelOffsetY + offsetY, PropertySize.x/2, PropertySize.y);
         }
         if (child == L"square")
         {
-            graphics->SetBrush(*wxWHITE);
-            graphics->DrawRectangle( mX + CableWidth/2 + (PropertySize.x/4) - 10 + (PropertySize.x/8), mY + PanelOffsetY + offsetY + (PropertySize.x/16), PropertySize.x/4,PropertySize.x/4);
+            graphics.SetBrush(*wxWHITE);
+            graphics.DrawRectangle( mX + CableWidth/2 + (PropertySize.x/4) - 10 + (PropertySize.x/8), mY + PanelOffsetY + offsetY + (PropertySize.x/16), PropertySize.x/4,PropertySize.x/4);
         }
         if (child == L"circle")
         {
-            graphics->SetBrush(*wxWHITE);
-            graphics->DrawEllipse(mX + CableWidth/2 + (PropertySize.x/4) - 10 + (PropertySize.x/8), mY + PanelOffsetY + offsetY + (PropertySize.x/16),  PropertySize.x/4,PropertySize.x/4);
+            graphics.SetBrush(*wxWHITE);
+            graphics.DrawEllipse(mX + CableWidth/2 + (PropertySize.x/4) - 10 + (PropertySize.x/8), mY + PanelOffsetY + offsetY + (PropertySize.x/16),  PropertySize.x/4,PropertySize.x/4);
         }
         if (child == L"diamond")
         {
-            graphics->SetBrush(*wxWHITE);
-            graphics->Translate(GetX() + 25, GetY() + 25);  // Move to the center of the rectangle
-            graphics->Rotate(wxDegToRad(45));  // Rotate 45 degrees
-            graphics->DrawRectangle(mX + CableWidth/2 + (PropertySize.x/4) - 10 + (PropertySize.x/8), mY + PanelOffsetY + offsetY + (PropertySize.x/16), PropertySize.x/4,PropertySize.x/4);
+            graphics.SetBrush(*wxWHITE);
+            graphics.Translate(GetX() + 25, GetY() + 25);  // Move to the center of the rectangle
+            graphics.Rotate(wxDegToRad(45));  // Rotate 45 degrees
+            graphics.DrawRectangle(mX + CableWidth/2 + (PropertySize.x/4) - 10 + (PropertySize.x/8), mY + PanelOffsetY + offsetY + (PropertySize.x/16), PropertySize.x/4,PropertySize.x/4);
         }
         index++;
         offsetY += PropertySize.y;
@@ -199,11 +200,11 @@ void Sensor::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 
 /**
  * activate pins based on product info
- * @param productContent product info
+ * @param product product in the beam
  */
-void Sensor::ActivatePins(std::vector<wxString> productContent)
+void Sensor::ActivatePins(const Product *product)
 {
-    for (auto& property : productContent)
+    for (const wxString &property : product->GetProperties())
     {
         auto it = std::find(mChildren.begin(), mChildren.end(), property);
         if (it != mChildren.end())
@@ -7,17 +7,20 @@
 
 #ifndef SENSOR_H
 #define SENSOR_H
-#include "LogicItem.hpp"
+#include "PinOwner.hpp"
+#include "ScaledBitmap.hpp"
 #include "OutputPin.h"
 
+class Product;
+
 /**
  * Sensor Class
  */
-class Sensor : public LogicItem {
+class Sensor : public PinOwner {
 
 public:
     Sensor(SpartyBoots *spartyBoots, int x, int y, std::vector<wxString>);
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void Draw(DrawCommands &graphics) override;
     bool HitTest(int x, int y) override
     {
         return false;
@@ -28,23 +31,23 @@ public:
      */
     void Accept(ItemVisitor& visitor) override { visitor.VisitSensor(this); }
 
-    void ActivatePins(std::vector<wxString> productContent);
+    void ActivatePins(const Product *product);
    /**
     * function for drawing pins
-    * @param graphics Shared pointer to the `wxGraphicsContext` used for drawing.
+    * @param graphics The command buffer used for drawing.
     * @param start_x The x-coordinate of the starting point of the pin.
     * @param start_y The y-coordinate of the starting point of the pin.
     * @param end_x The x-coordinate of the ending point of the pin.
     * @param end_y The y-coordinate of the ending point of the pin.
     */
-    void DrawPins(std::shared_ptr<wxGraphicsContext> graphics, int start_x, int start_y, int end_x, int end_y)override {};
+    void DrawPins(DrawCommands &graphics, int start_x, int start_y, int end_x, int end_y)override {};
 
     void ResetPins();
     /**
      * getter for output pins
      * @return mOutputPins
      */
-    std::vector<std::shared_ptr<OutputPin>> getPins() {return mOutputPins;}
+    const std::vector<std::shared_ptr<OutputPin>> &getPins() const {return mOutputPins;}
 
 private:
     /// X location of sensor
@@ -52,9 +55,6 @@ private:
     /// Y location of sensor
     int mY;
 
-    /// vector containing output pins
-    std::vector<std::shared_ptr<OutputPin>> mOutputPins;
-
     /// Children of sensor
     std::vector<wxString> mChildren;
 
@@ -62,43 +62,43 @@ private:
     wxImage mSensorCableImage;
 
     /// The bitmap for sparty background.
-    wxBitmap mSensorCableBitmap;
+    ScaledBitmap mSensorCableBitmap;
 
     /// The Image for the Sparty boot.
     wxImage mSensorCameraImage;
 
     /// The bitmap for Sparty boot.
-    wxBitmap mSensorCameraBitmap;
+    ScaledBitmap mSensorCameraBitmap;
 
     /// The Image for the Sparty boot.
     wxImage mBasketballImage;
 
     /// The bitmap for Sparty boot.
-    wxBitmap mBasketballBitmap;
+    ScaledBitmap mBasketballBitmap;
 
     /// The Image for the Sparty boot.
     wxImage mFootballImage;
 
     /// The bitmap for Sparty boot.
-    wxBitmap mFootballBitmap;
+    ScaledBitmap mFootballBitmap;
 
     /// The Image for the Sparty boot.
     wxImage mIzzoImage;
 
     /// The bitmap for Sparty boot.
-    wxBitmap mIzzoBitmap;
+    ScaledBitmap mIzzoBitmap;
 
     /// The Image for the Sparty boot.
     wxImage mSmithImage;
 
     /// The bitmap for Sparty boot.
-    wxBitmap mSmithBitmap;
+    ScaledBitmap mSmithBitmap;
 
     /// The Image for the Sparty boot.
     wxImage mWolverineImage;
 
     /// The bitmap for Sparty boot.
-    wxBitmap mWolverineBitmap;
+    ScaledBitmap mWolverineBitmap;
 };
 
 #endif // SENSOR_H
@@ -0,0 +1,306 @@
+/**
+ * @file Snapshot.cpp
+ * @author Alex Mueller
+ */
+
+#include "pch.h"
+#include "Snapshot.hpp"
+
+using namespace std;
+
+/**
+ * Append a variable length unsigned value, 7 bits per byte
+ * @param out Buffer to append to
+ * @param value Value to append
+ */
+static void WriteVarint(vector<uint8_t> &out, size_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(uint8_t(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(uint8_t(value));
+}
+
+/**
+ * Read a variable length unsigned value
+ * @param in Buffer to read from
+ * @param position Position to read at, advanced past the value
+ * @param value Value read
+ * @return false if the buffer ends first
+ */
+static bool ReadVarint(const vector<uint8_t> &in, size_t &position, size_t &value)
+{
+    value = 0;
+    for (int shift = 0; position < in.size() && shift < 64; shift += 7)
+    {
+        auto byte = in[position++];
+        value |= size_t(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Constructor
+ * @param capacity Maximum number of snapshots kept
+ */
+SnapshotRing::SnapshotRing(int capacity) : mCapacity(capacity < 1 ? 1 : capacity), mEntries(mCapacity) {}
+
+/**
+ * Add a snapshot, dropping the oldest if the ring is full
+ * @param tick Tick the snapshot was taken on
+ * @param snapshot The snapshot
+ */
+void SnapshotRing::Add(long tick, const std::vector<uint8_t> &snapshot)
+{
+    if (snapshot.size() > mReserved)
+    {
+        Reserve(snapshot.size());
+    }
+
+    if (mCount == mCapacity)
+    {
+        // The new oldest entry must be whole, so fold the keyframe into it
+        if (mCount > 1 && !At(1).mKeyframe)
+        {
+            ApplyDelta(At(1).mData, At(0).mData);
+            At(1).mData.swap(At(0).mData);
+            At(1).mKeyframe = true;
+        }
+        mFirst = (mFirst + 1) % mCapacity;
+        mCount--;
+    }
+
+    auto &entry = At(mCount);
+    entry.mTick = tick;
+
+    // A change in size means the items changed, so deltas are meaningless
+    if (mCount == 0 || snapshot.size() != mNewest.size() || mSinceKeyframe + 1 >= KeyframeInterval)
+    {
+        entry.mKeyframe = true;
+        entry.mData.assign(snapshot.begin(), snapshot.end());
+        mSinceKeyframe = 0;
+    }
+    else
+    {
+        // Encoded apart so the entry grows at most once, to its final size
+        mDelta.clear();
+        EncodeDelta(mNewest, snapshot, mDelta);
+        entry.mKeyframe = false;
+        entry.mData.assign(mDelta.begin(), mDelta.end());
+        mSinceKeyframe++;
+    }
+    mCount++;
+    mNewest = snapshot;
+}
+
+/**
+ * Make room in every entry for a snapshot of a size, whole or encoded
+ * @param size Snapshot size in bytes
+ */
+void SnapshotRing::Reserve(size_t size)
+{
+    size_t encoded = MaxEncodedSize(size);
+    for (auto &entry : mEntries)
+    {
+        entry.mData.reserve(encoded);
+    }
+    mDelta.reserve(encoded);
+    mNewest.reserve(size);
+    mReserved = size;
+}
+
+/**
+ * Decode a stored snapshot
+ * @param index Snapshot index, 0 is the oldest
+ * @param snapshot The decoded snapshot
+ * @return false if there is no such snapshot
+ */
+bool SnapshotRing::Get(int index, std::vector<uint8_t> &snapshot) const
+{
+    if (index < 0 || index >= mCount)
+    {
+        return false;
+    }
+
+    int keyframe = index;
+    while (!At(keyframe).mKeyframe)
+    {
+        keyframe--;
+    }
+
+    snapshot = At(keyframe).mData;
+    for (int i = keyframe + 1; i <= index; i++)
+    {
+        if (!ApplyDelta(At(i).mData, snapshot))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Drop all but the oldest snapshots, used after rewinding
+ * @param count Number of snapshots to keep
+ */
+void SnapshotRing::Truncate(int count)
+{
+    if (count <= 0)
+    {
+        Clear();
+        return;
+    }
+    if (count >= mCount)
+    {
+        return;
+    }
+
+    // The dropped entries keep their memory for the next snapshots
+    mCount = count;
+    Get(count - 1, mNewest);
+
+    mSinceKeyframe = 0;
+    for (int i = count - 1; !At(i).mKeyframe; i--)
+    {
+        mSinceKeyframe++;
+    }
+}
+
+/**
+ * Drop all snapshots
+ */
+void SnapshotRing::Clear()
+{
+    mFirst = 0;
+    mCount = 0;
+    mNewest.clear();
+    mSinceKeyframe = 0;
+}
+
+/**
+ * Find the newest snapshot taken at or before a tick
+ * @param tick Tick to look for
+ * @return snapshot index or -1 if every snapshot is newer
+ */
+int SnapshotRing::FindAtOrBefore(long tick) const
+{
+    for (int i = mCount - 1; i >= 0; i--)
+    {
+        if (At(i).mTick <= tick)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Memory used by the stored snapshots
+ * @return bytes
+ */
+size_t SnapshotRing::GetEncodedSize() const
+{
+    size_t size = 0;
+    for (int i = 0; i < mCount; i++)
+    {
+        size += At(i).mData.size();
+    }
+    return size;
+}
+
+/**
+ * Largest a snapshot can be stored as, whole or as a delta. A run of
+ * literals after the first follows at least two unchanged bytes, which
+ * pay for its counts unless the run is long, so a delta is at most a
+ * little bigger than the snapshot.
+ * @param size Snapshot size in bytes
+ * @return bytes
+ */
+size_t SnapshotRing::MaxEncodedSize(size_t size)
+{
+    return size + size / 64 + 32;
+}
+
+/**
+ * Encode a snapshot as the difference from the previous one.
+ * The delta is a list of (zero run, literal count, literal bytes)
+ * where the literals are the XOR of the two snapshots.
+ * @param previous Previous snapshot
+ * @param current Snapshot to encode, same size as previous
+ * @param delta Encoded delta
+ */
+void SnapshotRing::EncodeDelta(const std::vector<uint8_t> &previous, const std::vector<uint8_t> &current,
+                               std::vector<uint8_t> &delta)
+{
+    size_t i = 0;
+    size_t size = current.size();
+    while (i < size)
+    {
+        size_t zeros = 0;
+        while (i + zeros < size && previous[i + zeros] == current[i + zeros])
+        {
+            zeros++;
+        }
+        i += zeros;
+        if (i == size)
+        {
+            // Trailing zeros are implied
+            break;
+        }
+
+        // Literals run until at least two unchanged bytes in a row
+        size_t literals = 0;
+        while (i + literals < size &&
+               (previous[i + literals] != current[i + literals] ||
+                (i + literals + 1 < size && previous[i + literals + 1] != current[i + literals + 1])))
+        {
+            literals++;
+        }
+
+        WriteVarint(delta, zeros);
+        WriteVarint(delta, literals);
+        for (size_t j = 0; j < literals; j++)
+        {
+            delta.push_back(previous[i + j] ^ current[i + j]);
+        }
+        i += literals;
+    }
+}
+
+/**
+ * Apply a delta from EncodeDelta to the previous snapshot
+ * @param delta Encoded delta
+ * @param snapshot Previous snapshot, becomes the next one
+ * @return false if the delta is corrupt
+ */
+bool SnapshotRing::ApplyDelta(const std::vector<uint8_t> &delta, std::vector<uint8_t> &snapshot)
+{
+    size_t position = 0;
+    size_t i = 0;
+    while (position < delta.size())
+    {
+        size_t zeros, literals;
+        if (!ReadVarint(delta, position, zeros) || !ReadVarint(delta, position, literals))
+        {
+            return false;
+        }
+        i += zeros;
+        if (i + literals > snapshot.size() || position + literals > delta.size())
+        {
+            return false;
+        }
+        for (size_t j = 0; j < literals; j++)
+        {
+            snapshot[i + j] ^= delta[position + j];
+        }
+        i += literals;
+        position += literals;
+    }
+    return true;
+}
@@ -0,0 +1,186 @@
+/**
+ * @file Snapshot.hpp
+ * @author Alex Mueller
+ *
+ * Compact binary snapshots of the simulation state and a
+ * ring buffer of them for rewinding.
+ */
+
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Appends plain values to a snapshot
+ */
+class SnapshotWriter {
+public:
+    /**
+     * Append a value
+     * @param value Value to write, must be trivially copyable
+     */
+    template <class T>
+    void Write(const T &value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshots hold plain values only");
+        auto bytes = reinterpret_cast<const uint8_t *>(&value);
+        mBytes.insert(mBytes.end(), bytes, bytes + sizeof(T));
+    }
+
+    /**
+     * Get the snapshot written so far
+     * @return snapshot bytes
+     */
+    std::vector<uint8_t> &GetBytes() { return mBytes; }
+
+    /**
+     * Start a new snapshot, keeping the memory of the last one
+     */
+    void Clear() { mBytes.clear(); }
+
+private:
+    /// Snapshot bytes
+    std::vector<uint8_t> mBytes;
+};
+
+/**
+ * Reads values back in the order they were written
+ */
+class SnapshotReader {
+public:
+    /**
+     * Constructor
+     * @param bytes Snapshot to read, must outlive the reader
+     */
+    explicit SnapshotReader(const std::vector<uint8_t> &bytes) : mBytes(bytes) {}
+
+    /**
+     * Read a value, leaving it unchanged if the snapshot is too short
+     * @param value Value to read into
+     */
+    template <class T>
+    void Read(T &value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshots hold plain values only");
+        if (mPosition + sizeof(T) > mBytes.size())
+        {
+            mFailed = true;
+            return;
+        }
+        memcpy(&value, mBytes.data() + mPosition, sizeof(T));
+        mPosition += sizeof(T);
+    }
+
+    /**
+     * Did every read succeed?
+     * @return true if no read ran past the end
+     */
+    bool IsOk() const { return !mFailed; }
+
+private:
+    /// Snapshot being read
+    const std::vector<uint8_t> &mBytes;
+    /// Next byte to read
+    size_t mPosition = 0;
+    /// Set when a read runs past the end
+    bool mFailed = false;
+};
+
+/**
+ * Fixed size history of snapshots.
+ *
+ * Every KeyframeInterval-th snapshot is stored whole. The ones in
+ * between are stored as the XOR with the previous snapshot, run
+ * length encoded, which is mostly zeros since only the moving parts
+ * of the game change between snapshots.
+ *
+ * The entries are allocated once, when the ring is made. The first
+ * snapshot of a new largest size reserves room for it in every entry,
+ * so after that adding a snapshot, or reusing the oldest entry for the
+ * newest when the ring is full, doesn't allocate.
+ */
+class SnapshotRing {
+public:
+    /// Default number of snapshots kept
+    static const int DefaultCapacity = 512;
+
+    /// A whole snapshot is stored once every this many snapshots
+    static const int KeyframeInterval = 16;
+
+    explicit SnapshotRing(int capacity = DefaultCapacity);
+
+    void Add(long tick, const std::vector<uint8_t> &snapshot);
+    bool Get(int index, std::vector<uint8_t> &snapshot) const;
+    void Truncate(int count);
+    void Clear();
+    int FindAtOrBefore(long tick) const;
+    size_t GetEncodedSize() const;
+
+    /**
+     * Number of snapshots held
+     * @return count
+     */
+    int GetCount() const { return mCount; }
+
+    /**
+     * Tick a snapshot was taken on
+     * @param index Snapshot index, 0 is the oldest
+     * @return tick
+     */
+    long GetTick(int index) const { return At(index).mTick; }
+
+private:
+    /// One stored snapshot
+    struct Entry
+    {
+        /// Tick the snapshot was taken on
+        long mTick;
+        /// Is mData the whole snapshot rather than a delta?
+        bool mKeyframe;
+        /// Snapshot or encoded delta from the previous snapshot
+        std::vector<uint8_t> mData;
+    };
+
+    /**
+     * Get a stored snapshot
+     * @param index Snapshot index, 0 is the oldest
+     * @return entry
+     */
+    Entry &At(int index) { return mEntries[(mFirst + index) % mCapacity]; }
+
+    /**
+     * Get a stored snapshot
+     * @param index Snapshot index, 0 is the oldest
+     * @return entry
+     */
+    const Entry &At(int index) const { return mEntries[(mFirst + index) % mCapacity]; }
+
+    static size_t MaxEncodedSize(size_t size);
+    void Reserve(size_t size);
+    static void EncodeDelta(const std::vector<uint8_t> &previous, const std::vector<uint8_t> &current,
+                            std::vector<uint8_t> &delta);
+    static bool ApplyDelta(const std::vector<uint8_t> &delta, std::vector<uint8_t> &snapshot);
+
+    /// Maximum number of snapshots
+    int mCapacity;
+    /// Ring of mCapacity entries, the snapshots start at mFirst with a keyframe
+    std::vector<Entry> mEntries;
+    /// Entry holding the oldest snapshot
+    int mFirst = 0;
+    /// Number of snapshots held
+    int mCount = 0;
+    /// The newest snapshot, decoded, to encode the next delta against
+    std::vector<uint8_t> mNewest;
+    /// Snapshots added since the last keyframe
+    int mSinceKeyframe = 0;
+    /// Delta being encoded, kept so its memory is reused
+    std::vector<uint8_t> mDelta;
+    /// Largest snapshot every entry has room for
+    size_t mReserved = 0;
+};
+
+#endif // SNAPSHOT_HPP
@@ -0,0 +1,543 @@
+/**
+ * @file SoftwareRenderer.cpp
+ * @author Alex Mueller
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "SoftwareRenderer.hpp"
+
+/// Line segments an ellipse is drawn with
+const int EllipseSegments = 64;
+
+/// Line segments a Bezier curve is drawn with
+const int CurveSegments = 16;
+
+/**
+ * Constructor
+ * @param width Width of the buffer in pixels
+ * @param height Height of the buffer in pixels
+ */
+SoftwareRenderer::SoftwareRenderer(int width, int height)
+    : mWidth(std::max(width, 0)), mHeight(std::max(height, 0)), mPixels(mWidth * mHeight * 4, 0)
+{
+    mState.mClipLeft = 0;
+    mState.mClipTop = 0;
+    mState.mClipRight = mWidth;
+    mState.mClipBottom = mHeight;
+}
+
+/**
+ * Fill the whole buffer with a color
+ * @param colour Color to fill with
+ */
+void SoftwareRenderer::Clear(const wxColour &colour)
+{
+    for (size_t i = 0; i < mPixels.size(); i += 4)
+    {
+        mPixels[i] = colour.Red();
+        mPixels[i + 1] = colour.Green();
+        mPixels[i + 2] = colour.Blue();
+        mPixels[i + 3] = colour.Alpha();
+    }
+}
+
+/**
+ * Get the color of a pixel
+ * @param x X of the pixel
+ * @param y Y of the pixel
+ * @return color, transparent black outside the buffer
+ */
+wxColour SoftwareRenderer::GetPixel(int x, int y) const
+{
+    if (x < 0 || y < 0 || x >= mWidth || y >= mHeight)
+    {
+        return wxColour(0, 0, 0, 0);
+    }
+
+    auto pixel = &mPixels[(y * mWidth + x) * 4];
+    return wxColour(pixel[0], pixel[1], pixel[2], pixel[3]);
+}
+
+/**
+ * Copy the buffer into an image, for saving
+ * @return image with an alpha channel
+ */
+wxImage SoftwareRenderer::ToImage() const
+{
+    wxImage image(mWidth, mHeight, false);
+    image.InitAlpha();
+
+    unsigned char *rgb = image.GetData();
+    unsigned char *alpha = image.GetAlpha();
+    if (rgb != nullptr && alpha != nullptr)
+    {
+        for (int i = 0; i < mWidth * mHeight; i++)
+        {
+            rgb[i * 3] = mPixels[i * 4];
+            rgb[i * 3 + 1] = mPixels[i * 4 + 1];
+            rgb[i * 3 + 2] = mPixels[i * 4 + 2];
+            alpha[i] = mPixels[i * 4 + 3];
+        }
+    }
+
+    return image;
+}
+
+/**
+ * Draw the recorded commands into the buffer
+ * @param commands Recorded commands
+ */
+void SoftwareRenderer::Render(const DrawCommands &commands)
+{
+    using Op = DrawCommands::Op;
+
+    std::vector<Contour> contours;
+    for (auto &command : commands.GetCommands())
+    {
+        auto &transform = mState.mTransform;
+        contours.clear();
+
+        switch (command.mOp)
+        {
+        case Op::PushState:
+            mStates.push_back(mState);
+            break;
+
+        case Op::PopState:
+            if (!mStates.empty())
+            {
+                mState = mStates.back();
+                mStates.pop_back();
+            }
+            break;
+
+        case Op::Translate:
+            transform.mTx += transform.mA * command.mA + transform.mC * command.mB;
+            transform.mTy += transform.mB * command.mA + transform.mD * command.mB;
+            break;
+
+        case Op::Scale:
+            transform.mA *= command.mA;
+            transform.mB *= command.mA;
+            transform.mC *= command.mB;
+            transform.mD *= command.mB;
+            break;
+
+        case Op::Rotate:
+        {
+            double c = std::cos(command.mA);
+            double s = std::sin(command.mA);
+            Transform rotated = transform;
+            rotated.mA = transform.mA * c + transform.mC * s;
+            rotated.mB = transform.mB * c + transform.mD * s;
+            rotated.mC = transform.mC * c - transform.mA * s;
+            rotated.mD = transform.mD * c - transform.mB * s;
+            transform = rotated;
+            break;
+        }
+
+        case Op::Clip:
+        {
+            // Clip to the box around the rectangle, pixels whose center is inside
+            AddRectangle(contours, command.mA, command.mB, command.mC, command.mD);
+            double left = mWidth, top = mHeight, right = 0, bottom = 0;
+            for (auto &point : contours[0].mPoints)
+            {
+                left = std::min(left, point.m_x);
+                top = std::min(top, point.m_y);
+                right = std::max(right, point.m_x);
+                bottom = std::max(bottom, point.m_y);
+            }
+            mState.mClipLeft = std::max(mState.mClipLeft, (int)std::ceil(left - 0.5));
+            mState.mClipTop = std::max(mState.mClipTop, (int)std::ceil(top - 0.5));
+            mState.mClipRight = std::min(mState.mClipRight, (int)std::ceil(right - 0.5));
+            mState.mClipBottom = std::min(mState.mClipBottom, (int)std::ceil(bottom - 0.5));
+            break;
+        }
+
+        case Op::SetPen:
+        {
+            auto &pen = commands.GetPen(command.mIndex);
+            mState.mPenVisible = pen.IsOk() && !pen.IsTransparent();
+            mState.mPenColour = pen.GetColour();
+            mState.mPenWidth = pen.GetWidth();
+            break;
+        }
+
+        case Op::SetBrush:
+        {
+            auto &brush = commands.GetBrush(command.mIndex);
+            mState.mBrushVisible = brush.IsOk() && !brush.IsTransparent();
+            mState.mBrushColour = brush.GetColour();
+            break;
+        }
+
+        case Op::DrawRectangle:
+            AddRectangle(contours, command.mA, command.mB, command.mC, command.mD);
+            DrawShape(contours, true);
+            break;
+
+        case Op::DrawEllipse:
+            AddEllipse(contours, command.mA, command.mB, command.mC, command.mD);
+            DrawShape(contours, true);
+            break;
+
+        case Op::StrokeLine:
+            contours.push_back({{transform.Apply(command.mA, command.mB), transform.Apply(command.mC, command.mD)}});
+            DrawShape(contours, false);
+            break;
+
+        case Op::DrawPath:
+            AddPath(contours, commands, command);
+            DrawShape(contours, true);
+            break;
+
+        case Op::StrokePath:
+            AddPath(contours, commands, command);
+            DrawShape(contours, false);
+            break;
+
+        case Op::DrawBitmap:
+            if (mDrawBitmaps)
+                DrawBitmap(commands.GetBitmap(command.mIndex), command.mA, command.mB, command.mC, command.mD);
+            break;
+
+        case Op::SetFont:
+        case Op::DrawText:
+        case Op::DrawTextBox:
+            // No font engine, text isn't drawn
+            break;
+        }
+    }
+}
+
+/**
+ * Add a rectangle as a closed contour
+ * @param contours Contours to add to
+ * @param x X of the top left
+ * @param y Y of the top left
+ * @param width Width
+ * @param height Height
+ */
+void SoftwareRenderer::AddRectangle(std::vector<Contour> &contours, double x, double y, double width, double height)
+{
+    auto &transform = mState.mTransform;
+    contours.push_back({{transform.Apply(x, y), transform.Apply(x + width, y), transform.Apply(x + width, y + height),
+                         transform.Apply(x, y + height)},
+                        true});
+}
+
+/**
+ * Add an ellipse as a closed contour
+ * @param contours Contours to add to
+ * @param x X of the top left of the bounding rectangle
+ * @param y Y of the top left of the bounding rectangle
+ * @param width Width
+ * @param height Height
+ */
+void SoftwareRenderer::AddEllipse(std::vector<Contour> &contours, double x, double y, double width, double height)
+{
+    Contour contour;
+    contour.mClosed = true;
+    for (int i = 0; i < EllipseSegments; i++)
+    {
+        double angle = 2 * M_PI * i / EllipseSegments;
+        contour.mPoints.push_back(mState.mTransform.Apply(x + width / 2 * (1 + std::cos(angle)),
+                                                          y + height / 2 * (1 + std::sin(angle))));
+    }
+    contours.push_back(contour);
+}
+
+/**
+ * Add the segments of a path command as contours
+ * @param contours Contours to add to
+ * @param commands Buffer holding the command
+ * @param command DrawPath or StrokePath command
+ */
+void SoftwareRenderer::AddPath(std::vector<Contour> &contours, const DrawCommands &commands,
+                               const DrawCommands::Command &command)
+{
+    using SegmentType = DrawCommands::SegmentType;
+
+    auto &transform = mState.mTransform;
+    wxPoint2DDouble current(0, 0);
+    wxPoint2DDouble start(0, 0);
+    auto segments = commands.GetSegments(command.mIndex);
+    for (unsigned int i = 0; i < command.mCount; i++)
+    {
+        auto &segment = segments[i];
+        switch (segment.mType)
+        {
+        case SegmentType::MoveTo:
+            current = start = wxPoint2DDouble(segment.mX[0], segment.mY[0]);
+            contours.push_back({{transform.Apply(current.m_x, current.m_y)}});
+            break;
+
+        case SegmentType::LineTo:
+            if (contours.empty())
+            {
+                contours.push_back({{transform.Apply(current.m_x, current.m_y)}});
+            }
+            current = wxPoint2DDouble(segment.mX[0], segment.mY[0]);
+            contours.back().mPoints.push_back(transform.Apply(current.m_x, current.m_y));
+            break;
+
+        case SegmentType::CurveTo:
+        {
+            if (contours.empty())
+            {
+                contours.push_back({{transform.Apply(current.m_x, current.m_y)}});
+            }
+            for (int step = 1; step <= CurveSegments; step++)
+            {
+                double t = (double)step / CurveSegments;
+                double u = 1 - t;
+                double x = u * u * u * current.m_x + 3 * u * u * t * segment.mX[0] + 3 * u * t * t * segment.mX[1] +
+                           t * t * t * segment.mX[2];
+                double y = u * u * u * current.m_y + 3 * u * u * t * segment.mY[0] + 3 * u * t * t * segment.mY[1] +
+                           t * t * t * segment.mY[2];
+                contours.back().mPoints.push_back(transform.Apply(x, y));
+            }
+            current = wxPoint2DDouble(segment.mX[2], segment.mY[2]);
+            break;
+        }
+
+        case SegmentType::Rectangle:
+            AddRectangle(contours, segment.mX[0], segment.mY[0], segment.mX[1], segment.mY[1]);
+            current = start = wxPoint2DDouble(segment.mX[0], segment.mY[0]);
+            break;
+
+        case SegmentType::Close:
+            if (!contours.empty())
+            {
+                contours.back().mClosed = true;
+            }
+            current = start;
+            break;
+        }
+    }
+}
+
+/**
+ * Fill a shape with the brush, if there is one, and outline it with the pen
+ * @param contours The shape
+ * @param fill Whether to fill it, false to only outline it
+ */
+void SoftwareRenderer::DrawShape(const std::vector<Contour> &contours, bool fill)
+{
+    if (fill && mState.mBrushVisible)
+    {
+        Fill(contours, mState.mBrushColour);
+    }
+
+    if (mState.mPenVisible)
+    {
+        Stroke(contours);
+    }
+}
+
+/**
+ * Fill contours by the even-odd rule, pixels whose center is inside
+ * @param contours Contours to fill, each treated as closed
+ * @param colour Color to fill with
+ */
+void SoftwareRenderer::Fill(const std::vector<Contour> &contours, const wxColour &colour)
+{
+    double top = mHeight, bottom = 0;
+    for (auto &contour : contours)
+    {
+        for (auto &point : contour.mPoints)
+        {
+            top = std::min(top, point.m_y);
+            bottom = std::max(bottom, point.m_y);
+        }
+    }
+
+    int rowStart = std::max(mState.mClipTop, (int)std::floor(top));
+    int rowEnd = std::min(mState.mClipBottom, (int)std::ceil(bottom));
+    std::vector<double> crossings;
+    for (int row = rowStart; row < rowEnd; row++)
+    {
+        double y = row + 0.5;
+        crossings.clear();
+        for (auto &contour : contours)
+        {
+            auto &points = contour.mPoints;
+            for (size_t i = 0; i < points.size(); i++)
+            {
+                auto &p = points[i];
+                auto &q = points[(i + 1) % points.size()];
+                if ((p.m_y <= y && q.m_y > y) || (q.m_y <= y && p.m_y > y))
+                {
+                    crossings.push_back(p.m_x + (y - p.m_y) * (q.m_x - p.m_x) / (q.m_y - p.m_y));
+                }
+            }
+        }
+
+        std::sort(crossings.begin(), crossings.end());
+        for (size_t i = 0; i + 1 < crossings.size(); i += 2)
+        {
+            int left = std::max(mState.mClipLeft, (int)std::ceil(crossings[i] - 0.5));
+            int right = std::min(mState.mClipRight, (int)std::ceil(crossings[i + 1] - 0.5));
+            for (int x = left; x < right; x++)
+            {
+                Blend(x, row, colour, colour.Alpha());
+            }
+        }
+    }
+}
+
+/**
+ * Outline contours with the pen. Each segment is filled as a band the
+ * width of the pen, with a square on each point to fill the joins.
+ * @param contours Contours to outline
+ */
+void SoftwareRenderer::Stroke(const std::vector<Contour> &contours)
+{
+    auto &transform = mState.mTransform;
+    double scale = std::sqrt(std::abs(transform.mA * transform.mD - transform.mB * transform.mC));
+    double half = std::max(mState.mPenWidth * scale, 1.0) / 2;
+
+    std::vector<Contour> band(1);
+    band[0].mPoints.resize(4);
+    for (auto &contour : contours)
+    {
+        auto &points = contour.mPoints;
+        size_t count = contour.mClosed ? points.size() : points.size() - 1;
+        for (size_t i = 0; i < count && points.size() > 1; i++)
+        {
+            auto &p = points[i];
+            auto &q = points[(i + 1) % points.size()];
+            double length = std::hypot(q.m_x - p.m_x, q.m_y - p.m_y);
+            if (length <= 0)
+            {
+                continue;
+            }
+
+            double nx = -(q.m_y - p.m_y) / length * half;
+            double ny = (q.m_x - p.m_x) / length * half;
+            band[0].mPoints[0] = wxPoint2DDouble(p.m_x + nx, p.m_y + ny);
+            band[0].mPoints[1] = wxPoint2DDouble(q.m_x + nx, q.m_y + ny);
+            band[0].mPoints[2] = wxPoint2DDouble(q.m_x - nx, q.m_y - ny);
+            band[0].mPoints[3] = wxPoint2DDouble(p.m_x - nx, p.m_y - ny);
+            Fill(band, mState.mPenColour);
+
+            if (half > 1 && (i + 1 < points.size() || contour.mClosed))
+            {
+                band[0].mPoints[0] = wxPoint2DDouble(q.m_x - half, q.m_y - half);
+                band[0].mPoints[1] = wxPoint2DDouble(q.m_x + half, q.m_y - half);
+                band[0].mPoints[2] = wxPoint2DDouble(q.m_x + half, q.m_y + half);
+                band[0].mPoints[3] = wxPoint2DDouble(q.m_x - half, q.m_y + half);
+                Fill(band, mState.mPenColour);
+            }
+        }
+    }
+}
+
+/**
+ * Draw a bitmap stretched to a rectangle, sampling the nearest pixel
+ * @param bitmap Bitmap to draw
+ * @param x X of the top left
+ * @param y Y of the top left
+ * @param width Width
+ * @param height Height
+ */
+void SoftwareRenderer::DrawBitmap(const wxBitmap &bitmap, double x, double y, double width, double height)
+{
+    if (!bitmap.IsOk() || width <= 0 || height <= 0)
+    {
+        return;
+    }
+
+    auto found = std::find_if(mImages.begin(), mImages.end(),
+                              [&bitmap](const std::pair<wxBitmap, wxImage> &image) { return image.first.IsSameAs(bitmap); });
+    if (found == mImages.end())
+    {
+        mImages.emplace_back(bitmap, bitmap.ConvertToImage());
+        found = mImages.end() - 1;
+    }
+
+    auto &image = found->second;
+    const unsigned char *rgb = image.IsOk() ? image.GetData() : nullptr;
+    int imageWidth = image.GetWidth();
+    int imageHeight = image.GetHeight();
+    if (rgb == nullptr || imageWidth <= 0 || imageHeight <= 0)
+    {
+        return;
+    }
+    const unsigned char *alpha = image.HasAlpha() ? image.GetAlpha() : nullptr;
+
+    auto &t = mState.mTransform;
+    double det = t.mA * t.mD - t.mB * t.mC;
+    if (det == 0)
+    {
+        return;
+    }
+
+    std::vector<Contour> contours;
+    AddRectangle(contours, x, y, width, height);
+    double left = mWidth, top = mHeight, right = 0, bottom = 0;
+    for (auto &point : contours[0].mPoints)
+    {
+        left = std::min(left, point.m_x);
+        top = std::min(top, point.m_y);
+        right = std::max(right, point.m_x);
+        bottom = std::max(bottom, point.m_y);
+    }
+
+    int rowStart = std::max(mState.mClipTop, (int)std::floor(top));
+    int rowEnd = std::min(mState.mClipBottom, (int)std::ceil(bottom));
+    int columnStart = std::max(mState.mClipLeft, (int)std::floor(left));
+    int columnEnd = std::min(mState.mClipRight, (int)std::ceil(right));
+    for (int row = rowStart; row < rowEnd; row++)
+    {
+        for (int column = columnStart; column < columnEnd; column++)
+        {
+            // Back from the pixel center to user coordinates
+            double dx = column + 0.5 - t.mTx;
+            double dy = row + 0.5 - t.mTy;
+            double ux = (t.mD * dx - t.mC * dy) / det;
+            double uy = (t.mA * dy - t.mB * dx) / det;
+
+            int sx = (int)std::floor((ux - x) / width * imageWidth);
+            int sy = (int)std::floor((uy - y) / height * imageHeight);
+            if (sx < 0 || sy < 0 || sx >= imageWidth || sy >= imageHeight)
+            {
+                continue;
+            }
+
+            int index = sy * imageWidth + sx;
+            Blend(column, row, wxColour(rgb[index * 3], rgb[index * 3 + 1], rgb[index * 3 + 2]),
+                  alpha != nullptr ? alpha[index] : 255);
+        }
+    }
+}
+
+/**
+ * Blend a color over a pixel
+ * @param x X of the pixel, inside the buffer
+ * @param y Y of the pixel, inside the buffer
+ * @param colour Color to blend
+ * @param alpha Opacity from 0 to 255
+ */
+void SoftwareRenderer::Blend(int x, int y, const wxColour &colour, int alpha)
+{
+    auto pixel = &mPixels[(y * mWidth + x) * 4];
+    if (alpha >= 255)
+    {
+        pixel[0] = colour.Red();
+        pixel[1] = colour.Green();
+        pixel[2] = colour.Blue();
+        pixel[3] = 255;
+        return;
+    }
+
+    int inverse = 255 - alpha;
+    pixel[0] = (unsigned char)((colour.Red() * alpha + pixel[0] * inverse + 127) / 255);
+    pixel[1] = (unsigned char)((colour.Green() * alpha + pixel[1] * inverse + 127) / 255);
+    pixel[2] = (unsigned char)((colour.Blue() * alpha + pixel[2] * inverse + 127) / 255);
+    pixel[3] = (unsigned char)(alpha + (pixel[3] * inverse + 127) / 255);
+}
@@ -0,0 +1,135 @@
+/**
+ * @file SoftwareRenderer.hpp
+ * @author Alex Mueller
+ *
+ * Draws recorded frames into memory without a display
+ */
+
+#ifndef SOFTWARERENDERER_HPP
+#define SOFTWARERENDERER_HPP
+
+#include <utility>
+#include <vector>
+#include "DrawCommands.hpp"
+#include "Renderer.hpp"
+
+/**
+ * Renderer that rasterizes the commands into an RGBA buffer.
+ *
+ * It needs no display server or graphics context, so frames can be
+ * drawn in tests and on build machines. Shapes, paths and lines are
+ * filled by scanline at pixel centers without antialiasing. Bitmaps
+ * are sampled nearest neighbour. Text needs a font engine, so text
+ * commands are skipped. Bitmaps come from the platform's image loading
+ * and resampling, with them left out too the output is the same on
+ * every machine.
+ */
+class SoftwareRenderer : public Renderer {
+public:
+    SoftwareRenderer(int width, int height);
+
+    void Clear(const wxColour &colour);
+    void Render(const DrawCommands &commands) override;
+
+    /**
+     * Width of the buffer
+     * @return width in pixels
+     */
+    int GetWidth() const { return mWidth; }
+
+    /**
+     * Height of the buffer
+     * @return height in pixels
+     */
+    int GetHeight() const { return mHeight; }
+
+    /**
+     * The pixels, four bytes each in red, green, blue, alpha order,
+     * row by row from the top
+     * @return pixels
+     */
+    const std::vector<unsigned char> &GetPixels() const { return mPixels; }
+
+    /**
+     * Set whether bitmaps are drawn
+     * @param draw True to draw bitmaps, false to skip them like text
+     */
+    void SetDrawBitmaps(bool draw) { mDrawBitmaps = draw; }
+
+    wxColour GetPixel(int x, int y) const;
+    wxImage ToImage() const;
+
+private:
+    /// Affine transform from user to buffer coordinates
+    struct Transform
+    {
+        /// Matrix, x' = mA x + mC y + mTx, y' = mB x + mD y + mTy
+        double mA = 1, mB = 0, mC = 0, mD = 1, mTx = 0, mTy = 0;
+
+        /**
+         * Transform a point
+         * @param x X in user coordinates
+         * @param y Y in user coordinates
+         * @return point in buffer coordinates
+         */
+        wxPoint2DDouble Apply(double x, double y) const
+        {
+            return wxPoint2DDouble(mA * x + mC * y + mTx, mB * x + mD * y + mTy);
+        }
+    };
+
+    /// The drawing state PushState saves
+    struct State
+    {
+        /// Current transform
+        Transform mTransform;
+        /// Clip rectangle in pixels, left and top inclusive, right and bottom exclusive
+        int mClipLeft, mClipTop, mClipRight, mClipBottom;
+        /// Pen color
+        wxColour mPenColour;
+        /// Pen width in user units
+        double mPenWidth = 1;
+        /// Whether lines are drawn
+        bool mPenVisible = false;
+        /// Brush color
+        wxColour mBrushColour;
+        /// Whether shapes are filled
+        bool mBrushVisible = false;
+    };
+
+    /// A run of connected points in buffer coordinates
+    struct Contour
+    {
+        /// The points
+        std::vector<wxPoint2DDouble> mPoints;
+        /// Whether the last point joins back to the first
+        bool mClosed = false;
+    };
+
+    void AddRectangle(std::vector<Contour> &contours, double x, double y, double width, double height);
+    void AddEllipse(std::vector<Contour> &contours, double x, double y, double width, double height);
+    void AddPath(std::vector<Contour> &contours, const DrawCommands &commands, const DrawCommands::Command &command);
+
+    void Fill(const std::vector<Contour> &contours, const wxColour &colour);
+    void Stroke(const std::vector<Contour> &contours);
+    void DrawShape(const std::vector<Contour> &contours, bool fill);
+    void DrawBitmap(const wxBitmap &bitmap, double x, double y, double width, double height);
+    void Blend(int x, int y, const wxColour &colour, int alpha);
+
+    /// Width in pixels
+    int mWidth;
+    /// Height in pixels
+    int mHeight;
+    /// RGBA pixels
+    std::vector<unsigned char> mPixels;
+    /// Current state
+    State mState;
+    /// States saved by PushState
+    std::vector<State> mStates;
+    /// Are bitmaps drawn?
+    bool mDrawBitmaps = true;
+    /// Images of the bitmaps drawn so far, converted once
+    std::vector<std::pair<wxBitmap, wxImage>> mImages;
+};
+
+#endif // SOFTWARERENDERER_HPP
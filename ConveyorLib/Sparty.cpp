@@ -5,7 +5,9 @@
 
 #include "pch.h"
 #include "Sparty.hpp"
+#include "Snapshot.hpp"
 #include "SpartyBoots.hpp"
+#include "WireBatch.hpp"
 
 /// Image for the sparty background, what is behind the boot
 const std::wstring SpartyBackImage = L"sparty-back.png";
@@ -36,21 +38,6 @@ const double SpartyBootPercentage = 0.80;
 /// Diameter to draw the pin in pixels
 const int PinSize = 10;
 
-/// Color to use for drawing a zero connection wire
-const wxColour ConnectionColorZero = *wxBLACK;
-
-/// Color to use for drawing a one connection wire
-const wxColour ConnectionColorOne = *wxRED;
-
-/// Color to use for drawing an unknown state connection wire
-const wxColour ConnectionColorUnknown = wxColour(128, 128, 128);
-
-/// Maximum offset of Bezier control points relative to line ends
-static constexpr double BezierMaxOffset = 200;
-
-/// Line with for drawing lines between pins
-static const int LineWidth = 3;
-
 /// Default length of line from the pin
 static const int DefaultLineLength = 20;
 
@@ -67,7 +54,7 @@ static const int DefaultLineLength = 20;
  * @param kickSpeed float
  */
 Sparty::Sparty(SpartyBoots *spartyBoots, int x, int y, int height, int pinX, int pinY, double kickDuration, int kickSpeed)
-    : LogicItem(spartyBoots), mSpartyBackImage(L"images/" + SpartyBackImage, wxBITMAP_TYPE_ANY), mSpartyBackBitmap(mSpartyBackImage),
+    : PinOwner(spartyBoots), mSpartyBackImage(L"images/" + SpartyBackImage, wxBITMAP_TYPE_ANY), mSpartyBackBitmap(mSpartyBackImage),
       mSpartyBootImage(L"images/" + SpartyBootImage, wxBITMAP_TYPE_ANY), mSpartyBootBitmap(mSpartyBootImage),
       mSpartyFrontImage(L"images/" + SpartyFrontImage, wxBITMAP_TYPE_ANY), mSpartyFrontBitmap(mSpartyFrontImage)
 
@@ -82,16 +69,16 @@ Sparty::Sparty(SpartyBoots *spartyBoots, int x, int y, int height, int pinX, int
     mWidth = (double)mHeight / 2;
     SetLocation(x, y);
 
-    mInputPins.push_back(std::make_shared<InputPin>(spartyBoots));
-    spartyBoots->Add(mInputPins[0]);
+    AddInputPin();
 }
 
 /**
  * Draw Sparty.
  * @param graphics
  */
-void Sparty::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void Sparty::Draw(DrawCommands &graphics)
 {
+    double scale = GetSpartyBoots()->getScale();
     int x = GetX(), y = GetY();
 
     //Change color according to input pin value
@@ -99,61 +86,61 @@ void Sparty::Draw(std::shared_ptr<wxGraphicsContext> graphics)
     {
         if (mInputPins[0]->getValue())
         {
-            graphics->SetPen(graphics->CreatePen(wxGraphicsPenInfo (ConnectionColorOne, 3)));
+            graphics.SetPen(wxPen(WireBatch::ConnectionColorOne, WireBatch::LineWidth));
         }
         else
         {
-            graphics->SetPen(graphics->CreatePen(wxGraphicsPenInfo (ConnectionColorZero, 3)));
+            graphics.SetPen(wxPen(WireBatch::ConnectionColorZero, WireBatch::LineWidth));
         }
     }
     else
     {
-        graphics->SetPen(graphics->CreatePen(wxGraphicsPenInfo (ConnectionColorUnknown, 3)));
+        graphics.SetPen(wxPen(WireBatch::ConnectionColorUnknown, WireBatch::LineWidth));
     }
 
 
-    graphics->StrokeLine(mX, mY, mX + 100, mY);
-    graphics->StrokeLine(mX + 100, mY, mX + 100, mY - 200);
+    graphics.StrokeLine(mX, mY, mX + 100, mY);
+    graphics.StrokeLine(mX + 100, mY, mX + 100, mY - 200);
 
     if (mIsSensor)
     {
-        graphics->StrokeLine(mX + 100, mY - 200, mX + 775, mY - 200);
-        graphics->StrokeLine(mX + 775, mY - 200, mX + 775, mY + 60);
-        graphics->StrokeLine(mX + 775 - DefaultLineLength, mY + 60, mX + 775, mY + 60);
+        graphics.StrokeLine(mX + 100, mY - 200, mX + 775, mY - 200);
+        graphics.StrokeLine(mX + 775, mY - 200, mX + 775, mY + 60);
+        graphics.StrokeLine(mX + 775 - DefaultLineLength, mY + 60, mX + 775, mY + 60);
     }
     else
     {
-        graphics->StrokeLine(mX + 100, mY - 200, mX + 830, mY - 200);
-        graphics->StrokeLine(mX + 830, mY - 200, mX + 830, mY + 60);
-        graphics->StrokeLine(mX + 830 - DefaultLineLength, mY + 60, mX + 830, mY + 60);
+        graphics.StrokeLine(mX + 100, mY - 200, mX + 830, mY - 200);
+        graphics.StrokeLine(mX + 830, mY - 200, mX + 830, mY + 60);
+        graphics.StrokeLine(mX + 830 - DefaultLineLength, mY + 60, mX + 830, mY + 60);
     }
 
-    graphics->DrawBitmap(mSpartyBackBitmap, mX - (mWidth / 3), mY - (mHeight / 2), mWidth, mHeight);
-    graphics->DrawBitmap(mSpartyFrontBitmap, mX - (mWidth / 3), mY - (mHeight / 2), mWidth, mHeight);
+    mSpartyBackBitmap.Draw(graphics, scale, mX - (mWidth / 3), mY - (mHeight / 2), mWidth, mHeight);
+    mSpartyFrontBitmap.Draw(graphics, scale, mX - (mWidth / 3), mY - (mHeight / 2), mWidth, mHeight);
 
     mInputPins[0]->SetLocation(mPinX,mPinY);
     mInputPins[0]->DrawPins(graphics, mPinX,mPinY, mPinX,mPinY);
 
     if(mIsKicking)
     {
-        graphics->PushState();
+        graphics.PushState();
 
         double bootPivotX = mX - (mWidth / 3) + (mWidth * SpartyBootPivot.m_x);
         double bootPivotY = mY - (mWidth) + (mHeight * SpartyBootPivot.m_y);
 
-        graphics->Translate(bootPivotX, bootPivotY);
+        graphics.Translate(bootPivotX, bootPivotY);
 
-        graphics->Rotate(mBootAngle);
+        graphics.Rotate(mBootAngle);
 
-        graphics->Translate(-bootPivotX, -bootPivotY);
+        graphics.Translate(-bootPivotX, -bootPivotY);
 
-        graphics->DrawBitmap(mSpartyBootBitmap, mX - (mWidth / 3), mY - (mHeight / 2), mWidth, mHeight);
+        mSpartyBootBitmap.Draw(graphics, scale, mX - (mWidth / 3), mY - (mHeight / 2), mWidth, mHeight);
 
-        graphics->PopState();
+        graphics.PopState();
     }
     else
     {
-        graphics->DrawBitmap(mSpartyBootBitmap, mX - (mWidth / 3), mY - (mWidth), mWidth, mHeight);
+        mSpartyBootBitmap.Draw(graphics, scale, mX - (mWidth / 3), mY - (mWidth), mWidth, mHeight);
     }
 
 }
@@ -192,3 +179,29 @@ void Sparty::Update(double elapsed)
         }
     }
 }
+
+/**
+ * Save the state that changes as the game runs
+ * @param writer Snapshot to write to
+ */
+void Sparty::SaveState(SnapshotWriter &writer)
+{
+    Item::SaveState(writer);
+    writer.Write(mBootAngle);
+    writer.Write(mReturning);
+    writer.Write(mIsKicking);
+    writer.Write(mIsSensor);
+}
+
+/**
+ * Restore the state saved by SaveState
+ * @param reader Snapshot to read from
+ */
+void Sparty::LoadState(SnapshotReader &reader)
+{
+    Item::LoadState(reader);
+    reader.Read(mBootAngle);
+    reader.Read(mReturning);
+    reader.Read(mIsKicking);
+    reader.Read(mIsSensor);
+}
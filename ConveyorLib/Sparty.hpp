@@ -8,13 +8,14 @@
 #ifndef SPARTY_HPP
 #define SPARTY_HPP
 #include "Item.hpp"
-#include "LogicItem.hpp"
+#include "PinOwner.hpp"
+#include "ScaledBitmap.hpp"
 #include "InputPin.h"
 
 /**
 *Sparty Class
 */
-class Sparty : public LogicItem {
+class Sparty : public PinOwner {
 private:
     /// x coord
     int mX;
@@ -42,35 +43,34 @@ private:
     ///Is there a sensor so drawing can compensate
     bool mIsSensor = false;
 
-    /// vector containing input pins
-    std::vector<std::shared_ptr<InputPin>> mInputPins;
-
     /// Image for the sparty background.
     wxImage mSpartyBackImage;
 
     /// The bitmap for sparty background.
-    wxBitmap mSpartyBackBitmap;
+    ScaledBitmap mSpartyBackBitmap;
 
     /// The Image for the Sparty boot.
     wxImage mSpartyBootImage;
 
     /// The bitmap for Sparty boot.
-    wxBitmap mSpartyBootBitmap;
+    ScaledBitmap mSpartyBootBitmap;
 
     /// The Image for the Sparty front.
     wxImage mSpartyFrontImage;
 
     /// The bitmap for Sparty front.
-    wxBitmap mSpartyFrontBitmap;
+    ScaledBitmap mSpartyFrontBitmap;
 
 public:
     Sparty(SpartyBoots *spartyBoots, int x, int y, int height, int pinX, int pinY, double kickDuration, int kickSpeed);
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void Draw(DrawCommands &graphics) override;
     bool HitTest(int x, int y) override
     {
         return false;
     };
     void Update(double elapsed) override;
+    void SaveState(SnapshotWriter &writer) override;
+    void LoadState(SnapshotReader &reader) override;
     /**
      * Accept a visitor
      * @param visitor The visitor to accept
@@ -89,18 +89,18 @@ public:
         return mKickSpeed;
     };
    /**
-    * @param graphics Shared pointer to the `wxGraphicsContext` used for rendering the pins.
+    * @param graphics The command buffer used for rendering the pins.
     * @param start_x The x-coordinate of the pin's starting point.
     * @param start_y The y-coordinate of the pin's starting point.
     * @param end_x The x-coordinate of the pin's ending point.
     * @param end_y The y-coordinate of the pin's ending point.
     */
-    void DrawPins(std::shared_ptr<wxGraphicsContext> graphics, int start_x, int start_y, int end_x, int end_y)override {};
+    void DrawPins(DrawCommands &graphics, int start_x, int start_y, int end_x, int end_y)override {};
     /**
      * retrieve pin for result
      * @return mInputPin
      */
-    std::vector<std::shared_ptr<InputPin>> getPin(){ return mInputPins; };
+    const std::vector<std::shared_ptr<InputPin>> &getPin() const { return mInputPins; };
 
     /**
      * retrieves if sparty is kicking
@@ -8,18 +8,30 @@
 #include <wx/tokenzr.h>
 #include "Beam.hpp"
 #include "Conveyor.hpp"
+#include "EventVisitor.hpp"
+#include "GraphicsRenderer.hpp"
 #include "Item.hpp"
 #include "LastProductVisitor.hpp"
 #include "LoadLevel.h"
+#include "MotionVisitor.hpp"
 #include "Product.h"
 #include "ProductUpdateVisitor.hpp"
 #include "ScoreBoard.hpp"
 #include "Sensor.h"
 #include "Sparty.hpp"
 #include <algorithm>
+#include <limits>
 #include "LogicGate.h"
 #include "OutputPin.h"
 #include "InputPin.h"
+#include "AndGate.hpp"
+#include "OrGate.hpp"
+#include "NotGate.hpp"
+#include "SRFlipFlop.h"
+#include "DFlipFlop.h"
+#include "InputRecorder.hpp"
+#include "Snapshot.hpp"
+#include "Trace.hpp"
 
 using namespace std;
 
@@ -39,6 +51,18 @@ const std::wstring DirectoryContainingImages = L"images/";
 /// Level notices duration in seconds
 const double LevelNoticeDuration = 2.0;
 
+/// Seconds after the last product passes before the level is complete
+const double LevelEndDelay = 3.0;
+
+/// How far past an event FastForward steps, so the update sees it happened
+const double EventMargin = 1e-6;
+
+/// Longest FastForward step while a feedback loop oscillates, it changes every update
+const double OscillatingStep = 1.0 / 60;
+
+/// Number of updates between snapshots for rewinding
+const int SnapshotInterval = 10;
+
 /// Size of notices displayed on screen in virtual pixels
 const int NoticeSize = 100;
 
@@ -70,23 +94,33 @@ SpartyBoots::SpartyBoots(wxWindow *parent)
 }
 
 /**
- * Add an item to the SpartyBoots
- * @param item New item to add
+ * Add a gate to the SpartyBoots
+ * @param gate New gate to add
  */
-void SpartyBoots::Add(std::shared_ptr<Item> item)
+void SpartyBoots::Add(std::shared_ptr<LogicGate> gate)
 {
-    item->SetLocation(InitialX, InitialY);
-    mItems.push_back(item);
+    gate->SetLocation(InitialX, InitialY);
+    mItems.Add(gate);
 }
 
 void SpartyBoots::InsertItem(std::shared_ptr<Item> item)
 {
-    auto loc = find(begin(mItems), end(mItems), item);
-    if (loc != end(mItems))
+    mItems.MoveToFront(item.get());
+}
+
+/**
+ * Get every item in drawing order
+ * @return items, back to front
+ */
+std::vector<std::shared_ptr<Item>> SpartyBoots::GetItems() const
+{
+    std::vector<std::shared_ptr<Item>> items;
+    items.reserve(mItems.GetCount());
+    for (auto &item : mItems.BackToFront())
     {
-        mItems.erase(loc);
+        items.push_back(item);
     }
-    mItems.push_back(item);
+    return items;
 }
 
 /**
@@ -103,17 +137,17 @@ std::shared_ptr<IDraggable> SpartyBoots::HitTest(int x, int y)
     double virtualX = (x - mXOffset) / mScale;
     double virtualY = (y - mYOffset) / mScale;
 
-    for (auto i = mItems.rbegin(); i != mItems.rend(); i++)
+    for (auto &item : mItems.FrontToBack())
     {
-        auto draggable = (*i)->HitDraggable(virtualX, virtualY);
+        auto draggable = item->HitDraggable(virtualX, virtualY);
         if(draggable != nullptr)
         {
             return draggable;
         }
 
-        if ((*i)->HitTest(virtualX, virtualY))
+        if (item->HitTest(virtualX, virtualY))
         {
-            return *i;
+            return item;
         }
     }
 
@@ -121,15 +155,58 @@ std::shared_ptr<IDraggable> SpartyBoots::HitTest(int x, int y)
 }
 
 /**
- * Draw the game
- * @param graphics Graphics device to draw on
+ * Grab whatever is under the mouse
+ * @param x X location in pixels
+ * @param y Y location in pixels
+ */
+void SpartyBoots::Grab(int x, int y)
+{
+    Record(InputRecorder::Type::Grab, x, y);
+    mGrabbedItem = HitTest(x, y);
+}
+
+/**
+ * Drag the grabbed item, if any
+ * @param x X location in pixels
+ * @param y Y location in pixels
+ */
+void SpartyBoots::Drag(int x, int y)
+{
+    if (mGrabbedItem != nullptr)
+    {
+        Record(InputRecorder::Type::Drag, x, y);
+        mGrabbedItem->SetLocation((x - mXOffset) / mScale, (y - mYOffset) / mScale);
+    }
+}
+
+/**
+ * Release the grabbed item, if any
+ */
+void SpartyBoots::Release()
+{
+    if (mGrabbedItem != nullptr)
+    {
+        Record(InputRecorder::Type::Release);
+        mGrabbedItem->Release();
+        mGrabbedItem = nullptr;
+    }
+}
+
+/**
+ * Set the size of the window we draw into and
+ * compute the scaling to virtual pixels
  * @param width Width of the window
- * @param height Height of the
- *
- * window
+ * @param height Height of the window
  */
-void SpartyBoots::OnDraw(std::shared_ptr<wxGraphicsContext> graphics, int width, int height)
+void SpartyBoots::SetViewSize(int width, int height)
 {
+    if (width != mViewWidth || height != mViewHeight)
+    {
+        Record(InputRecorder::Type::View, width, height);
+        mViewWidth = width;
+        mViewHeight = height;
+    }
+
     //
     // Automatic Scaling
     //
@@ -143,20 +220,82 @@ void SpartyBoots::OnDraw(std::shared_ptr<wxGraphicsContext> graphics, int width,
     {
         mYOffset = (double)((height - mPixelHeight * mScale) / 2.0);
     }
+}
+
+/**
+ * Start or stop recording input
+ * @param recorder Recorder to add to or nullptr to stop recording
+ */
+void SpartyBoots::SetRecorder(std::shared_ptr<InputRecorder> recorder)
+{
+    mRecorder = recorder;
+
+    // Make sure the window size is the first thing recorded
+    mViewWidth = 0;
+    mViewHeight = 0;
+}
+
+/**
+ * Add an input to the recording, if we are recording
+ * @param type Kind of input
+ * @param a First value
+ * @param b Second value
+ * @param text Text value
+ */
+void SpartyBoots::Record(InputRecorder::Type type, double a, double b, const wxString &text)
+{
+    if (mRecorder != nullptr)
+    {
+        mRecorder->Add({mTick, type, a, b, text});
+    }
+}
+
+/**
+ * Draw the game. The frame is recorded into a command buffer
+ * and then rendered on the graphics context.
+ * @param graphics Graphics device to draw on
+ * @param width Width of the window
+ * @param height Height of the
+ *
+ * window
+ */
+void SpartyBoots::OnDraw(const std::shared_ptr<wxGraphicsContext> &graphics, int width, int height)
+{
+    TRACE_SCOPE("SpartyBoots::OnDraw");
+
+    mDrawCommands.Clear();
+    Draw(mDrawCommands, width, height);
+    GraphicsRenderer(graphics.get()).Render(mDrawCommands);
+}
+
+/**
+ * Record the drawing of the game
+ * @param graphics Command buffer to draw into
+ * @param width Width of the window
+ * @param height Height of the window
+ */
+void SpartyBoots::Draw(DrawCommands &graphics, int width, int height)
+{
+    TRACE_SCOPE("SpartyBoots::Draw");
 
-    graphics->PushState();
+    SetViewSize(width, height);
 
-    graphics->Translate(mXOffset, mYOffset);
-    graphics->Scale(mScale, mScale);
+    graphics.PushState();
+
+    graphics.Translate(mXOffset, mYOffset);
+    graphics.Scale(mScale, mScale);
 
     //
     // Draw in virtual pixels on the graphics context
     //
     // INSERT YOUR DRAWING CODE HERE
-    for (auto item : mItems)
+    mLogic.Publish();
+    for (auto &item : mItems.BackToFront())
     {
         item->Draw(graphics);
     }
+    mProductSprites.Draw(graphics, mScale);
+    mWires.Stroke(graphics);
 
     // need this comment to commit for some reason feel free to delete
     // Draw notice if needed
@@ -164,39 +303,32 @@ void SpartyBoots::OnDraw(std::shared_ptr<wxGraphicsContext> graphics, int width,
     {
         wxString message = wxString::Format(L"Level %d", mCurrentLevel);
         wxFont font(NoticeSize, wxFONTFAMILY_SWISS, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_BOLD);
-        graphics->SetFont(font, LevelNoticeColor);
-
-        double width, height;
-        graphics->GetTextExtent(message, &width, &height);
-
-        double x = (mPixelWidth - width) / 2 - LevelNoticePadding;
-        double y = (mPixelHeight - height) / 2;
-        graphics->SetBrush(wxBrush(LevelNoticeBackground));
-        graphics->SetPen(*wxTRANSPARENT_PEN);
-        graphics->DrawRectangle(x, y, width + 2 * LevelNoticePadding, height);
+        graphics.SetFont(font, LevelNoticeColor);
 
-        graphics->DrawText(message, (mPixelWidth - width) / 2, (mPixelHeight - height) / 2);
+        graphics.SetBrush(wxBrush(LevelNoticeBackground));
+        graphics.SetPen(*wxTRANSPARENT_PEN);
+        graphics.DrawTextBox(message, mPixelWidth / 2.0, mPixelHeight / 2.0, LevelNoticePadding);
     }
 
     if (mShowingComplete)
     {
         wxString message = wxString::Format(L"Level Complete!");
         wxFont font(NoticeSize, wxFONTFAMILY_SWISS, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_BOLD);
-        graphics->SetFont(font, LevelNoticeColor);
+        graphics.SetFont(font, LevelNoticeColor);
 
-        double width, height;
-        graphics->GetTextExtent(message, &width, &height);
+        graphics.SetBrush(wxBrush(LevelNoticeBackground));
+        graphics.SetPen(*wxTRANSPARENT_PEN);
+        graphics.DrawTextBox(message, mPixelWidth / 2.0, mPixelHeight / 2.0, LevelNoticePadding);
+    }
 
-        double x = (mPixelWidth - width) / 2 - LevelNoticePadding;
-        double y = (mPixelHeight - height) / 2;
-        graphics->SetBrush(wxBrush(LevelNoticeBackground));
-        graphics->SetPen(*wxTRANSPARENT_PEN);
-        graphics->DrawRectangle(x, y, width + 2 * LevelNoticePadding, height);
+    graphics.PopState();
 
-        graphics->DrawText(message, (mPixelWidth - width) / 2, (mPixelHeight - height) / 2);
+    // The HUD is drawn in window pixels so it stays readable at any scale
+    if (mShowFrameStats)
+    {
+        mFrameStats.SetItemCount(static_cast<int>(mItems.GetCount()));
+        mFrameStats.Draw(graphics);
     }
-
-    graphics->PopState();
 }
 
 /**
@@ -215,11 +347,14 @@ void SpartyBoots::OnLeftDown(int x, int y)
  */
 void SpartyBoots::OnLevelSelect(int level)
 {
+    Record(InputRecorder::Type::Level, level);
     mShowingBegin = true;
     mShowingComplete = false;
     mNoticeTimer = 0;
+    mCompleteTimer = 0;
+    mLevelEndTimer = 0;
+    mGrabbedItem = nullptr;
     mCurrentLevel = level;
-    mItems.clear();
     LevelLoad(mCurrentLevel);
     // mParent->Refresh();
 }
@@ -231,6 +366,27 @@ void SpartyBoots::OnLevelSelect(int level)
 void SpartyBoots::LevelLoad(int level)
 {
     wxString levelFileName = wxGetCwd() + L"/Levels/" + levelNames[level];
+    LevelLoad(levelFileName, level);
+}
+
+/**
+ * Load a level from any level file, XML or binary
+ * @param levelFileName Level file to load
+ * @param level Level number shown on the scoreboard
+ */
+void SpartyBoots::LevelLoad(const wxString &levelFileName, int level)
+{
+    TRACE_SCOPE("SpartyBoots::LevelLoad");
+
+    // The items of the previous level go, whichever way the level is loaded
+    mItems.Clear();
+    mProducts.Clear();
+    mEvents.Clear();
+
+    // Snapshots of the previous level can't be restored into this one
+    mSnapshots.Clear();
+    mLogic.Invalidate();
+
     LoadLevel levelLoader;
     levelLoader.Load(levelFileName);
 
@@ -246,6 +402,7 @@ void SpartyBoots::LevelLoad(int level)
     mPixelHeight = static_cast<int>(h);
 
     // level sensor extraction
+    Sensor *sensorPtr = nullptr;
     auto levelSensor = levelLoader.GetLevelSensor();
     if (!levelSensor.empty())
     {
@@ -257,8 +414,10 @@ void SpartyBoots::LevelLoad(int level)
         int sensorXInt = static_cast<int>(x);
         int sensorYInt = static_cast<int>(y);
         auto levelSensorChildren = levelLoader.GetLevelSensorChildren();
+        TRACE_SCOPE("DecodeImages Sensor");
         auto sensor = std::make_shared<Sensor>(this, sensorXInt, sensorYInt, levelSensorChildren);
-        mItems.push_back(sensor);
+        sensorPtr = sensor.get();
+        mItems.Add(sensor);
     }
 
     // level Conveyer extraction
@@ -289,10 +448,11 @@ void SpartyBoots::LevelLoad(int level)
         int conveyerPanelXInt = static_cast<int>(panelX);
         int conveyerPanelYInt = static_cast<int>(panelY);
 
+        TRACE_SCOPE("DecodeImages Conveyor");
         auto conveyor = std::make_shared<Conveyor>(this, conveyerXInt, conveyerYInt, conveyerHeightInt, conveyerSpeedInt, conveyerPanelXInt,
                                                    conveyerPanelYInt);
         conveyorPtr = conveyor.get();
-        mItems.push_back(conveyor);
+        mItems.Add(conveyor);
     }
     // level extraction for beam
     auto levelBeam = levelLoader.GetLevelBeam();
@@ -307,8 +467,13 @@ void SpartyBoots::LevelLoad(int level)
     int beamYInt = static_cast<int>(by);
     int beamSenderInt = static_cast<int>(sender);
 
-    auto beam = std::make_shared<Beam>(this, beamXInt, beamYInt, beamSenderInt);
-    mItems.push_back(beam);
+    Beam *beamPtr = nullptr;
+    {
+        TRACE_SCOPE("DecodeImages Beam");
+        auto beam = std::make_shared<Beam>(this, beamXInt, beamYInt, beamSenderInt);
+        beamPtr = beam.get();
+        mItems.Add(beam);
+    }
 
 
     // level extration sparty
@@ -341,9 +506,14 @@ void SpartyBoots::LevelLoad(int level)
     int spartyPinXInt = static_cast<int>(pinx);
     int spartyPinYInt = static_cast<int>(piny);
 
-    auto sparty = std::make_shared<Sparty>(this, spartyXInt, spartyYInt, spartyHeightInt, spartyPinXInt, spartyPinYInt,
-                                           spartyKickDurationDouble, spartyKickSpeedInt);
-    mItems.push_back(sparty);
+    Sparty *spartyPtr = nullptr;
+    {
+        TRACE_SCOPE("DecodeImages Sparty");
+        auto sparty = std::make_shared<Sparty>(this, spartyXInt, spartyYInt, spartyHeightInt, spartyPinXInt, spartyPinYInt,
+                                               spartyKickDurationDouble, spartyKickSpeedInt);
+        spartyPtr = sparty.get();
+        mItems.Add(sparty);
+    }
 
     // extract scoreboard setup
     auto levelScoreboard = levelLoader.GetLevelScoreboard();
@@ -364,7 +534,7 @@ void SpartyBoots::LevelLoad(int level)
 
     auto scoreboard = std::make_shared<ScoreBoard>(this, levelScoreboardXInt, levelScoreboardYInt, wxString::Format("%d", level),
                                                    levelScoreboardGoodInt, levelScoreboardBadInt, levelScoreboardInstructions);
-    mItems.insert(mItems.begin(), scoreboard);
+    mItems.Add(scoreboard);
 
     // level products extraction
     auto levelProducts = levelLoader.GetLevelProducts();
@@ -404,12 +574,292 @@ void SpartyBoots::LevelLoad(int level)
             productAdd->SetLast();
         }
         productAdd->SetSpeed(conveyerSpeedInt);
-        mItems.push_back(productAdd);
+        mItems.Add(productAdd);
+        mProducts.Add(productAdd.get());
+    }
+
+    // pre-placed gates, used by generated levels and reference solutions
+    std::vector<std::shared_ptr<LogicGate>> levelGates;
+    for (auto &gateInfo : levelLoader.GetLevelGates())
+    {
+        // A gate needs its type and location
+        if (gateInfo.size() < 3)
+        {
+            continue;
+        }
+
+        double x, y;
+        gateInfo[1].ToDouble(&x);
+        gateInfo[2].ToDouble(&y);
+        auto gate = CreateGate(gateInfo[0]);
+        if (gate != nullptr)
+        {
+            gate->SetLocation(x, y);
+        }
+        levelGates.push_back(gate);
+    }
+
+    // pre-wired connections between the level items and gates
+    for (auto &wire : levelLoader.GetLevelWires())
+    {
+        // A wire needs both of its ends
+        if (wire.size() < 2)
+        {
+            continue;
+        }
+
+        auto from = FindLevelOutputPin(wire[0], sensorPtr, beamPtr, levelGates);
+        auto to = FindLevelInputPin(wire[1], spartyPtr, levelGates);
+        if (from != nullptr && to != nullptr)
+        {
+            from->Connect(to);
+        }
+    }
+}
+
+/**
+ * Add a gate chosen by the user
+ * @param type One of and, or, not, sr, d
+ * @return The new gate or nullptr if the type is unknown
+ */
+std::shared_ptr<LogicGate> SpartyBoots::AddGate(const wxString &type)
+{
+    Record(InputRecorder::Type::Gate, 0, 0, type);
+    return CreateGate(type);
+}
+
+/**
+ * Create a gate by its level file name and add it to the game
+ * @param type One of and, or, not, sr, d
+ * @return The new gate or nullptr if the type is unknown
+ */
+std::shared_ptr<LogicGate> SpartyBoots::CreateGate(const wxString &type)
+{
+    std::shared_ptr<LogicGate> gate;
+    if (type == L"and")
+    {
+        gate = std::make_shared<AndGate>(this);
+    }
+    else if (type == L"or")
+    {
+        gate = std::make_shared<OrGate>(this);
+    }
+    else if (type == L"not")
+    {
+        gate = std::make_shared<NotGate>(this);
+    }
+    else if (type == L"sr")
+    {
+        gate = std::make_shared<SRFlipFlop>(this);
+    }
+    else if (type == L"d")
+    {
+        gate = std::make_shared<DFlipFlop>(this);
+    }
+
+    if (gate != nullptr)
+    {
+        Add(gate);
+        mSnapshots.Clear();
+        mLogic.Invalidate();
+    }
+    return gate;
+}
+
+/**
+ * Take a snapshot of the simulation state.
+ *
+ * The snapshot holds the level timers and the state of every item,
+ * kind by kind. It does not hold the items themselves or the wiring,
+ * so it can only be restored into a game with the same items.
+ * @return snapshot bytes
+ */
+std::vector<uint8_t> SpartyBoots::SaveSnapshot()
+{
+    return WriteSnapshot();
+}
+
+/**
+ * Take a snapshot into memory reused from the last one, like SaveSnapshot
+ * @return snapshot bytes, valid until the next snapshot is taken
+ */
+const std::vector<uint8_t> &SpartyBoots::WriteSnapshot()
+{
+    WriteSnapshot(mSnapshotWriter);
+    return mSnapshotWriter.GetBytes();
+}
+
+/**
+ * Take a snapshot of the simulation state
+ * @param writer Writer to take it with, cleared first
+ */
+void SpartyBoots::WriteSnapshot(SnapshotWriter &writer)
+{
+    // Pins only needed for drawing are filled in lazily, the snapshot needs all of them
+    mLogic.Publish();
+
+    writer.Clear();
+    writer.Write(mCurrentLevel);
+    writer.Write((uint32_t)mItems.GetCount());
+    writer.Write(mNoticeTimer);
+    writer.Write(mShowingBegin);
+    writer.Write(mShowingComplete);
+    writer.Write(mCompleteTimer);
+    writer.Write(mLevelEnd);
+    writer.Write(mLevelEndTimer);
+    mItems.ForEach([&writer](Item *item) { item->SaveState(writer); });
+}
+
+/**
+ * Restore a snapshot taken by SaveSnapshot
+ * @param snapshot Snapshot bytes
+ * @return false if the snapshot is for a different set of items
+ */
+bool SpartyBoots::RestoreSnapshot(const std::vector<uint8_t> &snapshot)
+{
+    SnapshotReader reader(snapshot);
+    int level = 0;
+    uint32_t count = 0;
+    reader.Read(level);
+    reader.Read(count);
+    if (!reader.IsOk() || level != mCurrentLevel || count != mItems.GetCount())
+    {
+        return false;
+    }
+
+    // Measured with a writer of its own, the snapshot may be the bytes
+    // of mSnapshotWriter that WriteSnapshot returned
+    SnapshotWriter current;
+    WriteSnapshot(current);
+    if (snapshot.size() != current.GetBytes().size())
+    {
+        return false;
     }
+
+    reader.Read(mNoticeTimer);
+    reader.Read(mShowingBegin);
+    reader.Read(mShowingComplete);
+    reader.Read(mCompleteTimer);
+    reader.Read(mLevelEnd);
+    reader.Read(mLevelEndTimer);
+    mItems.ForEach([&reader](Item *item) { item->LoadState(reader); });
+
+    // The compiled circuit keeps its own copy of the pin values
+    mLogic.Invalidate();
+    // and the products moved, so the window around the beam has to be found again
+    mProducts.Reset();
+    return reader.IsOk();
+}
+
+/**
+ * Go back in time to the newest snapshot at least some updates ago.
+ * Snapshots newer than that are dropped.
+ * @param ticks Number of updates to go back
+ * @return false if there is no snapshot to go back to
+ */
+bool SpartyBoots::Rewind(long ticks)
+{
+    Record(InputRecorder::Type::Rewind, ticks);
+
+    int index = mSnapshots.FindAtOrBefore(mTick - ticks);
+    if (index < 0 && mSnapshots.GetCount() > 0)
+    {
+        // Go as far back as we can
+        index = 0;
+    }
+
+    std::vector<uint8_t> snapshot;
+    if (index < 0 || !mSnapshots.Get(index, snapshot) || !RestoreSnapshot(snapshot))
+    {
+        return false;
+    }
+
+    if (mGrabbedItem != nullptr)
+    {
+        mGrabbedItem->Release();
+        mGrabbedItem = nullptr;
+    }
+    mSnapshots.Truncate(index + 1);
+    mTicksSinceSnapshot = 0;
+    return true;
+}
+
+/**
+ * Find the output pin named by a wire in a level file.
+ * Names are beam, sensor.N or gate.G.N for output N of gate G.
+ * @param name Pin name
+ * @param sensor The level sensor or nullptr
+ * @param beam The level beam
+ * @param gates Gates placed by the level, in file order
+ * @return The pin or nullptr if there is no such pin
+ */
+OutputPin *SpartyBoots::FindLevelOutputPin(const wxString &name, Sensor *sensor, Beam *beam,
+                                           const std::vector<std::shared_ptr<LogicGate>> &gates)
+{
+    wxStringTokenizer tokenizer(name, ".");
+    wxString kind = tokenizer.GetNextToken();
+    long first = 0, second = 0;
+    tokenizer.GetNextToken().ToLong(&first);
+    tokenizer.GetNextToken().ToLong(&second);
+
+    if (kind == L"beam" && beam != nullptr)
+    {
+        return beam->getPins()[0].get();
+    }
+    if (kind == L"sensor" && sensor != nullptr && first >= 0 && first < (long)sensor->getPins().size())
+    {
+        return sensor->getPins()[first].get();
+    }
+    if (kind == L"gate" && first >= 0 && first < (long)gates.size() && gates[first] != nullptr)
+    {
+        auto &pins = gates[first]->GetOutputPins();
+        if (second >= 0 && second < (long)pins.size())
+        {
+            return pins[second].get();
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Find the input pin named by a wire in a level file.
+ * Names are sparty or gate.G.N for input N of gate G.
+ * @param name Pin name
+ * @param sparty The level Sparty
+ * @param gates Gates placed by the level, in file order
+ * @return The pin or nullptr if there is no such pin
+ */
+InputPin *SpartyBoots::FindLevelInputPin(const wxString &name, Sparty *sparty,
+                                         const std::vector<std::shared_ptr<LogicGate>> &gates)
+{
+    wxStringTokenizer tokenizer(name, ".");
+    wxString kind = tokenizer.GetNextToken();
+    long first = 0, second = 0;
+    tokenizer.GetNextToken().ToLong(&first);
+    tokenizer.GetNextToken().ToLong(&second);
+
+    if (kind == L"sparty" && sparty != nullptr)
+    {
+        return sparty->getPin()[0].get();
+    }
+    if (kind == L"gate" && first >= 0 && first < (long)gates.size() && gates[first] != nullptr)
+    {
+        auto &pins = gates[first]->GetInputPins();
+        if (second >= 0 && second < (long)pins.size())
+        {
+            return pins[second].get();
+        }
+    }
+    return nullptr;
 }
 
 void SpartyBoots::Update(double elapsed)
 {
+    TRACE_SCOPE("SpartyBoots::Update");
+
+    Record(InputRecorder::Type::Tick, elapsed);
+    mTick++;
+
     if (mShowingBegin)
     {
         mNoticeTimer += elapsed;
@@ -419,20 +869,23 @@ void SpartyBoots::Update(double elapsed)
         }
     }
     /// updates product location and kicked products
-    ProductUpdateVisitor visitor(elapsed);
-
-    // Visit all items
-    for (auto &item : mItems)
     {
-        item->Accept(visitor);
+        TRACE_SCOPE("ProductUpdateVisitor");
+        ProductUpdateVisitor visitor(elapsed);
+        mItems.VisitLevelItems(visitor);
+        // Accept skips the dormant products, they don't move any more
+        for (auto &product : mItems.GetProducts())
+        {
+            product->Accept(visitor);
+        }
     }
 
     /// checks if last product passed beam
     LastProductVisitor lastProductVisitor(elapsed);
-    for (auto &item : mItems)
     {
-        item->Accept(lastProductVisitor);
-
+        TRACE_SCOPE("LastProductVisitor");
+        mItems.VisitLevelItems(lastProductVisitor);
+        lastProductVisitor.VisitProducts(mProducts);
     }
     ///If there's a sensor, draw the input pin at different location
     if (lastProductVisitor.GetSensor() != nullptr)
@@ -446,22 +899,39 @@ void SpartyBoots::Update(double elapsed)
 
     //This checks if there's an item in the beam. Don't change states with visitors as the visitor
     //doesn't know about the rest of the items it will be visiting while its visiting. Check at the end.
+    auto logicStart = FrameStats::Clock::now();
     if (lastProductVisitor.IsProductInBeam())
     {
-        //Get the beam and set it to activated
-        lastProductVisitor.GetBeam()->SetItemTouchingBeam(true);
-        //Get the sensor, activate the pins with the content being whatever the product thats in the beam's content is
-        if (lastProductVisitor.GetSensor() != nullptr)
+        //A long tick can take more than one product through the beam, give each its turn in order
+        lastProductVisitor.GetProductsInBeam(mProductsInBeam);
+        for (auto product : mProductsInBeam)
         {
-            lastProductVisitor.GetSensor()->ActivatePins(lastProductVisitor.GetProductInBeam()->GetContent());
-        }
-        TopologicalComputing(lastProductVisitor.GetSensor(), lastProductVisitor.GetBeam(), lastProductVisitor.GetSparty(), lastProductVisitor.GetGates());
+            //The beam was clear between two products, the circuit sees that too
+            if (product != mProductsInBeam.front())
+            {
+                lastProductVisitor.GetBeam()->SetItemTouchingBeam(false);
+                if (lastProductVisitor.GetSensor() != nullptr)
+                {
+                    lastProductVisitor.GetSensor()->ResetPins();
+                }
+                TopologicalComputing(lastProductVisitor.GetSensor(), lastProductVisitor.GetBeam(), lastProductVisitor.GetSparty(), mItems.GetGates());
+            }
 
+            //Get the beam and set it to activated
+            lastProductVisitor.GetBeam()->SetItemTouchingBeam(true);
+            //Get the sensor, activate the pins with the content being whatever the product thats in the beam's content is
+            if (lastProductVisitor.GetSensor() != nullptr)
+            {
+                lastProductVisitor.GetSensor()->ActivatePins(product);
+            }
+            TopologicalComputing(lastProductVisitor.GetSensor(), lastProductVisitor.GetBeam(), lastProductVisitor.GetSparty(), mItems.GetGates());
 
-        if (lastProductVisitor.GetSparty()->getPin()[0]->getValue())
-        {
-            lastProductVisitor.GetSparty()->SetKicking(true);
-            lastProductVisitor.GetProductInBeam()->SetKick();
+
+            if (lastProductVisitor.GetSparty()->getPin()[0]->getValue())
+            {
+                lastProductVisitor.GetSparty()->SetKicking(true);
+                product->SetKick();
+            }
         }
     }
     else
@@ -472,14 +942,15 @@ void SpartyBoots::Update(double elapsed)
         {
             lastProductVisitor.GetSensor()->ResetPins();
         }
-        TopologicalComputing(lastProductVisitor.GetSensor(), lastProductVisitor.GetBeam(), lastProductVisitor.GetSparty(), lastProductVisitor.GetGates());
+        TopologicalComputing(lastProductVisitor.GetSensor(), lastProductVisitor.GetBeam(), lastProductVisitor.GetSparty(), mItems.GetGates());
 
     }
+    mFrameStats.SetLogicTime(FrameStats::MillisecondsSince(logicStart));
 
     if (lastProductVisitor.HasLastProductPassed())
     {
         mLevelEndTimer += elapsed;
-        if (mLevelEndTimer >= 3.0)
+        if (mLevelEndTimer >= LevelEndDelay)
         {
             mShowingComplete = true;
             mCompleteTimer += elapsed;
@@ -495,7 +966,6 @@ void SpartyBoots::Update(double elapsed)
                 {
                     mCurrentLevel++;
                 }
-                mItems.clear();
                 LevelLoad(mCurrentLevel);
                 mLevelEndTimer = 0;
             }
@@ -503,103 +973,161 @@ void SpartyBoots::Update(double elapsed)
 
     }
 
-    for (const auto &item : mItems)
+    // Only the conveyor and Sparty animate
+    TRACE_SCOPE("Item::Update");
+    if (mItems.GetConveyor() != nullptr)
+    {
+        mItems.GetConveyor()->Update(elapsed);
+    }
+    if (mItems.GetSparty() != nullptr)
     {
-        item->Update(elapsed);
+        mItems.GetSparty()->Update(elapsed);
     }
 
+    if (++mTicksSinceSnapshot >= SnapshotInterval)
+    {
+        mTicksSinceSnapshot = 0;
+        mSnapshots.Add(mTick, WriteSnapshot());
+    }
 }
 
 
-void SpartyBoots::TryToCatch(PinConnector* pinConnector, wxPoint lineEnd)
+/**
+ * Work out the upcoming events into mEvents
+ * @return Seconds to the soonest event, infinity if nothing will happen
+ */
+double SpartyBoots::ScheduleEvents()
+{
+    mEvents.Clear();
+
+    EventVisitor visitor;
+    mItems.VisitLevelItems(visitor);
+    visitor.Schedule(mEvents, mProducts);
+
+    if (mShowingBegin)
+    {
+        mEvents.Push(LevelNoticeDuration - mNoticeTimer, EventQueue::Type::Timer);
+    }
+
+    if (mShowingComplete)
+    {
+        mEvents.Push(LevelNoticeDuration - mCompleteTimer, EventQueue::Type::Timer);
+    }
+    else if (mLevelEndTimer > 0)
+    {
+        // The update that runs the level end timer out also counts toward the
+        // complete notice, so stop just short of it and cross with a short step
+        mEvents.Push(LevelEndDelay - mLevelEndTimer - 2 * EventMargin, EventQueue::Type::Timer);
+    }
+
+    return mEvents.IsEmpty() ? numeric_limits<double>::infinity() : mEvents.Top().mTime;
+}
+
+/**
+ * Run the game forward without drawing, jumping from event to event.
+ *
+ * Products move at a constant speed, so instead of many small updates
+ * this does one update just past each event: a product entering or
+ * leaving the beam, being scored, the last product passing and the
+ * level timers. The beam, the circuit, kicks and scores come out the
+ * same as updating every frame. Only things that are drawn, like the
+ * belt and the boot swinging, move in coarser steps.
+ *
+ * @param duration Seconds to run
+ * @return Number of updates it took
+ */
+int SpartyBoots::FastForward(double duration)
 {
-    for (auto i = mItems.rbegin(); i != mItems.rend();  i++)
+    TRACE_SCOPE("SpartyBoots::FastForward");
+
+    int updates = 0;
+    while (duration > 0)
     {
-        if((*i)->Catch(pinConnector, lineEnd))
+        double step = min(ScheduleEvents() + EventMargin, duration);
+        if (mLogic.GetOscillatingCount() > 0)
         {
-            return;
+            step = min(step, OscillatingStep);
         }
+
+        Update(step);
+        duration -= step;
+        updates++;
     }
+
+    return updates;
 }
 
-void SpartyBoots::MoveToFront(Item* item)
+/**
+ * Will the next frame look different from the last one without any input?
+ * Something is moving, a notice or level timer is running, an item is
+ * being dragged or the circuit is oscillating.
+ * @return true if the game is animating
+ */
+bool SpartyBoots::IsAnimating()
 {
-    // Find the shared_ptr corresponding to rawPtr
-    auto loc = std::find_if(mItems.begin(), mItems.end(),
-                           [item](std::shared_ptr<Item> ptr) {
-                               return ptr.get() == item;
-                           });
-    auto itemPtr = *loc;
-    if (loc != end(mItems))
+    if (mShowingBegin || mShowingComplete || mLevelEndTimer > 0 || mGrabbedItem != nullptr ||
+        mLogic.GetOscillatingCount() > 0)
     {
-        mItems.erase(loc);
+        return true;
     }
 
-    mItems.push_back(itemPtr);
+    MotionVisitor visitor;
+    mItems.VisitLevelItems(visitor);
+
+    return visitor.IsMoving();
 }
 
-void SpartyBoots::TopologicalComputing(Sensor* sensor, Beam* beam, Sparty* sparty, std::vector<LogicGate*> gates)
+void SpartyBoots::TryToCatch(PinConnector* pinConnector, wxPoint lineEnd)
 {
-    std::vector<std::shared_ptr<OutputPin>> outPins;        // Get the sensor and beam pins into a vector we can manipulate
-    std::vector<InputPin*> inPins;  // Changed to InputPin* type
-    //Get beam output pin in
-    outPins.push_back(beam->getPins()[0]);
+    // Only input pins catch wires. They belong to the gates and
+    // Sparty, so an item is skipped when the end is nowhere near its pins.
+    std::vector<PinOwner *> owners;
+    auto &gates = mItems.GetGates();
+    for (auto i = gates.rbegin(); i != gates.rend(); i++)
+    {
+        owners.push_back(i->get());
+    }
+    if (mItems.GetSparty() != nullptr)
+    {
+        owners.push_back(mItems.GetSparty());
+    }
 
-    if (sensor != nullptr)
+    for (auto owner : owners)
     {
-        // Populate outPins with sensor pins
-        for (auto sensorPins : sensor->getPins())
+        if (!owner->PinBoundsContain(lineEnd.x, lineEnd.y))
         {
-            outPins.push_back(sensorPins);
+            continue;
         }
-    }
-    while (!outPins.empty())   // Do this until there's no more output pins to consider
-    {
-        // Iterate over the output pins, update the values, delete the output pins that were updated and put in inPins new inputPins
-        for (auto outputPin : outPins)
+
+        for (auto &pin : owner->GetInputPins())
         {
-            if (!(outputPin->getConnector()).empty())
+            if (pin->Catch(pinConnector, lineEnd))
             {
-                // Call UpdateValues on the output pin
-                outputPin->UpdateValues();
-
-                // Add connected input pins to inPins
-                for (auto pinConnection : outputPin->getConnector()) {
-                    inPins.push_back(pinConnection->getCaught()); // Ensure getCaught() returns InputPin*
-                }
+                return;
             }
         }
+    }
+}
+
+void SpartyBoots::MoveToFront(Item* item)
+{
+    mItems.MoveToFront(item);
+}
 
-        outPins.clear();   // Remove the outPins anyways, since if outPin doesn't result in change of input, it's cut off
+void SpartyBoots::TopologicalComputing(Sensor* sensor, Beam* beam, Sparty* sparty, const std::vector<std::shared_ptr<LogicGate>> &gates)
+{
+    TRACE_SCOPE("SpartyBoots::TopologicalComputing");
 
-        // Iterate over the gates, and see if any of them are activated completely, then compute their output, and adding it to outputPins
-        if (!gates.empty())
+    // The gates are only walked when the wiring changes, see LogicNetwork
+    if (!mLogic.IsBuilt() || mLogic.SourcesChanged())
+    {
+        TRACE_SCOPE("LogicNetwork::Build");
+        std::vector<LogicGate *> network;
+        for (auto &gate : gates)
         {
-            auto it = gates.begin();
-            while (it != gates.end()) {
-                // Get the input pins for the current gate
-                auto gateInputPins = (*it)->GetInputPins();
-
-                // Check if all input pins of the gate are in the inPins vector
-                bool allInPins = std::all_of(gateInputPins.begin(), gateInputPins.end(), [&inPins](const std::shared_ptr<InputPin>& pin) {
-                    return std::find(inPins.begin(), inPins.end(), pin.get()) != inPins.end(); // Use pin.get() to compare raw pointer
-                });
-
-                if (allInPins) {
-                    // Compute the gate results
-                    (*it)->GateCompute();
-                    for (auto outputPins : (*it)->GetOutputPins())
-                    {
-                        outPins.push_back(outputPins);
-                    }
-                    // Remove the gate from the list
-                    it = gates.erase(it); // erase() returns the next iterator
-                } else {
-                    ++it; // Move to the next gate
-                }
-            }
+            network.push_back(gate.get());
         }
+        mLogic.Build(sensor, beam, sparty, network);
     }
-
-
+    mLogic.Evaluate();
 }
\ No newline at end of file
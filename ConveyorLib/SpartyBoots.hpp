@@ -11,6 +11,16 @@
 #include <memory>
 #include <vector>
 #include "Conveyor.hpp"
+#include "DrawCommands.hpp"
+#include "EventQueue.hpp"
+#include "FrameStats.hpp"
+#include "InputRecorder.hpp"
+#include "ItemStore.hpp"
+#include "LogicNetwork.hpp"
+#include "ProductQueue.hpp"
+#include "ProductSprites.hpp"
+#include "Snapshot.hpp"
+#include "WireBatch.hpp"
 #include "ItemVisitor.hpp"
 #include "PinConnector.h"
 /**
@@ -24,12 +34,14 @@ class Item;
  */
 class SpartyBoots {
 private:
-    /// All of the items to populate our SpartyBoots
-    std::vector<std::shared_ptr<Item>> mItems;
+    /// All of the items to populate our SpartyBoots, by kind and in drawing order
+    ItemStore mItems;
     std::unique_ptr<wxBitmap> mBackground; ///< Background image to use
-    double mScale;                         ///< scale of virtual pixel
-    double mXOffset;                       ///< Xoffset to calculate virtual pixel
-    double mYOffset;                       ///< Yoffset to calculate virtual pixel
+    double mScale = 1;                     ///< scale of virtual pixel
+    double mXOffset = 0;                   ///< Xoffset to calculate virtual pixel
+    double mYOffset = 0;                   ///< Yoffset to calculate virtual pixel
+    int mViewWidth = 0;                    ///< width of the window we draw into
+    int mViewHeight = 0;                   ///< height of the window we draw into
     int mCurrentLevel;                     ///< keep track of current level
     int mPixelWidth;
     int mPixelHeight;
@@ -48,11 +60,49 @@ private:
     bool mLevelEnd = false;
     ///level ended timer
     double mLevelEndTimer = 0;
+    /// Frame timing statistics for the performance HUD
+    FrameStats mFrameStats;
+    /// Is the performance HUD shown?
+    bool mShowFrameStats = false;
+    /// Any item we are currently dragging
+    std::shared_ptr<IDraggable> mGrabbedItem;
+    /// Number of updates so far, the timestamp for recorded input
+    long mTick = 0;
+    /// Input recorder, nullptr when not recording
+    std::shared_ptr<InputRecorder> mRecorder;
+    /// History of snapshots for rewinding
+    SnapshotRing mSnapshots;
+    /// Updates since the last snapshot
+    int mTicksSinceSnapshot = 0;
+    /// Writer the snapshots are taken with, kept so its memory is reused
+    SnapshotWriter mSnapshotWriter;
+    /// The wired gates compiled for evaluation, rebuilt when the wiring changes
+    LogicNetwork mLogic;
 
+    void WriteSnapshot(SnapshotWriter &writer);
+    /// Upcoming events, for fast-forwarding
+    EventQueue mEvents;
+    /// The products in the order they reach the beam
+    ProductQueue mProducts;
+    /// Products that broke the beam this tick, kept to reuse its storage
+    std::vector<Product *> mProductsInBeam;
+    /// Wires collected while drawing, stroked after the items
+    WireBatch mWires;
+    /// Products collected while drawing, blitted after the items
+    ProductSprites mProductSprites;
+    /// The frame being drawn, recorded and then replayed
+    DrawCommands mDrawCommands;
 
+    OutputPin *FindLevelOutputPin(const wxString &name, Sensor *sensor, Beam *beam,
+                                  const std::vector<std::shared_ptr<LogicGate>> &gates);
+    InputPin *FindLevelInputPin(const wxString &name, Sparty *sparty,
+                                const std::vector<std::shared_ptr<LogicGate>> &gates);
+    std::shared_ptr<LogicGate> CreateGate(const wxString &type);
+    void Record(InputRecorder::Type type, double a = 0, double b = 0, const wxString &text = wxString());
 
 public:
-    void OnDraw(std::shared_ptr<wxGraphicsContext> graphics, int, int);
+    void OnDraw(const std::shared_ptr<wxGraphicsContext> &graphics, int, int);
+    void Draw(DrawCommands &graphics, int width, int height);
     SpartyBoots(wxWindow *parent);
     /**
      * return Scale to calculate virtual pixel
@@ -78,11 +128,22 @@ public:
     {
         return mYOffset;
     }
-    void Add(std::shared_ptr<Item> item);
+    void Add(std::shared_ptr<LogicGate> gate);
     std::shared_ptr<IDraggable> HitTest(int x, int y);
+    void Grab(int x, int y);
+    void Drag(int x, int y);
+    void Release();
+    /**
+     * Is an item being dragged?
+     * @return true if an item is grabbed
+     */
+    bool IsGrabbing() const { return mGrabbedItem != nullptr; }
+    void SetViewSize(int width, int height);
     void OnLeftDown(int x, int y);
     void OnLevelSelect(int level);
     void LevelLoad(int level);
+    void LevelLoad(const wxString &levelFileName, int level);
+    std::shared_ptr<LogicGate> AddGate(const wxString &type);
 
     /**
  * Insert the item to the list of item
@@ -90,18 +151,89 @@ public:
  */
     void InsertItem(std::shared_ptr<Item> item);
     void Update(double elapsed);
-    /// function for getting items
-    std::vector<std::shared_ptr<Item>> GetItems()
-    {
-        return mItems;
-    };
+    int FastForward(double duration);
+    double ScheduleEvents();
+    bool IsAnimating();
+    /**
+     * Get the events found by the last ScheduleEvents
+     * @return event queue
+     */
+    const EventQueue &GetEvents() const { return mEvents; }
+    /**
+     * Get the products in the order they reach the beam
+     * @return product queue
+     */
+    const ProductQueue &GetProducts() const { return mProducts; }
+    /**
+     * Get the wires being collected for the frame being drawn
+     * @return wire batch
+     */
+    WireBatch &GetWires() { return mWires; }
+    /**
+     * Get the products being collected for the frame being drawn
+     * @return product sprites
+     */
+    ProductSprites &GetProductSprites() { return mProductSprites; }
+    std::vector<std::shared_ptr<Item>> GetItems() const;
+    /**
+     * Get the items by kind
+     * @return item store
+     */
+    const ItemStore &GetItemStore() const { return mItems; }
     /// Attempts to catch an input pin and connect them
     void TryToCatch(PinConnector* pinConnector, wxPoint lineEnd);
     /// Moves an item to the front of the drawing order
     void MoveToFront(Item* item);
     /// function for topologically calculating the gates. Needs to know the sensor and beam output pins to start, the sparty pins to stop,
     /// and the logic gates to check.
-    void TopologicalComputing(Sensor* sensor, Beam* beam, Sparty* sparty, std::vector<LogicGate*> gates);
+    void TopologicalComputing(Sensor* sensor, Beam* beam, Sparty* sparty, const std::vector<std::shared_ptr<LogicGate>> &gates);
+    /**
+     * The wiring changed, so the compiled circuit has to be rebuilt
+     */
+    void WiringChanged() { mLogic.Invalidate(); }
+    /**
+     * Get the compiled circuit
+     * @return logic network
+     */
+    const LogicNetwork &GetLogic() const { return mLogic; }
+
+    /**
+     * Get the frame timing statistics
+     * @return frame statistics
+     */
+    FrameStats &GetFrameStats() { return mFrameStats; }
+    /**
+     * Show or hide the performance HUD
+     * @param show True to show the HUD
+     */
+    void SetShowFrameStats(bool show) { mShowFrameStats = show; }
+    /**
+     * Is the performance HUD shown?
+     * @return true if shown
+     */
+    bool IsShowingFrameStats() const { return mShowFrameStats; }
+
+    void SetRecorder(std::shared_ptr<InputRecorder> recorder);
+    /**
+     * Get the input recorder
+     * @return recorder or nullptr if not recording
+     */
+    std::shared_ptr<InputRecorder> GetRecorder() const { return mRecorder; }
+    /**
+     * Get the current level number
+     * @return level
+     */
+    int GetCurrentLevel() const { return mCurrentLevel; }
+
+    std::vector<uint8_t> SaveSnapshot();
+    const std::vector<uint8_t> &WriteSnapshot();
+    bool RestoreSnapshot(const std::vector<uint8_t> &snapshot);
+    bool Rewind(long ticks);
+    /**
+     * Get the snapshot history, for scrubbing through it
+     * @return snapshot ring
+     */
+    const SnapshotRing &GetSnapshots() const { return mSnapshots; }
 
 };
 
@@ -5,18 +5,20 @@
 
 #include "pch.h"
 #include "SpartyBootsView.hpp"
+#include <algorithm>
 #include <string>
 #include <vector>
-#include <wx/dcbuffer.h>
-#include "AndGate.hpp"
+#include <wx/dcclient.h>
+#include <wx/dcmemory.h>
+#include <wx/display.h>
 #include "ids.hpp"
-#include "NotGate.hpp"
-#include "OrGate.hpp"
-#include "SRFlipFlop.h"
-#include "DFlipFlop.h"
+#include "Trace.hpp"
 
-/// Frame duration in milliseconds
-const int FrameDuration = 30;
+/// Refresh rate to animate at when the display doesn't report one, in Hz
+const int DefaultRefreshRate = 60;
+
+/// Number of frames Rewind goes back, about three seconds
+const int RewindFrames = 100;
 
 /**
  * Initialization of our view object and declaring the parent frame
@@ -31,6 +33,8 @@ void SpartyBootsView::Initialize(wxFrame *parent)
     Bind(wxEVT_LEFT_DOWN, &SpartyBootsView::OnLeftDown, this);
     Bind(wxEVT_MOTION, &SpartyBootsView::OnMouseMove, this);
     Bind(wxEVT_TIMER, &SpartyBootsView::OnTimer, this);
+    Bind(wxEVT_SHOW, &SpartyBootsView::OnShow, this);
+    parent->Bind(wxEVT_ICONIZE, &SpartyBootsView::OnIconize, this);
 
     parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &SpartyBootsView::OnOrGate, this, IDM_ORGATE);
     parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &SpartyBootsView::OnAndGate, this, IDM_ANDGATE);
@@ -46,10 +50,48 @@ void SpartyBootsView::Initialize(wxFrame *parent)
     parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &SpartyBootsView::OnLevel7, this, IDM_LEVEL7);
     parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &SpartyBootsView::OnLevel8, this, IDM_LEVEL8);
     parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &SpartyBootsView::OnExit, this, wxID_EXIT);
+    parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &SpartyBootsView::OnPerformanceHud, this, IDM_PERFHUD);
+    parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &SpartyBootsView::OnRecordInput, this, IDM_RECORDINPUT);
+    parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &SpartyBootsView::OnRewind, this, IDM_REWIND);
 
     mTimer.SetOwner(this);
-    mTimer.Start(FrameDuration);
     mStopWatch.Start();
+    Wake();
+}
+
+/**
+ * Start animating again after the view went idle or was hidden.
+ * The time spent asleep doesn't count as game time.
+ */
+void SpartyBootsView::Wake()
+{
+    if (!mTimer.IsRunning())
+    {
+        mTime = mStopWatch.Time();
+        mTimer.Start(GetFrameDuration());
+    }
+
+    Refresh();
+}
+
+/**
+ * Time between frames, one refresh of the display the view is on
+ * @return frame duration in milliseconds
+ */
+int SpartyBootsView::GetFrameDuration()
+{
+    int refreshRate = DefaultRefreshRate;
+    int index = wxDisplay::GetFromWindow(this);
+    if (index != wxNOT_FOUND)
+    {
+        int displayRate = wxDisplay(index).GetCurrentMode().refresh;
+        if (displayRate > 0)
+        {
+            refreshRate = displayRate;
+        }
+    }
+
+    return std::max(1, 1000 / refreshRate);
 }
 
 /**
@@ -58,27 +100,71 @@ void SpartyBootsView::Initialize(wxFrame *parent)
  */
 void SpartyBootsView::OnPaint(wxPaintEvent &event)
 {
+    TRACE_SCOPE("SpartyBootsView::OnPaint");
+
     // Compute the time that has elapsed
     // since the last call to OnPaint.
     auto newTime = mStopWatch.Time();
     auto elapsed = (double)(newTime - mTime) * 0.001;
     mTime = newTime;
 
-    mSpartyBoots.Update(elapsed);
+    // While asleep the game is still, a paint only redraws it
+    auto updateStart = FrameStats::Clock::now();
+    if (mTimer.IsRunning())
+    {
+        mSpartyBoots.Update(elapsed);
+    }
+    double updateMs = FrameStats::MillisecondsSince(updateStart);
+
+    wxPaintDC dc(this);
 
-    wxAutoBufferedPaintDC dc(this);
+    // Draw into the back buffer, then copy it to the window in one go
+    wxSize size = GetClientSize();
+    if (!PrepareBuffer(size))
+    {
+        return;
+    }
 
     // wxBrush background(*wxGREEN);//230, 255, 230 rgb
     wxBrush background(wxColour(230, 255, 230));
-    dc.SetBackground(background);
-    dc.Clear();
-
-    // Create a graphics context
-    auto gc = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(dc));
+    mGraphics->SetBrush(background);
+    mGraphics->SetPen(*wxTRANSPARENT_PEN);
+    mGraphics->DrawRectangle(0, 0, size.GetWidth(), size.GetHeight());
 
     // Tell the game class to draw
-    wxRect rect = GetRect();
-    mSpartyBoots.OnDraw(gc, rect.GetWidth(), rect.GetHeight());
+    auto drawStart = FrameStats::Clock::now();
+    mSpartyBoots.OnDraw(mGraphics, size.GetWidth(), size.GetHeight());
+    mGraphics->Flush();
+    dc.Blit(0, 0, size.GetWidth(), size.GetHeight(), &mBufferDC, 0, 0);
+    mSpartyBoots.GetFrameStats().AddFrame(updateMs, FrameStats::MillisecondsSince(drawStart));
+}
+
+/**
+ * Make sure the back buffer and its graphics context match the window.
+ * They are kept from frame to frame and only made again when the
+ * window is resized.
+ * @param size Client size of the window
+ * @return true if there is a buffer to draw on
+ */
+bool SpartyBootsView::PrepareBuffer(const wxSize &size)
+{
+    if (mGraphics != nullptr && mBuffer.IsOk() && mBuffer.GetSize() == size)
+    {
+        return true;
+    }
+
+    // The context draws into the bitmap, so it goes first
+    mGraphics.reset();
+    mBufferDC.SelectObject(wxNullBitmap);
+    if (size.GetWidth() <= 0 || size.GetHeight() <= 0)
+    {
+        return false;
+    }
+
+    mBuffer = wxBitmap(size);
+    mBufferDC.SelectObject(mBuffer);
+    mGraphics.reset(wxGraphicsContext::Create(mBufferDC));
+    return mGraphics != nullptr;
 }
 
 /**
@@ -87,10 +173,9 @@ void SpartyBootsView::OnPaint(wxPaintEvent &event)
  */
 void SpartyBootsView::OnOrGate(wxCommandEvent &event)
 {
-    auto orGate = std::make_shared<OrGate>(&mSpartyBoots);
-    mSpartyBoots.Add(orGate);
+    mSpartyBoots.AddGate(L"or");
 
-    // Refresh();
+    Wake();
 }
 
 /**
@@ -99,10 +184,9 @@ void SpartyBootsView::OnOrGate(wxCommandEvent &event)
  */
 void SpartyBootsView::OnAndGate(wxCommandEvent &event)
 {
-    auto andGate = std::make_shared<AndGate>(&mSpartyBoots);
-    mSpartyBoots.Add(andGate);
+    mSpartyBoots.AddGate(L"and");
 
-    // Refresh();
+    Wake();
 }
 /**
  * On NotGate event
@@ -110,11 +194,9 @@ void SpartyBootsView::OnAndGate(wxCommandEvent &event)
  */
 void SpartyBootsView::OnNotGate(wxCommandEvent &event)
 {
-    auto notGate = std::make_shared<NotGate>(&mSpartyBoots);
-    notGate->SetLocation(150, 150);
-    mSpartyBoots.Add(notGate);
+    mSpartyBoots.AddGate(L"not");
 
-    // Refresh();
+    Wake();
 }
 /**
  * On SRFlipFlop event
@@ -122,10 +204,9 @@ void SpartyBootsView::OnNotGate(wxCommandEvent &event)
  */
 void SpartyBootsView::OnSRFlipFlop(wxCommandEvent &event)
 {
-    auto sRFlipFlop = std::make_shared<SRFlipFlop>(&mSpartyBoots);
-    mSpartyBoots.Add(sRFlipFlop);
+    mSpartyBoots.AddGate(L"sr");
 
-    // Refresh();
+    Wake();
 }
 /**
  * On DFlipFlop event
@@ -133,10 +214,9 @@ void SpartyBootsView::OnSRFlipFlop(wxCommandEvent &event)
  */
 void SpartyBootsView::OnDFlipFlop(wxCommandEvent &event)
 {
-    auto dFlipFlop = std::make_shared<DFlipFlop>(&mSpartyBoots);
-    mSpartyBoots.Add(dFlipFlop);
+    mSpartyBoots.AddGate(L"d");
 
-    // Refresh();
+    Wake();
 }
 
 /**
@@ -145,7 +225,8 @@ void SpartyBootsView::OnDFlipFlop(wxCommandEvent &event)
  */
 void SpartyBootsView::OnLeftDown(wxMouseEvent &event)
 {
-    mGrabbedItem = mSpartyBoots.HitTest(event.GetX(), event.GetY());
+    mSpartyBoots.Grab(event.GetX(), event.GetY());
+    Wake();
 }
 
 /**
@@ -155,26 +236,23 @@ void SpartyBootsView::OnLeftDown(wxMouseEvent &event)
 void SpartyBootsView::OnMouseMove(wxMouseEvent &event)
 {
     // See if an item is currently being moved by the mouse
-    if (mGrabbedItem != nullptr)
+    if (mSpartyBoots.IsGrabbing())
     {
         // If an item is being moved, we only continue to
         // move it while the left button is down.
         if (event.LeftIsDown())
         {
-            double virtualX = (event.GetX() - mSpartyBoots.getXOffset()) / mSpartyBoots.getScale();
-            double virtualY = (event.GetY() - mSpartyBoots.getYOffset()) / mSpartyBoots.getScale();
-            mGrabbedItem->SetLocation(virtualX, virtualY);
+            mSpartyBoots.Drag(event.GetX(), event.GetY());
         }
         else
         {
             // When the left button is released, we release the
             // item.
-            mGrabbedItem->Release();
-            mGrabbedItem = nullptr;
+            mSpartyBoots.Release();
         }
 
         // Force the screen to redraw
-        // Refresh();
+        Wake();
     }
 }
 
@@ -185,7 +263,7 @@ void SpartyBootsView::OnMouseMove(wxMouseEvent &event)
 void SpartyBootsView::OnLevel1(wxCommandEvent &event)
 {
     mSpartyBoots.OnLevelSelect(1);
-    // Refresh();
+    Wake();
 }
 
 /**
@@ -195,7 +273,7 @@ void SpartyBootsView::OnLevel1(wxCommandEvent &event)
 void SpartyBootsView::OnLevel2(wxCommandEvent &event)
 {
     mSpartyBoots.OnLevelSelect(2);
-    // Refresh();
+    Wake();
 }
 
 /**
@@ -205,7 +283,7 @@ void SpartyBootsView::OnLevel2(wxCommandEvent &event)
 void SpartyBootsView::OnLevel3(wxCommandEvent &event)
 {
     mSpartyBoots.OnLevelSelect(3);
-    // Refresh();
+    Wake();
 }
 
 /**
@@ -215,7 +293,7 @@ void SpartyBootsView::OnLevel3(wxCommandEvent &event)
 void SpartyBootsView::OnLevel4(wxCommandEvent &event)
 {
     mSpartyBoots.OnLevelSelect(4);
-    // Refresh();
+    Wake();
 }
 
 /**
@@ -225,7 +303,7 @@ void SpartyBootsView::OnLevel4(wxCommandEvent &event)
 void SpartyBootsView::OnLevel5(wxCommandEvent &event)
 {
     mSpartyBoots.OnLevelSelect(5);
-    // Refresh();
+    Wake();
 }
 
 /**
@@ -235,7 +313,7 @@ void SpartyBootsView::OnLevel5(wxCommandEvent &event)
 void SpartyBootsView::OnLevel6(wxCommandEvent &event)
 {
     mSpartyBoots.OnLevelSelect(6);
-    // Refresh();
+    Wake();
 }
 
 /**
@@ -245,7 +323,7 @@ void SpartyBootsView::OnLevel6(wxCommandEvent &event)
 void SpartyBootsView::OnLevel7(wxCommandEvent &event)
 {
     mSpartyBoots.OnLevelSelect(7);
-    // Refresh();
+    Wake();
 }
 
 /**
@@ -255,7 +333,7 @@ void SpartyBootsView::OnLevel7(wxCommandEvent &event)
 void SpartyBootsView::OnLevel8(wxCommandEvent &event)
 {
     mSpartyBoots.OnLevelSelect(8);
-    // Refresh();
+    Wake();
 }
 
 /**
@@ -271,9 +349,83 @@ void SpartyBootsView::OnTimer(wxTimerEvent &event)
         // Close(true);
         return;
     }
+
+    // Sleep until something changes, or until the view can be seen again
+    if (!IsShownOnScreen() || !mSpartyBoots.IsAnimating())
+    {
+        mTimer.Stop();
+        return;
+    }
+
     Refresh();
 }
 
+/**
+ * Sleep while the view is hidden and wake when it is shown
+ * @param event The show event
+ */
+void SpartyBootsView::OnShow(wxShowEvent &event)
+{
+    if (event.IsShown())
+    {
+        Wake();
+    }
+    else
+    {
+        mTimer.Stop();
+    }
+    event.Skip();
+}
+
+/**
+ * Sleep while the frame is minimized and wake when it is restored
+ * @param event The iconize event
+ */
+void SpartyBootsView::OnIconize(wxIconizeEvent &event)
+{
+    if (event.IsIconized())
+    {
+        mTimer.Stop();
+    }
+    else
+    {
+        Wake();
+    }
+    event.Skip();
+}
+
+/**
+ * Toggle the performance HUD
+ * @param event The menu event, checked when the HUD should be shown
+ */
+void SpartyBootsView::OnPerformanceHud(wxCommandEvent &event)
+{
+    mSpartyBoots.SetShowFrameStats(event.IsChecked());
+    mSpartyBoots.GetFrameStats().Reset();
+    Wake();
+}
+
+/**
+ * Start or stop recording input. Recording restarts the
+ * current level so a replay starts from the same state.
+ * The recording is saved to input.log when it stops.
+ * @param event The menu event, checked when recording should start
+ */
+void SpartyBootsView::OnRecordInput(wxCommandEvent &event)
+{
+    if (event.IsChecked())
+    {
+        mSpartyBoots.SetRecorder(std::make_shared<InputRecorder>());
+        mSpartyBoots.OnLevelSelect(mSpartyBoots.GetCurrentLevel());
+    }
+    else if (mSpartyBoots.GetRecorder() != nullptr)
+    {
+        mSpartyBoots.GetRecorder()->Save(L"input.log");
+        mSpartyBoots.SetRecorder(nullptr);
+    }
+    Wake();
+}
+
 /**
  * on exit event
  * @param event
@@ -281,7 +433,18 @@ void SpartyBootsView::OnTimer(wxTimerEvent &event)
 void SpartyBootsView::OnExit(wxCommandEvent &event)
 {
     mClose = true;
+    Wake();
     // wxQueueEvent(this, new wxCommandEvent(wxEVT_CLOSE_WINDOW));
     // Close(true);
     // Destroy();
 }
+
+/**
+ * Rewind the game a few seconds
+ * @param event The menu event
+ */
+void SpartyBootsView::OnRewind(wxCommandEvent &event)
+{
+    mSpartyBoots.Rewind(RewindFrames);
+    Wake();
+}
@@ -7,6 +7,8 @@
 
 #ifndef CONVEYORVIEW_H
 #define CONVEYORVIEW_H
+#include <memory>
+#include <wx/dcmemory.h>
 #include "SpartyBoots.hpp"
 
 /**
@@ -19,7 +21,7 @@ private:
     /// The game object
     SpartyBoots mSpartyBoots;
 
-    /// The timer that allows for animation
+    /// The timer that allows for animation, stopped while nothing moves
     wxTimer mTimer;
 
     /// Stopwatch used to measure elapsed time
@@ -28,8 +30,18 @@ private:
     /// The last stopwatch time
     long mTime = 0;
 
-    /// Any item we are currently dragging
-    std::shared_ptr<IDraggable> mGrabbedItem;
+    /// Back buffer the frame is drawn into, the size of the window
+    wxBitmap mBuffer;
+
+    /// Memory DC the back buffer is selected into
+    wxMemoryDC mBufferDC;
+
+    /// Graphics context on the back buffer, kept from frame to frame
+    std::shared_ptr<wxGraphicsContext> mGraphics;
+
+    bool PrepareBuffer(const wxSize &size);
+
+    int GetFrameDuration();
 
 public:
     /**
@@ -49,12 +61,18 @@ public:
     void OnLevel7(wxCommandEvent &event);
     void OnLevel8(wxCommandEvent &event);
     void OnTimer(wxTimerEvent &event);
+    void OnShow(wxShowEvent &event);
+    void OnIconize(wxIconizeEvent &event);
+    void Wake();
     void OnOrGate(wxCommandEvent &event);
     void OnAndGate(wxCommandEvent &event);
     void OnNotGate(wxCommandEvent &event);
     void OnSRFlipFlop(wxCommandEvent &event);
     void OnDFlipFlop(wxCommandEvent &event);
     void OnExit(wxCommandEvent &event);
+    void OnPerformanceHud(wxCommandEvent &event);
+    void OnRecordInput(wxCommandEvent &event);
+    void OnRewind(wxCommandEvent &event);
     /**
      * stops the timer
      */
@@ -0,0 +1,99 @@
+/**
+ * @file Trace.cpp
+ * @author Alex Mueller
+ */
+
+#include "pch.h"
+#include "Trace.hpp"
+
+#ifdef SPARTY_TRACE
+
+#include <fstream>
+
+/**
+ * Get the process wide recorder
+ * @return recorder
+ */
+TraceRecorder &TraceRecorder::Instance()
+{
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+/**
+ * Destructor, the buffers live as long as the recorder
+ */
+TraceRecorder::~TraceRecorder()
+{
+    auto buffer = mBuffers.load();
+    while (buffer != nullptr)
+    {
+        auto next = buffer->mNext;
+        delete buffer;
+        buffer = next;
+    }
+}
+
+/**
+ * Get the buffer of the calling thread, creating it on first use.
+ * New buffers are pushed on the list with a compare and swap.
+ * @return buffer for this thread
+ */
+TraceBuffer &TraceRecorder::ThreadBuffer()
+{
+    thread_local TraceBuffer *buffer = nullptr;
+    if (buffer == nullptr)
+    {
+        buffer = new TraceBuffer(mNextThreadId.fetch_add(1));
+        buffer->mNext = mBuffers.load(std::memory_order_relaxed);
+        while (!mBuffers.compare_exchange_weak(buffer->mNext, buffer, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    return *buffer;
+}
+
+/**
+ * Write the recorded events in Chrome trace_event format.
+ * Open the file in chrome://tracing or ui.perfetto.dev.
+ * @param filename File to write
+ * @return true if the file was written
+ */
+bool TraceRecorder::Write(const std::string &filename) const
+{
+    std::ofstream out(filename);
+    if (!out)
+    {
+        return false;
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (auto buffer = mBuffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->mNext)
+    {
+        auto count = buffer->mCount.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; i++)
+        {
+            auto &event = buffer->mEvents[i];
+            out << (first ? "\n" : ",\n");
+            out << "{\"name\":\"" << event.mName << "\",\"cat\":\"sparty\",\"ph\":\"X\",\"pid\":1"
+                << ",\"tid\":" << buffer->mThreadId << ",\"ts\":" << event.mStart << ",\"dur\":" << event.mDuration << "}";
+            first = false;
+        }
+
+        auto dropped = buffer->mDropped.load(std::memory_order_relaxed);
+        if (dropped > 0)
+        {
+            out << (first ? "\n" : ",\n");
+            out << "{\"name\":\"dropped events\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":" << buffer->mThreadId
+                << ",\"ts\":" << Now() << ",\"args\":{\"count\":" << dropped << "}}";
+            first = false;
+        }
+    }
+    out << "\n]}\n";
+
+    return bool(out);
+}
+
+#endif // SPARTY_TRACE
@@ -0,0 +1,157 @@
+/**
+ * @file Trace.hpp
+ * @author Alex Mueller
+ *
+ * Scoped timing instrumentation written out as Chrome trace_event JSON.
+ *
+ * Build with -DSPARTY_TRACE=ON to record. Otherwise the TRACE_ macros
+ * expand to nothing and none of this is compiled.
+ */
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#ifdef SPARTY_TRACE
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * One completed scope
+ */
+struct TraceEvent
+{
+    /// Name of the scope, must be a string literal
+    const char *mName;
+    /// Start time in microseconds since the recorder started
+    int64_t mStart;
+    /// Duration in microseconds
+    int64_t mDuration;
+};
+
+/**
+ * Events recorded by a single thread. Only the owning thread
+ * appends; the writer reads up to the published count, so no
+ * locks are needed on either side.
+ */
+class TraceBuffer {
+public:
+    /// Maximum number of events kept per thread
+    static const size_t Capacity = 1 << 18;
+
+    /**
+     * Constructor
+     * @param threadId Id written as the tid of every event
+     */
+    explicit TraceBuffer(int threadId) : mThreadId(threadId) {}
+
+    /**
+     * Append an event, dropping it if the buffer is full
+     * @param event Event to add
+     */
+    void Add(const TraceEvent &event)
+    {
+        auto count = mCount.load(std::memory_order_relaxed);
+        if (count == Capacity)
+        {
+            mDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        mEvents[count] = event;
+        mCount.store(count + 1, std::memory_order_release);
+    }
+
+    /// Events recorded so far
+    TraceEvent mEvents[Capacity];
+    /// Number of events published to readers
+    std::atomic<size_t> mCount{0};
+    /// Number of events dropped because the buffer was full
+    std::atomic<size_t> mDropped{0};
+    /// Thread id for the JSON output
+    int mThreadId;
+    /// Next buffer in the recorder's list
+    TraceBuffer *mNext = nullptr;
+};
+
+/**
+ * Owns the per-thread buffers and writes them to a file
+ */
+class TraceRecorder {
+public:
+    static TraceRecorder &Instance();
+
+    /// Clock used for the timestamps
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Microseconds since the recorder was created
+     * @return timestamp
+     */
+    int64_t Now() const
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - mEpoch).count();
+    }
+
+    TraceBuffer &ThreadBuffer();
+    bool Write(const std::string &filename) const;
+
+    ~TraceRecorder();
+
+private:
+    TraceRecorder() = default;
+
+    /// Time zero for the timestamps
+    Clock::time_point mEpoch = Clock::now();
+    /// Head of the list of thread buffers
+    std::atomic<TraceBuffer *> mBuffers{nullptr};
+    /// Id handed to the next thread that records
+    std::atomic<int> mNextThreadId{1};
+};
+
+/**
+ * Records the lifetime of a scope as a complete ("X") event
+ */
+class TraceScope {
+public:
+    /**
+     * Constructor, starts the timer
+     * @param name Name of the scope, must be a string literal
+     */
+    explicit TraceScope(const char *name) : mName(name), mStart(TraceRecorder::Instance().Now()) {}
+
+    /**
+     * Destructor, records the event
+     */
+    ~TraceScope()
+    {
+        auto &recorder = TraceRecorder::Instance();
+        recorder.ThreadBuffer().Add({mName, mStart, recorder.Now() - mStart});
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    void operator=(const TraceScope &) = delete;
+
+private:
+    /// Name of the scope
+    const char *mName;
+    /// Start time in microseconds
+    int64_t mStart;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+/// Time the enclosing scope under the given name
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+/// Write everything recorded so far to a file
+#define TRACE_WRITE(filename) TraceRecorder::Instance().Write(filename)
+
+#else
+
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_WRITE(filename) ((void)0)
+
+#endif // SPARTY_TRACE
+
+#endif // TRACE_HPP
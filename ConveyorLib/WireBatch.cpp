@@ -0,0 +1,55 @@
+/**
+ * @file WireBatch.cpp
+ * @author Alex Mueller
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include <cmath>
+#include "WireBatch.hpp"
+#include "DrawCommands.hpp"
+
+/**
+ * Work out the curve of a wire from an output pin to a point
+ * @param from Output pin location
+ * @param to Input pin or mouse location
+ * @return curve
+ */
+WireBatch::Curve WireBatch::MakeCurve(const wxPoint2DDouble &from, const wxPoint2DDouble &to)
+{
+    // The control points leave the output to the right and enter the input from the left
+    double distance = std::hypot(to.m_x - from.m_x, to.m_y - from.m_y);
+    double offset = std::min(BezierMaxOffset, distance);
+
+    return {from, wxPoint2DDouble(from.m_x + offset, from.m_y), wxPoint2DDouble(to.m_x - offset, to.m_y), to};
+}
+
+/**
+ * Stroke the wires collected this frame and start collecting the next
+ * @param graphics Graphics context to draw on
+ */
+void WireBatch::Stroke(DrawCommands &graphics)
+{
+    const wxColour colors[StateCount] = {ConnectionColorUnknown, ConnectionColorZero, ConnectionColorOne};
+
+    for (int state = 0; state < StateCount; state++)
+    {
+        auto &curves = mCurves[state];
+        if (curves.empty())
+        {
+            continue;
+        }
+
+        auto path = graphics.CreatePath();
+        for (auto &curve : curves)
+        {
+            path.MoveToPoint(curve.mP1.m_x, curve.mP1.m_y);
+            path.AddCurveToPoint(curve.mP2.m_x, curve.mP2.m_y, curve.mP3.m_x, curve.mP3.m_y, curve.mP4.m_x,
+                                 curve.mP4.m_y);
+        }
+
+        graphics.SetPen(wxPen(colors[state], LineWidth));
+        graphics.StrokePath(path);
+        curves.clear();
+    }
+}
@@ -0,0 +1,83 @@
+/**
+ * @file WireBatch.hpp
+ * @author Alex Mueller
+ *
+ * The wires drawn in a frame, stroked together by color
+ */
+
+#ifndef WIREBATCH_HPP
+#define WIREBATCH_HPP
+
+#include <memory>
+#include <vector>
+
+class DrawCommands;
+
+/**
+ * Collects the wires as the items draw and strokes them at the end of
+ * the frame, one path per wire color instead of one per wire.
+ *
+ * The wires are drawn over the items, since they are all stroked after
+ * the items are drawn.
+ */
+class WireBatch {
+public:
+    /// State of the signal on a wire, which sets its color
+    enum class State
+    {
+        Unknown, ///< Not computed, or a wire being dragged
+        Zero,    ///< Carrying a zero
+        One      ///< Carrying a one
+    };
+
+    /// The Bezier curve of a wire
+    struct Curve
+    {
+        /// Start, at the output pin
+        wxPoint2DDouble mP1;
+        /// First control point
+        wxPoint2DDouble mP2;
+        /// Second control point
+        wxPoint2DDouble mP3;
+        /// End, at the input pin or the mouse
+        wxPoint2DDouble mP4;
+    };
+
+    /// Color to use for drawing a zero connection wire
+    static inline const wxColour ConnectionColorZero = *wxBLACK;
+    /// Color to use for drawing a one connection wire
+    static inline const wxColour ConnectionColorOne = *wxRED;
+    /// Color to use for drawing an unknown state connection wire
+    static inline const wxColour ConnectionColorUnknown = wxColour(128, 128, 128);
+    /// Line width for drawing wires between pins
+    static constexpr int LineWidth = 3;
+    /// Maximum offset of Bezier control points relative to line ends
+    static constexpr double BezierMaxOffset = 200;
+
+    static Curve MakeCurve(const wxPoint2DDouble &from, const wxPoint2DDouble &to);
+
+    /**
+     * Add a wire to stroke at the end of the frame
+     * @param state State of the signal, for the color
+     * @param curve Curve of the wire
+     */
+    void Add(State state, const Curve &curve) { mCurves[(int)state].push_back(curve); }
+
+    /**
+     * Number of wires collected in a state
+     * @param state State of the signal
+     * @return wires
+     */
+    int GetCount(State state) const { return (int)mCurves[(int)state].size(); }
+
+    void Stroke(DrawCommands &graphics);
+
+private:
+    /// Number of states
+    static constexpr int StateCount = 3;
+
+    /// Wires collected this frame, by state
+    std::vector<Curve> mCurves[StateCount];
+};
+
+#endif // WIREBATCH_HPP
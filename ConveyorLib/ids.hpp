@@ -27,7 +27,10 @@ enum IDs
     IDM_ANDGATE,
     IDM_NOTGATE,
     IDM_SRFLIPFLOP,
-    IDM_DFLIPFLOP
+    IDM_DFLIPFLOP,
+    IDM_PERFHUD,
+    IDM_RECORDINPUT,
+    IDM_REWIND
 };
 
 #endif // IDS_H
@@ -0,0 +1,213 @@
+/**
+ * @file AllocationTest.cpp
+ * @author Alex Mueller
+ *
+ * Checks that the game update doesn't allocate once it is running.
+ * The global operator new is replaced for the whole test program, it
+ * only counts while a test asks it to.
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <wx/filename.h>
+#include <LevelGenerator.hpp>
+#include <LoadLevel.h>
+#include <AndGate.hpp>
+#include <Conveyor.hpp>
+#include <ScoreBoard.hpp>
+#include <SpartyBoots.hpp>
+
+using namespace std;
+
+/// Are allocations being counted?
+static atomic<bool> counting(false);
+
+/// Allocations made while counting
+static atomic<long> allocations(0);
+
+/// Bytes allocated while counting
+static atomic<long> allocatedBytes(0);
+
+/**
+ * Allocate memory, counting the allocation if asked to
+ * @param size Bytes to allocate
+ * @return memory
+ */
+static void *Allocate(size_t size)
+{
+    if (counting)
+    {
+        allocations++;
+        allocatedBytes += (long)size;
+    }
+
+    void *memory = malloc(size == 0 ? 1 : size);
+    if (memory == nullptr)
+    {
+        throw bad_alloc();
+    }
+    return memory;
+}
+
+void *operator new(size_t size) { return Allocate(size); }
+void *operator new[](size_t size) { return Allocate(size); }
+void operator delete(void *memory) noexcept { free(memory); }
+void operator delete[](void *memory) noexcept { free(memory); }
+void operator delete(void *memory, size_t) noexcept { free(memory); }
+void operator delete[](void *memory, size_t) noexcept { free(memory); }
+
+/**
+ * Counts the allocations made while it exists
+ */
+class AllocationCounter {
+public:
+    /**
+     * Constructor, starts counting
+     */
+    AllocationCounter()
+    {
+        allocations = 0;
+        allocatedBytes = 0;
+        counting = true;
+    }
+
+    /**
+     * Destructor, stops counting
+     */
+    ~AllocationCounter() { counting = false; }
+
+    /**
+     * Stop counting
+     * @return allocations made since counting started
+     */
+    long Stop()
+    {
+        counting = false;
+        return allocations;
+    }
+
+    /**
+     * Bytes allocated so far
+     * @return bytes
+     */
+    long GetBytes() const { return allocatedBytes; }
+};
+
+class AllocationTest : public ::testing::Test {
+protected:
+    /**
+     * Get a directory for temporary files
+     * @return directory path
+     */
+    wxString TempPath()
+    {
+        auto path = wxFileName::GetTempDir() + L"/SpartyBootsAllocation";
+        if (!wxFileName::DirExists(path))
+        {
+            wxFileName::Mkdir(path);
+        }
+        return path;
+    }
+};
+
+TEST_F(AllocationTest, Counter)
+{
+    AllocationCounter counter;
+    auto value = make_unique<int>(5);
+    ASSERT_EQ(1, counter.Stop());
+}
+
+TEST_F(AllocationTest, PinMemory)
+{
+    // A pin is an item that knows its owner, the pin lists and the box
+    // around the pins belong to the owner. An and gate is the gate, its
+    // three pins and the two pin lists.
+    const long PinBudget = 96;
+    const long GateBudget = 512;
+
+    SpartyBoots spartyBoots(NULL);
+
+    AllocationCounter pinCounter;
+    auto pin = make_shared<InputPin>(&spartyBoots);
+    pinCounter.Stop();
+    ASSERT_LE(pinCounter.GetBytes(), PinBudget);
+
+    AllocationCounter gateCounter;
+    auto gate = make_shared<AndGate>(&spartyBoots);
+    gateCounter.Stop();
+    ASSERT_LE(gateCounter.GetBytes(), GateBudget);
+}
+
+TEST_F(AllocationTest, SteadyUpdate)
+{
+    LevelGenerator::Options options;
+    options.mProducts = 200;
+    options.mGates = 0;
+
+    LoadLevel level;
+    LevelGenerator generator(options);
+    generator.Generate(level);
+
+    // The beam and a sensor output through a few gates to Sparty
+    level.AddRecord({L"gate", L"not", L"450", L"80"});
+    level.AddRecord({L"gate", L"and", L"450", L"170"});
+    level.AddRecord({L"gate", L"or", L"450", L"260"});
+    level.AddRecord({L"gate", L"sr", L"450", L"350"});
+    level.AddRecord({L"wire", L"beam", L"gate.0.0"});
+    level.AddRecord({L"wire", L"beam", L"gate.1.0"});
+    level.AddRecord({L"wire", L"sensor.0", L"gate.1.1"});
+    level.AddRecord({L"wire", L"gate.0.0", L"gate.2.0"});
+    level.AddRecord({L"wire", L"gate.1.0", L"gate.2.1"});
+    level.AddRecord({L"wire", L"gate.1.0", L"gate.3.0"});
+    level.AddRecord({L"wire", L"gate.0.0", L"gate.3.1"});
+    level.AddRecord({L"wire", L"gate.2.0", L"sparty"});
+
+    // A latch of two cross-coupled nor gates, set by the beam and reset
+    // when it is off, so the feedback loop is swept as products go by
+    level.AddRecord({L"gate", L"or", L"650", L"80"});
+    level.AddRecord({L"gate", L"or", L"650", L"260"});
+    level.AddRecord({L"gate", L"not", L"800", L"80"});
+    level.AddRecord({L"gate", L"not", L"800", L"260"});
+    level.AddRecord({L"wire", L"beam", L"gate.4.0"});
+    level.AddRecord({L"wire", L"gate.7.0", L"gate.4.1"});
+    level.AddRecord({L"wire", L"gate.0.0", L"gate.5.0"});
+    level.AddRecord({L"wire", L"gate.6.0", L"gate.5.1"});
+    level.AddRecord({L"wire", L"gate.4.0", L"gate.6.0"});
+    level.AddRecord({L"wire", L"gate.5.0", L"gate.7.0"});
+
+    auto filename = TempPath() + L"/steady.splv";
+    ASSERT_TRUE(level.SaveBinary(filename));
+
+    SpartyBoots spartyBoots(NULL);
+    spartyBoots.LevelLoad(filename, 0);
+
+    // Start the conveyor and let the circuit settle
+    spartyBoots.HitTest(350, 55);
+    for (int i = 0; i < 60; i++)
+    {
+        spartyBoots.Update(1.0 / 60);
+    }
+    ASSERT_TRUE(spartyBoots.GetItemStore().GetConveyor()->IsRunning());
+    ASSERT_TRUE(spartyBoots.GetLogic().IsBuilt());
+    ASSERT_EQ(1, spartyBoots.GetLogic().GetLoopCount());
+
+    // Products go through the beam and get kicked in this time. The
+    // rewind snapshots taken meanwhile go in room the ring reserved at
+    // the first one, during the warm up.
+    auto &snapshots = spartyBoots.GetSnapshots();
+    ASSERT_NE(0, snapshots.GetCount());
+    int count = snapshots.GetCount();
+    int currentLevel = spartyBoots.GetCurrentLevel();
+    for (int i = 0; i < 6 * 60; i++)
+    {
+        AllocationCounter counter;
+        spartyBoots.Update(1.0 / 60);
+        ASSERT_EQ(0, counter.Stop()) << "tick " << i;
+    }
+    ASSERT_LT(count, snapshots.GetCount());
+    ASSERT_EQ(currentLevel, spartyBoots.GetCurrentLevel());
+    ASSERT_NE(0, spartyBoots.GetItemStore().GetScoreBoard()->GetScore());
+}
@@ -0,0 +1,87 @@
+/**
+ * @file CircuitSolverTest.cpp
+ * @author Alex Mueller
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <CircuitSolver.hpp>
+#include <LoadLevel.h>
+
+using namespace std;
+
+/**
+ * Make a level with a sensor and products
+ * @param level Level to add to
+ * @param children Sensor children
+ * @param products Shape, color, content and kick of each product
+ */
+static void MakeLevel(LoadLevel &level, vector<wxString> children, vector<vector<wxString>> products)
+{
+    vector<wxString> sensor = {L"sensor", L"155", L"430"};
+    sensor.insert(sensor.end(), children.begin(), children.end());
+    level.AddRecord(sensor);
+    for (auto &product : products)
+    {
+        vector<wxString> record = {L"product", L"+150"};
+        record.insert(record.end(), product.begin(), product.end());
+        level.AddRecord(record);
+    }
+}
+
+TEST(CircuitSolverTest, Level2)
+{
+    // Kick the red products, a wire from the sensor does it
+    LoadLevel level;
+    level.Load(wxGetCwd() + L"/Levels/level2.xml");
+
+    CircuitSolver solver(CircuitSolver::Options{});
+    solver.SetLevel(level);
+    auto result = solver.Solve();
+
+    ASSERT_TRUE(result.mSolved);
+    ASSERT_EQ(0, result.mGates.size());
+    ASSERT_EQ(wxString(L"sensor.0"), solver.SignalName(result, result.mOutput));
+}
+
+TEST(CircuitSolverTest, Combinational)
+{
+    // Red or square, but not both, needs four gates
+    LoadLevel level;
+    MakeLevel(level, {L"red", L"square"},
+              {{L"square", L"red", L"", L"no"}, {L"square", L"blue", L"", L"yes"}, {L"circle", L"red", L"", L"yes"},
+               {L"circle", L"blue", L"", L"no"}});
+
+    CircuitSolver::Options options;
+    options.mFlipFlops = false;
+    CircuitSolver solver(options);
+    solver.SetLevel(level);
+    auto result = solver.Solve();
+
+    ASSERT_TRUE(result.mSolved);
+    ASSERT_EQ(4, result.mGates.size());
+}
+
+TEST(CircuitSolverTest, Latch)
+{
+    // Kick everything once a red product has been seen
+    LoadLevel level;
+    MakeLevel(level, {L"red", L"green"},
+              {{L"square", L"green", L"", L"no"}, {L"circle", L"green", L"", L"no"}, {L"square", L"red", L"", L"yes"},
+               {L"square", L"green", L"", L"yes"}, {L"circle", L"green", L"", L"yes"}});
+
+    CircuitSolver solver(CircuitSolver::Options{});
+    solver.SetLevel(level);
+    auto result = solver.Solve();
+
+    ASSERT_TRUE(result.mSolved);
+    ASSERT_EQ(1, result.mGates.size());
+
+    // Without flip-flops no circuit can remember the red product
+    CircuitSolver::Options options;
+    options.mFlipFlops = false;
+    options.mMaxGates = 3;
+    CircuitSolver combinational(options);
+    combinational.SetLevel(level);
+    ASSERT_FALSE(combinational.Solve().mSolved);
+}
@@ -75,7 +75,7 @@ public:
         return false;
     }
 
-    void Draw(std::shared_ptr<wxGraphicsContext> context) {
+    void Draw(DrawCommands &context) {
         // Provide a mock implementation
     }
 
@@ -83,7 +83,7 @@ public:
         // Provide a mock implementation
     }
 
-    void DrawPins(std::shared_ptr<wxGraphicsContext> context, int x, int y, int width, int height, bool state) {
+    void DrawPins(DrawCommands &context, int x, int y, int width, int height, bool state) {
         // Provide a mock implementation
     }
 
@@ -0,0 +1,252 @@
+/**
+ * @file RenderTest.cpp
+ * @author Alex Mueller
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <cstdlib>
+#include <wx/filename.h>
+#include <DrawCommands.hpp>
+#include <LoadLevel.h>
+#include <PixelDiff.hpp>
+#include <Product.h>
+#include <SoftwareRenderer.hpp>
+#include <SpartyBoots.hpp>
+
+#ifndef GOLDEN_DIR
+/// Directory holding the golden images
+#define GOLDEN_DIR "Tests/golden"
+#endif
+
+#ifndef GOLDEN_OUTPUT_DIR
+/// Directory new golden images are recorded in
+#define GOLDEN_OUTPUT_DIR "golden"
+#endif
+
+using namespace std;
+
+/**
+ * Render a frame of the game without a display. The products are drawn
+ * as shapes and bitmaps are left out, so the frame doesn't depend on how
+ * the platform loads and scales images.
+ * @param spartyBoots Game to draw
+ * @param width Width of the frame
+ * @param height Height of the frame
+ * @return renderer holding the frame
+ */
+static SoftwareRenderer RenderFrame(SpartyBoots &spartyBoots, int width, int height)
+{
+    DrawCommands commands;
+    spartyBoots.GetProductSprites().SetUseSprites(false);
+    spartyBoots.Draw(commands, width, height);
+
+    SoftwareRenderer renderer(width, height);
+    renderer.SetDrawBitmaps(false);
+    renderer.Clear(*wxWHITE);
+    renderer.Render(commands);
+    return renderer;
+}
+
+/**
+ * Compare a frame with its golden image. With SPARTY_UPDATE_GOLDEN set
+ * the frame is recorded in the build directory instead, to be checked
+ * and copied over the golden in Tests/golden.
+ * @param renderer Renderer holding the frame
+ * @param name Name of the golden image, without the extension
+ */
+static void CompareGolden(const SoftwareRenderer &renderer, const wxString &name)
+{
+    if (getenv("SPARTY_UPDATE_GOLDEN") != nullptr)
+    {
+        if (!wxFileName::DirExists(GOLDEN_OUTPUT_DIR))
+        {
+            wxFileName::Mkdir(GOLDEN_OUTPUT_DIR);
+        }
+        wxString output = wxString(GOLDEN_OUTPUT_DIR) + L"/" + name + L".png";
+        ASSERT_TRUE(renderer.ToImage().SaveFile(output, wxBITMAP_TYPE_PNG)) << output.ToStdString();
+        return;
+    }
+
+    wxString path = wxString(GOLDEN_DIR) + L"/" + name + L".png";
+    ASSERT_TRUE(wxFileName::FileExists(path)) << "No golden image " << path.ToStdString()
+                                              << ", record it with SPARTY_UPDATE_GOLDEN set";
+
+    wxImage golden;
+    ASSERT_TRUE(golden.LoadFile(path, wxBITMAP_TYPE_PNG)) << path.ToStdString();
+    ASSERT_NE(nullptr, golden.GetData()) << path.ToStdString();
+
+    ASSERT_EQ(renderer.GetWidth(), golden.GetWidth());
+    ASSERT_EQ(renderer.GetHeight(), golden.GetHeight());
+
+    int pixels = golden.GetWidth() * golden.GetHeight();
+    vector<unsigned char> expected(pixels * 4);
+    for (int i = 0; i < pixels; i++)
+    {
+        expected[i * 4] = golden.GetData()[i * 3];
+        expected[i * 4 + 1] = golden.GetData()[i * 3 + 1];
+        expected[i * 4 + 2] = golden.GetData()[i * 3 + 2];
+        expected[i * 4 + 3] = golden.HasAlpha() ? golden.GetAlpha()[i] : 255;
+    }
+
+    ASSERT_EQ(0, PixelDiff::CountDifferent(renderer.GetPixels().data(), expected.data(), pixels, 2)) << path.ToStdString();
+}
+
+TEST(RenderTest, PixelDiff)
+{
+    // Enough pixels to use the wide compare and the remainder
+    vector<unsigned char> a(4 * 23, 100);
+    vector<unsigned char> b = a;
+    ASSERT_EQ(0, PixelDiff::CountDifferent(a.data(), b.data(), 23));
+
+    b[4 * 2 + 1] = 103;
+    b[4 * 9 + 3] = 0;
+    b[4 * 22] = 90;
+    ASSERT_EQ(3, PixelDiff::CountDifferent(a.data(), b.data(), 23));
+    ASSERT_EQ(3, PixelDiff::CountDifferentScalar(a.data(), b.data(), 23));
+
+    // Small differences are within the tolerance
+    ASSERT_EQ(2, PixelDiff::CountDifferent(a.data(), b.data(), 23, 3));
+}
+
+TEST(RenderTest, Shapes)
+{
+    DrawCommands commands;
+    commands.SetPen(*wxTRANSPARENT_PEN);
+    commands.SetBrush(wxBrush(wxColour(255, 0, 0)));
+    commands.DrawRectangle(10, 10, 20, 10);
+
+    commands.PushState();
+    commands.Translate(50, 50);
+    commands.Scale(2, 2);
+    commands.SetBrush(wxBrush(wxColour(0, 0, 255)));
+    commands.DrawEllipse(0, 0, 10, 10);
+    commands.PopState();
+
+    commands.SetPen(wxPen(wxColour(0, 255, 0), 3));
+    commands.StrokeLine(0, 90, 100, 90);
+
+    SoftwareRenderer renderer(100, 100);
+    renderer.Clear(*wxWHITE);
+    renderer.Render(commands);
+
+    ASSERT_EQ(wxColour(255, 0, 0), renderer.GetPixel(10, 10));
+    ASSERT_EQ(wxColour(255, 0, 0), renderer.GetPixel(29, 19));
+    ASSERT_EQ(*wxWHITE, renderer.GetPixel(30, 19));
+    ASSERT_EQ(*wxWHITE, renderer.GetPixel(29, 20));
+
+    // The ellipse is scaled to 20 across from 50, 50
+    ASSERT_EQ(wxColour(0, 0, 255), renderer.GetPixel(60, 60));
+    ASSERT_EQ(*wxWHITE, renderer.GetPixel(51, 51));
+    ASSERT_EQ(*wxWHITE, renderer.GetPixel(71, 60));
+
+    // The line is three pixels wide
+    ASSERT_EQ(wxColour(0, 255, 0), renderer.GetPixel(50, 89));
+    ASSERT_EQ(wxColour(0, 255, 0), renderer.GetPixel(50, 90));
+    ASSERT_EQ(*wxWHITE, renderer.GetPixel(50, 87));
+}
+
+TEST(RenderTest, LongPath)
+{
+    // More segments than fit in 16 bits, the last ones close a square
+    // at the right of the image
+    DrawCommands::Path path;
+    for (int i = 0; i < 70000; i++)
+    {
+        path.MoveToPoint(0, 0);
+    }
+    path.MoveToPoint(80, 10);
+    path.AddLineToPoint(90, 10);
+    path.AddLineToPoint(90, 20);
+    path.AddLineToPoint(80, 20);
+    path.CloseSubpath();
+
+    DrawCommands commands;
+    commands.SetPen(*wxTRANSPARENT_PEN);
+    commands.SetBrush(wxBrush(wxColour(255, 0, 0)));
+    commands.DrawPath(path);
+    ASSERT_EQ(path.GetSegments().size(), commands.GetCommands().back().mCount);
+
+    SoftwareRenderer renderer(100, 100);
+    renderer.Clear(*wxWHITE);
+    renderer.Render(commands);
+    ASSERT_EQ(wxColour(255, 0, 0), renderer.GetPixel(85, 15));
+}
+
+TEST(RenderTest, Products)
+{
+    SpartyBoots spartyBoots(NULL);
+
+    DrawCommands commands;
+    Product square(&spartyBoots, L"0", L"square", L"red", L"none", L"no");
+    Product circle(&spartyBoots, L"0", L"circle", L"green", L"none", L"no");
+    Product diamond(&spartyBoots, L"0", L"diamond", L"blue", L"none", L"no");
+    square.DrawShape(commands, 10, 10);
+    circle.DrawShape(commands, 80, 10);
+    diamond.DrawShape(commands, 150, 10);
+
+    SoftwareRenderer renderer(220, 80);
+    renderer.Render(commands);
+
+    ASSERT_EQ(wxColour(187, 0, 0), renderer.GetPixel(35, 35));
+    ASSERT_EQ(wxColour(187, 0, 0), renderer.GetPixel(11, 11));
+    ASSERT_EQ(wxColour(24, 69, 59), renderer.GetPixel(105, 35));
+    ASSERT_EQ(wxColour(0, 39, 76), renderer.GetPixel(175, 35));
+    ASSERT_EQ(wxColour(0, 39, 76), renderer.GetPixel(175, 12));
+
+    // The corners of the circle and the diamond are empty
+    ASSERT_EQ(0, renderer.GetPixel(82, 12).Alpha());
+    ASSERT_EQ(0, renderer.GetPixel(152, 12).Alpha());
+    ASSERT_EQ(0, renderer.GetPixel(5, 5).Alpha());
+}
+
+TEST(RenderTest, Level)
+{
+    SpartyBoots spartyBoots(NULL);
+    spartyBoots.OnLevelSelect(2);
+    spartyBoots.Update(2);
+
+    // Pin values settle as the first frame is drawn, after that the
+    // same frame renders the same every time
+    RenderFrame(spartyBoots, 1000, 800);
+    auto first = RenderFrame(spartyBoots, 1000, 800);
+    auto second = RenderFrame(spartyBoots, 1000, 800);
+    ASSERT_EQ(0, PixelDiff::CountDifferent(first.GetPixels().data(), second.GetPixels().data(), 1000 * 800));
+
+    CompareGolden(first, L"level2");
+}
+
+TEST(RenderTest, WiredLevel)
+{
+    // Level 2 with gates of each kind wired between the sensor, the beam
+    // and Sparty
+    LoadLevel level;
+    level.Load(wxGetCwd() + L"/Levels/level2.xml");
+    level.AddRecord({L"gate", L"and", L"500", L"250"});
+    level.AddRecord({L"gate", L"or", L"500", L"400"});
+    level.AddRecord({L"gate", L"not", L"650", L"250"});
+    level.AddRecord({L"gate", L"sr", L"650", L"450"});
+    level.AddRecord({L"gate", L"d", L"800", L"350"});
+    level.AddRecord({L"wire", L"sensor.0", L"gate.0.0"});
+    level.AddRecord({L"wire", L"beam", L"gate.0.1"});
+    level.AddRecord({L"wire", L"beam", L"gate.1.0"});
+    level.AddRecord({L"wire", L"sensor.0", L"gate.1.1"});
+    level.AddRecord({L"wire", L"gate.0.0", L"gate.2.0"});
+    level.AddRecord({L"wire", L"gate.0.0", L"gate.3.0"});
+    level.AddRecord({L"wire", L"gate.2.0", L"gate.3.1"});
+    level.AddRecord({L"wire", L"gate.1.0", L"gate.4.0"});
+    level.AddRecord({L"wire", L"gate.3.0", L"gate.4.1"});
+    level.AddRecord({L"wire", L"gate.4.0", L"sparty"});
+
+    auto filename = wxFileName::GetTempDir() + L"/SpartyBootsWired.splv";
+    ASSERT_TRUE(level.SaveBinary(filename));
+
+    SpartyBoots spartyBoots(NULL);
+    spartyBoots.LevelLoad(filename, 2);
+    spartyBoots.Update(2);
+    ASSERT_EQ(5, spartyBoots.GetLogic().GetGateCount());
+
+    RenderFrame(spartyBoots, 1000, 800);
+    auto frame = RenderFrame(spartyBoots, 1000, 800);
+    CompareGolden(frame, L"wired");
+}
@@ -8,6 +8,14 @@
 #include "gtest/gtest.h"
 #include <wx/filename.h>
 #include <LoadLevel.h>
+#include <LevelGenerator.hpp>
+#include <InputRecorder.hpp>
+#include <LogicGate.h>
+#include <Beam.hpp>
+#include <Sparty.hpp>
+#include <Product.h>
+#include <ScoreBoard.hpp>
+#include <DrawCommands.hpp>
 #include <regex>
 #include <string>
 #include <fstream>
@@ -45,6 +53,23 @@ protected:
 
         return str;
     }
+
+    /**
+    * Compile the circuit of a game into a network of our own, so the
+    * test can drive the beam without the game updating it
+    * @param spartyBoots Game with the level loaded
+    * @param network Network to build
+    */
+    void BuildNetwork(SpartyBoots &spartyBoots, LogicNetwork &network)
+    {
+        auto &items = spartyBoots.GetItemStore();
+        vector<LogicGate *> gates;
+        for (auto &gate : items.GetGates())
+        {
+            gates.push_back(gate.get());
+        }
+        network.Build(items.GetSensor(), items.GetBeam(), items.GetSparty(), gates);
+    }
 };
 
 
@@ -86,3 +111,740 @@ TEST_F(SpartyBootsTest, Load)
     ASSERT_EQ(5, level.GetLevelScoreboard().size());
 
 }
+
+TEST_F(SpartyBootsTest, GeneratedLevel)
+{
+    LevelGenerator::Options options;
+    options.mProducts = 500;
+    options.mGates = 12;
+
+    LoadLevel level;
+    LevelGenerator generator(options);
+    generator.Generate(level);
+
+    ASSERT_EQ(500, level.GetLevelProducts().size());
+    ASSERT_EQ(12, level.GetLevelGates().size());
+    ASSERT_EQ(6, level.GetLevelSensorChildren().size());
+
+    // Both file formats read back the same records
+    auto path = TempPath();
+    ASSERT_TRUE(level.SaveXml(path + L"/generated.xml"));
+    ASSERT_TRUE(level.SaveBinary(path + L"/generated.splv"));
+
+    LoadLevel xmlLevel;
+    xmlLevel.Load(path + L"/generated.xml");
+    LoadLevel binaryLevel;
+    binaryLevel.Load(path + L"/generated.splv");
+
+    ASSERT_EQ(level.GetLevelList().size(), binaryLevel.GetLevelList().size());
+    ASSERT_TRUE(level.GetLevelList() == binaryLevel.GetLevelList());
+    ASSERT_EQ(500, xmlLevel.GetLevelProducts().size());
+    ASSERT_TRUE(level.GetLevelWires() == xmlLevel.GetLevelWires());
+
+    // The pre-wired circuit loads into the game, in place of the first level
+    SpartyBoots spartyBoots(NULL);
+    spartyBoots.LevelLoad(path + L"/generated.splv", 0);
+    auto &items = spartyBoots.GetItemStore();
+    ASSERT_EQ(500u, items.GetProducts().size());
+    ASSERT_EQ(12u, items.GetGates().size());
+    ASSERT_NE(nullptr, items.GetSensor());
+    spartyBoots.Update(0.03);
+    ASSERT_TRUE(spartyBoots.GetLogic().IsBuilt());
+    ASSERT_LT(0, spartyBoots.GetLogic().GetWireCount());
+
+    // Records too short to use are skipped
+    level.AddRecord({L"gate", L"and"});
+    level.AddRecord({L"wire", L"beam"});
+    ASSERT_TRUE(level.SaveBinary(path + L"/short.splv"));
+    spartyBoots.LevelLoad(path + L"/short.splv", 0);
+    ASSERT_EQ(12u, items.GetGates().size());
+}
+
+TEST_F(SpartyBootsTest, RecordReplay)
+{
+    auto recorder = std::make_shared<InputRecorder>();
+    SpartyBoots spartyBoots(NULL);
+    spartyBoots.SetRecorder(recorder);
+    spartyBoots.OnLevelSelect(2);
+    spartyBoots.SetViewSize(1150, 800);
+
+    // Add a gate and drag it somewhere else
+    auto gate = spartyBoots.AddGate(L"and");
+    spartyBoots.Update(0.03);
+    spartyBoots.Grab(200, 200);
+    spartyBoots.Drag(500, 300);
+    spartyBoots.Update(0.03);
+    spartyBoots.Release();
+    spartyBoots.Update(0.03);
+    ASSERT_NEAR(500, gate->GetX(), 0.001);
+
+    auto filename = TempPath() + L"/input.log";
+    ASSERT_TRUE(recorder->Save(filename));
+
+    InputRecorder replay;
+    ASSERT_TRUE(replay.Load(filename));
+    ASSERT_EQ(recorder->GetEvents().size(), replay.GetEvents().size());
+
+    SpartyBoots replayed(NULL);
+    ASSERT_EQ(3, replay.Replay(replayed));
+    ASSERT_EQ(2, replayed.GetCurrentLevel());
+    ASSERT_EQ(spartyBoots.GetItems().size(), replayed.GetItems().size());
+
+    auto replayedGate = replayed.GetItems().back();
+    ASSERT_NEAR(gate->GetX(), replayedGate->GetX(), 0.001);
+    ASSERT_NEAR(gate->GetY(), replayedGate->GetY(), 0.001);
+}
+
+TEST_F(SpartyBootsTest, SnapshotRewind)
+{
+    SpartyBoots spartyBoots(NULL);
+    spartyBoots.OnLevelSelect(3);
+    for (int i = 0; i < 50; i++)
+    {
+        spartyBoots.Update(0.03);
+    }
+    auto snapshot = spartyBoots.SaveSnapshot();
+
+    for (int i = 0; i < 100; i++)
+    {
+        spartyBoots.Update(0.03);
+    }
+    ASSERT_TRUE(spartyBoots.SaveSnapshot() != snapshot);
+
+    // Restoring puts every item back
+    ASSERT_TRUE(spartyBoots.RestoreSnapshot(snapshot));
+    ASSERT_TRUE(spartyBoots.SaveSnapshot() == snapshot);
+
+    // The bytes WriteSnapshot returns can be restored from too, as long
+    // as no snapshot was taken since. Update takes one every 10 ticks.
+    int count = spartyBoots.GetSnapshots().GetCount();
+    while (spartyBoots.GetSnapshots().GetCount() == count)
+    {
+        spartyBoots.Update(0.03);
+    }
+    const auto &written = spartyBoots.WriteSnapshot();
+    auto copy = written;
+    for (int i = 0; i < 5; i++)
+    {
+        spartyBoots.Update(0.03);
+    }
+    ASSERT_TRUE(spartyBoots.RestoreSnapshot(written));
+    ASSERT_TRUE(spartyBoots.SaveSnapshot() == copy);
+
+    // Snapshots are taken as the game runs, rewinding finds them
+    for (int i = 0; i < 100; i++)
+    {
+        spartyBoots.Update(0.03);
+    }
+    ASSERT_TRUE(spartyBoots.GetSnapshots().GetCount() > 0);
+    ASSERT_TRUE(spartyBoots.Rewind(40));
+
+    // A snapshot of another level is refused
+    spartyBoots.OnLevelSelect(4);
+    ASSERT_FALSE(spartyBoots.RestoreSnapshot(snapshot));
+}
+
+TEST_F(SpartyBootsTest, SnapshotRing)
+{
+    // Snapshots that change a little each time, some keyframes and some deltas
+    auto make = [](int n) {
+        vector<uint8_t> snapshot(64, 7);
+        snapshot[n % 64] = (uint8_t)n;
+        snapshot[0] = (uint8_t)(n / 3);
+        return snapshot;
+    };
+
+    // Around the ring more than twice, the oldest are dropped
+    SnapshotRing ring(20);
+    for (int n = 0; n < 50; n++)
+    {
+        ring.Add(n * 10, make(n));
+    }
+    ASSERT_EQ(20, ring.GetCount());
+
+    vector<uint8_t> snapshot;
+    for (int i = 0; i < ring.GetCount(); i++)
+    {
+        ASSERT_EQ((30 + i) * 10, ring.GetTick(i));
+        ASSERT_TRUE(ring.Get(i, snapshot));
+        ASSERT_TRUE(make(30 + i) == snapshot);
+    }
+    ASSERT_EQ(15, ring.FindAtOrBefore(455));
+
+    // Rewinding drops the newest, the ring fills again from there
+    ring.Truncate(5);
+    for (int n = 35; n < 60; n++)
+    {
+        ring.Add(n * 10, make(n));
+    }
+    ASSERT_EQ(20, ring.GetCount());
+    ASSERT_TRUE(ring.Get(19, snapshot));
+    ASSERT_TRUE(make(59) == snapshot);
+    ASSERT_TRUE(ring.Get(0, snapshot));
+    ASSERT_TRUE(make(40) == snapshot);
+}
+
+TEST_F(SpartyBootsTest, LogicNetwork)
+{
+    LevelGenerator::Options options;
+    options.mProducts = 10;
+    options.mGates = 0;
+
+    LoadLevel level;
+    LevelGenerator generator(options);
+    generator.Generate(level);
+
+    // not not beam, anded with itself, is just the beam
+    level.AddRecord({L"gate", L"not", L"450", L"80"});
+    level.AddRecord({L"gate", L"not", L"450", L"170"});
+    level.AddRecord({L"gate", L"and", L"450", L"260"});
+    level.AddRecord({L"gate", L"or", L"450", L"350"});
+    level.AddRecord({L"wire", L"beam", L"gate.0.0"});
+    level.AddRecord({L"wire", L"gate.0.0", L"gate.1.0"});
+    level.AddRecord({L"wire", L"gate.1.0", L"gate.2.0"});
+    level.AddRecord({L"wire", L"gate.1.0", L"gate.2.1"});
+
+    // This gate doesn't lead to Sparty
+    level.AddRecord({L"wire", L"beam", L"gate.3.0"});
+    level.AddRecord({L"wire", L"sensor.0", L"gate.3.1"});
+
+    // Another not beam, the same as gate 0. Ored with not not beam it is
+    // always high, and anded with the beam that is the beam again.
+    level.AddRecord({L"gate", L"not", L"650", L"80"});
+    level.AddRecord({L"gate", L"or", L"650", L"170"});
+    level.AddRecord({L"gate", L"and", L"650", L"260"});
+    level.AddRecord({L"wire", L"beam", L"gate.4.0"});
+    level.AddRecord({L"wire", L"gate.1.0", L"gate.5.0"});
+    level.AddRecord({L"wire", L"gate.4.0", L"gate.5.1"});
+    level.AddRecord({L"wire", L"gate.2.0", L"gate.6.0"});
+    level.AddRecord({L"wire", L"gate.5.0", L"gate.6.1"});
+    level.AddRecord({L"wire", L"gate.6.0", L"sparty"});
+
+    auto filename = TempPath() + L"/logic.splv";
+    ASSERT_TRUE(level.SaveBinary(filename));
+
+    SpartyBoots spartyBoots(NULL);
+    spartyBoots.LevelLoad(filename, 0);
+    spartyBoots.Update(0.03);
+
+    ASSERT_EQ(7, spartyBoots.GetLogic().GetGateCount());
+    ASSERT_EQ(0, spartyBoots.GetLogic().GetOperationCount());
+
+    // Sparty follows the beam, with the optimizer pass and without it
+    LogicNetwork optimized;
+    BuildNetwork(spartyBoots, optimized);
+    LogicNetwork unoptimized;
+    unoptimized.SetOptimize(false);
+    BuildNetwork(spartyBoots, unoptimized);
+    ASSERT_EQ(0, optimized.GetOperationCount());
+    ASSERT_EQ(7, unoptimized.GetOperationCount());
+
+    auto beam = spartyBoots.GetItemStore().GetBeam();
+    auto input = spartyBoots.GetItemStore().GetSparty()->getPin()[0];
+    for (bool touching : {true, false, true})
+    {
+        beam->SetItemTouchingBeam(touching);
+        optimized.Evaluate();
+        ASSERT_TRUE(input->isConnected());
+        ASSERT_EQ(touching, input->getValue());
+
+        input->setValue(!touching);
+        unoptimized.Evaluate();
+        ASSERT_TRUE(input->isConnected());
+        ASSERT_EQ(touching, input->getValue());
+    }
+
+    // Rewiring rebuilds the network
+    spartyBoots.AddGate(L"not");
+    ASSERT_FALSE(spartyBoots.GetLogic().IsBuilt());
+    spartyBoots.Update(0.03);
+    ASSERT_TRUE(spartyBoots.GetLogic().IsBuilt());
+}
+
+TEST_F(SpartyBootsTest, FeedbackLoops)
+{
+    LevelGenerator::Options options;
+    options.mProducts = 10;
+    options.mGates = 0;
+
+    LoadLevel level;
+    LevelGenerator generator(options);
+    generator.Generate(level);
+
+    // A latch that holds once the beam goes high, and a not wired to itself
+    level.AddRecord({L"gate", L"or", L"450", L"80"});
+    level.AddRecord({L"gate", L"not", L"450", L"170"});
+    level.AddRecord({L"wire", L"beam", L"gate.0.0"});
+    level.AddRecord({L"wire", L"gate.0.0", L"gate.0.1"});
+    level.AddRecord({L"wire", L"gate.0.0", L"sparty"});
+    level.AddRecord({L"wire", L"gate.1.0", L"gate.1.0"});
+
+    // A NOR latch set by the beam, its reset is beam and not beam, always low
+    level.AddRecord({L"gate", L"or", L"650", L"80"});
+    level.AddRecord({L"gate", L"not", L"650", L"170"});
+    level.AddRecord({L"gate", L"or", L"650", L"260"});
+    level.AddRecord({L"gate", L"not", L"650", L"350"});
+    level.AddRecord({L"gate", L"not", L"650", L"440"});
+    level.AddRecord({L"gate", L"and", L"650", L"530"});
+    level.AddRecord({L"wire", L"beam", L"gate.2.0"});
+    level.AddRecord({L"wire", L"gate.5.0", L"gate.2.1"});
+    level.AddRecord({L"wire", L"gate.2.0", L"gate.3.0"});
+    level.AddRecord({L"wire", L"gate.7.0", L"gate.4.0"});
+    level.AddRecord({L"wire", L"gate.3.0", L"gate.4.1"});
+    level.AddRecord({L"wire", L"gate.4.0", L"gate.5.0"});
+    level.AddRecord({L"wire", L"beam", L"gate.6.0"});
+    level.AddRecord({L"wire", L"beam", L"gate.7.0"});
+    level.AddRecord({L"wire", L"gate.6.0", L"gate.7.1"});
+
+    // A ring of three nots never settles
+    level.AddRecord({L"gate", L"not", L"850", L"80"});
+    level.AddRecord({L"gate", L"not", L"850", L"170"});
+    level.AddRecord({L"gate", L"not", L"850", L"260"});
+    level.AddRecord({L"wire", L"gate.10.0", L"gate.8.0"});
+    level.AddRecord({L"wire", L"gate.8.0", L"gate.9.0"});
+    level.AddRecord({L"wire", L"gate.9.0", L"gate.10.0"});
+
+    auto filename = TempPath() + L"/loops.splv";
+    ASSERT_TRUE(level.SaveBinary(filename));
+
+    SpartyBoots spartyBoots(NULL);
+    spartyBoots.LevelLoad(filename, 0);
+    spartyBoots.Update(0.03);
+
+    ASSERT_EQ(11, spartyBoots.GetLogic().GetGateCount());
+    ASSERT_EQ(4, spartyBoots.GetLogic().GetLoopCount());
+    ASSERT_EQ(2, spartyBoots.GetLogic().GetOscillatingCount());
+
+    // The latch settles reset, is set by the beam, and holds once the
+    // beam is clear again
+    LogicNetwork network;
+    BuildNetwork(spartyBoots, network);
+    auto beam = spartyBoots.GetItemStore().GetBeam();
+    auto q = spartyBoots.GetItemStore().GetGates()[5]->GetOutputPins()[0];
+    bool set = false;
+    for (bool touching : {false, true, false, false})
+    {
+        set |= touching;
+        beam->SetItemTouchingBeam(touching);
+        network.Evaluate();
+        network.Publish();
+        ASSERT_EQ(2, network.GetOscillatingCount());
+        ASSERT_TRUE(q->isConnected());
+        ASSERT_EQ(set, q->getValue());
+    }
+}
+
+TEST_F(SpartyBootsTest, FanOut)
+{
+    LevelGenerator::Options options;
+    options.mProducts = 10;
+    options.mGates = 0;
+
+    LoadLevel level;
+    LevelGenerator generator(options);
+    generator.Generate(level);
+
+    // The beam drives eight gates, one of them drives Sparty
+    const int Gates = 8;
+    for (int g = 0; g < Gates; g++)
+    {
+        level.AddRecord({L"gate", L"not", L"450", wxString::Format(L"%d", 80 + 40 * g)});
+        level.AddRecord({L"wire", L"beam", wxString::Format(L"gate.%d.0", g)});
+    }
+    level.AddRecord({L"wire", L"gate.0.0", L"sparty"});
+
+    auto filename = TempPath() + L"/fanout.splv";
+    ASSERT_TRUE(level.SaveBinary(filename));
+
+    SpartyBoots spartyBoots(NULL);
+    spartyBoots.LevelLoad(filename, 0);
+    spartyBoots.Update(0.03);
+
+    ASSERT_EQ(Gates + 1, spartyBoots.GetLogic().GetWireCount());
+    ASSERT_EQ(Gates, spartyBoots.GetLogic().GetMaxFanOut());
+
+    // Every gate sees the beam once drawing fills in the pins
+    DrawCommands commands;
+    spartyBoots.Draw(commands, 1000, 800);
+    auto beam = spartyBoots.GetItemStore().GetBeam()->getPins()[0];
+    for (auto &gate : spartyBoots.GetItemStore().GetGates())
+    {
+        auto input = gate->GetInputPins()[0];
+        ASSERT_TRUE(input->isConnected());
+        ASSERT_EQ(beam->getValue(), input->getValue());
+    }
+}
+
+TEST_F(SpartyBootsTest, SharedDriver)
+{
+    LevelGenerator::Options options;
+    options.mProducts = 10;
+    options.mGates = 0;
+
+    LoadLevel level;
+    LevelGenerator generator(options);
+    generator.Generate(level);
+
+    // Gates 0 and 2 compute the same thing and share a slot, the wires
+    // of gate 1 are found between theirs
+    level.AddRecord({L"gate", L"not", L"450", L"80"});
+    level.AddRecord({L"gate", L"not", L"450", L"160"});
+    level.AddRecord({L"gate", L"not", L"450", L"240"});
+    level.AddRecord({L"gate", L"or", L"650", L"80"});
+    level.AddRecord({L"gate", L"or", L"650", L"160"});
+    level.AddRecord({L"gate", L"or", L"650", L"240"});
+    level.AddRecord({L"wire", L"beam", L"gate.0.0"});
+    level.AddRecord({L"wire", L"sensor.0", L"gate.1.0"});
+    level.AddRecord({L"wire", L"beam", L"gate.2.0"});
+    level.AddRecord({L"wire", L"gate.0.0", L"gate.3.0"});
+    level.AddRecord({L"wire", L"gate.0.0", L"gate.5.0"});
+    level.AddRecord({L"wire", L"gate.1.0", L"gate.3.1"});
+    level.AddRecord({L"wire", L"gate.1.0", L"gate.4.1"});
+    level.AddRecord({L"wire", L"gate.2.0", L"gate.4.0"});
+    level.AddRecord({L"wire", L"gate.2.0", L"gate.5.1"});
+    level.AddRecord({L"wire", L"gate.5.0", L"sparty"});
+
+    auto filename = TempPath() + L"/shared.splv";
+    ASSERT_TRUE(level.SaveBinary(filename));
+
+    SpartyBoots spartyBoots(NULL);
+    spartyBoots.LevelLoad(filename, 0);
+    spartyBoots.Update(0.03);
+
+    // The wires of the shared slot are one run. Gate 5 ors the slot with
+    // itself, so its wire to Sparty is driven by that slot too.
+    ASSERT_EQ(10, spartyBoots.GetLogic().GetWireCount());
+    ASSERT_EQ(5, spartyBoots.GetLogic().GetMaxFanOut());
+
+    DrawCommands commands;
+    spartyBoots.Draw(commands, 1000, 800);
+    auto &gates = spartyBoots.GetItemStore().GetGates();
+    bool inverted = !spartyBoots.GetItemStore().GetBeam()->getPins()[0]->getValue();
+    for (auto input : {gates[3]->GetInputPins()[0], gates[4]->GetInputPins()[0], gates[5]->GetInputPins()[0],
+                       gates[5]->GetInputPins()[1]})
+    {
+        ASSERT_TRUE(input->isConnected());
+        ASSERT_EQ(inverted, input->getValue());
+    }
+}
+
+TEST_F(SpartyBootsTest, FastForward)
+{
+    // Clicking the start button on the conveyor panel starts it
+    SpartyBoots ticked(NULL);
+    ticked.OnLevelSelect(2);
+    ticked.HitTest(350, 55);
+
+    SpartyBoots jumped(NULL);
+    jumped.OnLevelSelect(2);
+    jumped.HitTest(350, 55);
+
+    // Long enough for every product to be scored but not for the level to end
+    const double duration = 10;
+    int ticks = 0;
+    for (; ticks < duration * 60; ticks++)
+    {
+        ticked.Update(1.0 / 60);
+    }
+    int updates = jumped.FastForward(duration);
+    ASSERT_LT(updates, ticks / 10);
+
+    auto score = [](SpartyBoots &spartyBoots) {
+        for (auto &item : spartyBoots.GetItems())
+        {
+            if (auto scoreboard = std::dynamic_pointer_cast<ScoreBoard>(item))
+            {
+                return scoreboard->GetScore();
+            }
+        }
+        return 0;
+    };
+    ASSERT_EQ(2, ticked.GetCurrentLevel());
+    ASSERT_EQ(2, jumped.GetCurrentLevel());
+    ASSERT_EQ(score(ticked), score(jumped));
+    ASSERT_NE(0, score(jumped));
+
+    // Run through the level end, both move on to the next level
+    for (int i = 0; i < 10 * 60; i++)
+    {
+        ticked.Update(1.0 / 60);
+    }
+    jumped.FastForward(10);
+    ASSERT_EQ(3, ticked.GetCurrentLevel());
+    ASSERT_EQ(3, jumped.GetCurrentLevel());
+}
+
+TEST_F(SpartyBootsTest, SweptBeam)
+{
+    LevelGenerator::Options options;
+    options.mProducts = 20;
+    options.mGates = 0;
+
+    LoadLevel level;
+    LevelGenerator generator(options);
+    generator.Generate(level);
+
+    // Kick every product
+    level.AddRecord({L"wire", L"beam", L"sparty"});
+
+    auto filename = TempPath() + L"/swept.splv";
+    ASSERT_TRUE(level.SaveBinary(filename));
+
+    SpartyBoots ticked(NULL);
+    ticked.LevelLoad(filename, 0);
+    ticked.HitTest(350, 55);
+
+    SpartyBoots stepped(NULL);
+    stepped.LevelLoad(filename, 0);
+    stepped.HitTest(350, 55);
+
+    // A one second step moves a product twice the width of the beam
+    for (int i = 0; i < 5 * 60; i++)
+    {
+        ticked.Update(1.0 / 60);
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        stepped.Update(1.0);
+    }
+
+    // The game starts on level 1, so only look at the generated products after its products
+    auto kicked = [](SpartyBoots &spartyBoots) {
+        wxString kicks;
+        for (auto &item : spartyBoots.GetItems())
+        {
+            if (auto product = std::dynamic_pointer_cast<Product>(item))
+            {
+                kicks += product->WasKick() ? L"K" : L".";
+            }
+        }
+        return kicks.Right(20);
+    };
+    ASSERT_TRUE(kicked(ticked).Contains(L"K"));
+    ASSERT_TRUE(kicked(ticked) == kicked(stepped));
+}
+
+TEST_F(SpartyBootsTest, ProductQueue)
+{
+    SpartyBoots spartyBoots(NULL);
+    spartyBoots.OnLevelSelect(2);
+    spartyBoots.HitTest(350, 55);
+    ASSERT_EQ(6, spartyBoots.GetProducts().GetCount());
+
+    // Only the products near the beam are checked as they go by
+    int largest = 0;
+    for (int i = 0; i < 10 * 60; i++)
+    {
+        spartyBoots.Update(1.0 / 60);
+        largest = std::max(largest, spartyBoots.GetProducts().GetWindowSize());
+    }
+    ASSERT_GT(largest, 0);
+    ASSERT_LE(largest, 2);
+    ASSERT_TRUE(spartyBoots.GetProducts().HasLastPassed());
+    ASSERT_EQ(nullptr, spartyBoots.GetProducts().GetNext());
+}
+
+TEST_F(SpartyBootsTest, DormantProducts)
+{
+    SpartyBoots spartyBoots(NULL);
+    spartyBoots.OnLevelSelect(2);
+    spartyBoots.HitTest(350, 55);
+
+    auto dormant = [&spartyBoots]() {
+        int count = 0;
+        for (auto &item : spartyBoots.GetItems())
+        {
+            auto product = std::dynamic_pointer_cast<Product>(item);
+            if (product != nullptr && product->IsDormant())
+            {
+                EXPECT_TRUE(product->GetScoreAccountedFor());
+                count++;
+            }
+        }
+        return count;
+    };
+
+    for (int i = 0; i < 60; i++)
+    {
+        spartyBoots.Update(1.0 / 60);
+    }
+    ASSERT_EQ(0, dormant());
+
+    // Scored products that slid off the bottom of the conveyor are retired
+    auto snapshot = spartyBoots.SaveSnapshot();
+    for (int i = 0; i < 11 * 60; i++)
+    {
+        spartyBoots.Update(1.0 / 60);
+    }
+    ASSERT_EQ(2, spartyBoots.GetCurrentLevel());
+    ASSERT_GT(dormant(), 0);
+
+    // Retired products aren't updated, they stay where they were left
+    vector<pair<shared_ptr<Product>, wxPoint2DDouble>> retired;
+    for (auto &item : spartyBoots.GetItems())
+    {
+        auto product = std::dynamic_pointer_cast<Product>(item);
+        if (product != nullptr && product->IsDormant())
+        {
+            retired.emplace_back(product, wxPoint2DDouble(product->GetX(), product->GetY()));
+        }
+    }
+    for (int i = 0; i < 10; i++)
+    {
+        spartyBoots.Update(1.0 / 60);
+    }
+    for (auto &product : retired)
+    {
+        ASSERT_TRUE(product.first->IsDormant());
+        ASSERT_EQ(product.second.m_x, product.first->GetX());
+        ASSERT_EQ(product.second.m_y, product.first->GetY());
+    }
+
+    // and come back with a snapshot from before
+    ASSERT_TRUE(spartyBoots.RestoreSnapshot(snapshot));
+    ASSERT_EQ(0, dormant());
+}
+
+TEST_F(SpartyBootsTest, Animating)
+{
+    SpartyBoots spartyBoots(NULL);
+    spartyBoots.OnLevelSelect(2);
+
+    // The level notice is counting down
+    ASSERT_TRUE(spartyBoots.IsAnimating());
+
+    // Once it is gone nothing moves until the conveyor is started
+    for (int i = 0; i < 3 * 60; i++)
+    {
+        spartyBoots.Update(1.0 / 60);
+    }
+    ASSERT_FALSE(spartyBoots.IsAnimating());
+
+    spartyBoots.HitTest(350, 55);
+    ASSERT_TRUE(spartyBoots.IsAnimating());
+}
+
+TEST_F(SpartyBootsTest, DrawCommands)
+{
+    SpartyBoots spartyBoots(NULL);
+    spartyBoots.OnLevelSelect(2);
+
+    // A frame records without a graphics context
+    DrawCommands commands;
+    spartyBoots.Draw(commands, 1000, 800);
+    ASSERT_FALSE(commands.GetCommands().empty());
+
+    // and leaves the state as it found it
+    int depth = 0;
+    for (auto &command : commands.GetCommands())
+    {
+        if (command.mOp == DrawCommands::Op::PushState)
+        {
+            depth++;
+        }
+        else if (command.mOp == DrawCommands::Op::PopState)
+        {
+            depth--;
+            ASSERT_GE(depth, 0);
+        }
+    }
+    ASSERT_EQ(0, depth);
+
+    commands.Clear();
+    ASSERT_TRUE(commands.GetCommands().empty());
+}
+
+TEST_F(SpartyBootsTest, ItemStore)
+{
+    SpartyBoots spartyBoots(NULL);
+    spartyBoots.OnLevelSelect(2);
+
+    auto &items = spartyBoots.GetItemStore();
+    ASSERT_EQ(6u, items.GetProducts().size());
+    ASSERT_TRUE(items.GetGates().empty());
+    ASSERT_NE(nullptr, items.GetConveyor());
+    ASSERT_NE(nullptr, items.GetBeam());
+    ASSERT_NE(nullptr, items.GetSparty());
+    ASSERT_NE(nullptr, items.GetScoreBoard());
+
+    // A gate goes in with the gates, its pins stay with the gate
+    auto count = items.GetCount();
+    auto gate = spartyBoots.AddGate(L"and");
+    ASSERT_EQ(1u, items.GetGates().size());
+    ASSERT_EQ(count + 1, items.GetCount());
+    ASSERT_EQ(2u, gate->GetInputPins().size());
+    ASSERT_EQ(1u, gate->GetOutputPins().size());
+    ASSERT_EQ(gate.get(), gate->GetOutputPins()[0]->GetParent());
+
+    // Every item but the pins is in the drawing order once
+    size_t itemCount = 0;
+    items.ForEach([&itemCount](Item *item) {
+        auto logicItem = dynamic_cast<LogicItem *>(item);
+        if (logicItem == nullptr || logicItem->GetParent() == nullptr)
+        {
+            itemCount++;
+        }
+    });
+    ASSERT_EQ(items.GetCount(), itemCount);
+    ASSERT_EQ(gate, spartyBoots.GetItems().back());
+
+    // The gate finds its pins, and nothing away from them
+    auto pin = gate->GetInputPins()[1];
+    ASSERT_EQ(pin, gate->HitDraggable(pin->GetX(), pin->GetY()));
+    ASSERT_EQ(nullptr, gate->HitDraggable(pin->GetX() - 100, pin->GetY()));
+}
+
+TEST_F(SpartyBootsTest, Connectors)
+{
+    SpartyBoots spartyBoots(NULL);
+    spartyBoots.OnLevelSelect(2);
+
+    // Output pins have no connectors until a wire is dragged
+    auto gate = spartyBoots.AddGate(L"and");
+    auto output = gate->GetOutputPins()[0];
+    ASSERT_TRUE(output->getConnector().empty());
+
+    // A wire dropped where there is no pin goes away
+    auto wire = output->HitDraggable(output->GetX(), output->GetY());
+    ASSERT_NE(nullptr, wire);
+    wire->SetLocation(output->GetX() - 500, output->GetY());
+    wire->Release();
+    ASSERT_TRUE(output->getConnector().empty());
+
+    // A wire that catches a pin stays
+    auto other = spartyBoots.AddGate(L"or");
+    auto input = other->GetInputPins()[0];
+    output->Connect(input.get());
+    ASSERT_EQ(1u, output->getConnector().size());
+    ASSERT_EQ(input.get(), output->getConnector()[0]->getCaught());
+}
+
+TEST_F(SpartyBootsTest, MoveToFront)
+{
+    SpartyBoots spartyBoots(NULL);
+    spartyBoots.OnLevelSelect(2);
+
+    vector<shared_ptr<LogicGate>> gates;
+    for (int i = 0; i < 100; i++)
+    {
+        gates.push_back(spartyBoots.AddGate(L"or"));
+    }
+
+    // The scoreboard stays at the back
+    auto before = spartyBoots.GetItems();
+    ASSERT_NE(nullptr, dynamic_pointer_cast<ScoreBoard>(before.front()));
+
+    // Bringing an item to the front leaves the rest in their order
+    gates[10]->MoveToFront();
+    gates[10]->MoveToFront();
+    auto after = spartyBoots.GetItems();
+    ASSERT_EQ(before.size(), after.size());
+    ASSERT_EQ(gates[10], after.back());
+    before.erase(find(before.begin(), before.end(), gates[10]));
+    after.pop_back();
+    ASSERT_TRUE(before == after);
+
+    // and it is the first thing hit
+    auto &items = spartyBoots.GetItemStore();
+    ASSERT_EQ(gates[10], *items.FrontToBack().begin());
+}
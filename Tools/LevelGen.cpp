@@ -0,0 +1,99 @@
+/**
+ * @file LevelGen.cpp
+ * @author Alex Mueller
+ *
+ * Command line tool that writes synthetic levels for stress testing.
+ *
+ *     LevelGen [options] output.xml|output.splv
+ *
+ * Files ending in .splv are written in the binary level format.
+ */
+
+#include "pch.h"
+#include <wx/init.h>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "LevelGenerator.hpp"
+#include "LoadLevel.h"
+
+using namespace std;
+
+/**
+ * Print the command line usage
+ */
+static void Usage()
+{
+    cerr << "usage: LevelGen [options] output.xml|output.splv\n"
+            "  --products N   number of products (1000)\n"
+            "  --sensor N     number of sensor properties (6)\n"
+            "  --speed N      conveyor speed (100)\n"
+            "  --spacing N    distance between products (150)\n"
+            "  --gates N      number of pre-wired gates, 0 for none (8)\n"
+            "  --content F    fraction of products with content (0.5)\n"
+            "  --kick F       fraction kicked when there are no gates (0.5)\n"
+            "  --seed N       random seed (1)\n";
+}
+
+int main(int argc, char **argv)
+{
+    wxInitializer initializer;
+    if (!initializer.IsOk())
+    {
+        cerr << "unable to initialize wxWidgets\n";
+        return 1;
+    }
+
+    LevelGenerator::Options options;
+    const char *output = nullptr;
+    for (int i = 1; i < argc; i++)
+    {
+        auto arg = argv[i];
+        auto value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (arg[0] != '-')
+        {
+            output = arg;
+            continue;
+        }
+        if (value == nullptr)
+        {
+            Usage();
+            return 1;
+        }
+
+        if (strcmp(arg, "--products") == 0) { options.mProducts = atoi(value); }
+        else if (strcmp(arg, "--sensor") == 0) { options.mSensorChildren = atoi(value); }
+        else if (strcmp(arg, "--speed") == 0) { options.mSpeed = atoi(value); }
+        else if (strcmp(arg, "--spacing") == 0) { options.mSpacing = atoi(value); }
+        else if (strcmp(arg, "--gates") == 0) { options.mGates = atoi(value); }
+        else if (strcmp(arg, "--content") == 0) { options.mContentFraction = atof(value); }
+        else if (strcmp(arg, "--kick") == 0) { options.mKickFraction = atof(value); }
+        else if (strcmp(arg, "--seed") == 0) { options.mSeed = (unsigned)strtoul(value, nullptr, 10); }
+        else
+        {
+            Usage();
+            return 1;
+        }
+        i++;
+    }
+
+    if (output == nullptr)
+    {
+        Usage();
+        return 1;
+    }
+
+    LoadLevel level;
+    LevelGenerator generator(options);
+    generator.Generate(level);
+
+    wxString filename(output);
+    bool saved = filename.EndsWith(L".splv") ? level.SaveBinary(filename) : level.SaveXml(filename);
+    if (!saved)
+    {
+        cerr << "unable to write " << output << "\n";
+        return 1;
+    }
+
+    return 0;
+}
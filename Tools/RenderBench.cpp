@@ -0,0 +1,74 @@
+/**
+ * @file RenderBench.cpp
+ * @author Alex Mueller
+ *
+ * Command line tool that times recording and software rendering of
+ * game frames, for machines without a display or GPU.
+ *
+ *     RenderBench [level] [frames] [width] [height]
+ *
+ * Run it from the directory holding images/ and Levels/.
+ */
+
+#include "pch.h"
+#include <wx/init.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include "DrawCommands.hpp"
+#include "SoftwareRenderer.hpp"
+#include "SpartyBoots.hpp"
+
+using namespace std;
+
+/// Time between frames in seconds
+const double FrameTime = 1.0 / 60;
+
+int main(int argc, char **argv)
+{
+    int level = argc > 1 ? atoi(argv[1]) : 2;
+    int frames = argc > 2 ? max(1, atoi(argv[2])) : 600;
+    int width = argc > 3 ? max(1, atoi(argv[3])) : 1280;
+    int height = argc > 4 ? max(1, atoi(argv[4])) : 800;
+
+    wxInitializer initializer;
+    if (!initializer.IsOk())
+    {
+        cerr << "unable to initialize wxWidgets\n";
+        return 1;
+    }
+    wxInitAllImageHandlers();
+
+    SpartyBoots spartyBoots(nullptr);
+    spartyBoots.OnLevelSelect(level);
+
+    DrawCommands commands;
+    SoftwareRenderer renderer(width, height);
+    chrono::duration<double> recording(0);
+    chrono::duration<double> rendering(0);
+    size_t commandCount = 0;
+    for (int frame = 0; frame < frames; frame++)
+    {
+        spartyBoots.Update(FrameTime);
+
+        auto start = chrono::steady_clock::now();
+        commands.Clear();
+        spartyBoots.Draw(commands, width, height);
+        auto recorded = chrono::steady_clock::now();
+        renderer.Clear(*wxWHITE);
+        renderer.Render(commands);
+        auto rendered = chrono::steady_clock::now();
+
+        recording += recorded - start;
+        rendering += rendered - recorded;
+        commandCount += commands.GetCommands().size();
+    }
+
+    cout << frames << " frames of level " << level << " at " << width << "x" << height << ", "
+         << commandCount / frames << " commands/frame\n";
+    cout << "record " << recording.count() * 1000 / frames << " ms/frame, render "
+         << rendering.count() * 1000 / frames << " ms/frame, "
+         << frames / max(recording.count() + rendering.count(), 1e-9) << " frames/s\n";
+    return 0;
+}
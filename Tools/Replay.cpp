@@ -0,0 +1,61 @@
+/**
+ * @file Replay.cpp
+ * @author Alex Mueller
+ *
+ * Command line tool that replays a recorded input log into a
+ * headless game as fast as possible and reports the timing.
+ *
+ *     Replay input.log [repeat]
+ *
+ * Run it from the directory holding images/ and Levels/.
+ */
+
+#include "pch.h"
+#include <wx/init.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include "InputRecorder.hpp"
+#include "SpartyBoots.hpp"
+
+using namespace std;
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        cerr << "usage: Replay input.log [repeat]\n";
+        return 1;
+    }
+
+    wxInitializer initializer;
+    if (!initializer.IsOk())
+    {
+        cerr << "unable to initialize wxWidgets\n";
+        return 1;
+    }
+    wxInitAllImageHandlers();
+
+    InputRecorder recorder;
+    if (!recorder.Load(wxString(argv[1])))
+    {
+        cerr << "unable to read " << argv[1] << "\n";
+        return 1;
+    }
+
+    int repeat = argc > 2 ? max(1, atoi(argv[2])) : 1;
+    for (int r = 0; r < repeat; r++)
+    {
+        SpartyBoots spartyBoots(nullptr);
+
+        auto start = chrono::steady_clock::now();
+        auto ticks = recorder.Replay(spartyBoots);
+        auto seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        cout << ticks << " ticks in " << seconds * 1000 << " ms, " << (seconds > 0 ? ticks / seconds : 0)
+             << " ticks/s, level " << spartyBoots.GetCurrentLevel() << ", " << spartyBoots.GetItems().size() << " items\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file Solver.cpp
+ * @author Alex Mueller
+ *
+ * Command line tool that finds the smallest circuit for levels.
+ *
+ *     Solver [options] level...
+ *
+ * Prints one line per level: file, gates, candidates evaluated and
+ * time. With --write the solution is saved next to each level as
+ * name.solved.xml, or name.solved.splv for binary levels.
+ */
+
+#include "pch.h"
+#include <wx/init.h>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "CircuitSolver.hpp"
+#include "LoadLevel.h"
+
+using namespace std;
+
+/**
+ * Print the command line usage
+ */
+static void Usage()
+{
+    cerr << "usage: Solver [options] level...\n"
+            "  --gates N       largest circuit to try (5)\n"
+            "  --threads N     worker threads, 0 for one per core (0)\n"
+            "  --no-flipflops  only use and, or and not gates\n"
+            "  --write         save each solution as name.solved.xml\n";
+}
+
+/**
+ * Save a level with its solution in place of any gates it had
+ * @param level The level
+ * @param solver Solver that solved it
+ * @param result The solution
+ * @param filename Level file name
+ * @return true if saved
+ */
+static bool SaveSolution(LoadLevel &level, const CircuitSolver &solver, const CircuitSolver::Result &result,
+                         const wxString &filename)
+{
+    LoadLevel solved;
+    for (auto &record : level.GetLevelList())
+    {
+        if (record[0] != L"gate" && record[0] != L"wire")
+        {
+            solved.AddRecord(record);
+        }
+    }
+    solver.AddSolution(result, solved);
+
+    if (filename.EndsWith(L".splv"))
+    {
+        return solved.SaveBinary(filename.BeforeLast(L'.') + L".solved.splv");
+    }
+    return solved.SaveXml(filename.BeforeLast(L'.') + L".solved.xml");
+}
+
+int main(int argc, char **argv)
+{
+    wxInitializer initializer;
+    if (!initializer.IsOk())
+    {
+        cerr << "unable to initialize wxWidgets\n";
+        return 1;
+    }
+
+    CircuitSolver::Options options;
+    bool write = false;
+    vector<wxString> files;
+    for (int i = 1; i < argc; i++)
+    {
+        auto arg = argv[i];
+        if (strcmp(arg, "--no-flipflops") == 0) { options.mFlipFlops = false; }
+        else if (strcmp(arg, "--write") == 0) { write = true; }
+        else if (strcmp(arg, "--gates") == 0 && i + 1 < argc) { options.mMaxGates = atoi(argv[++i]); }
+        else if (strcmp(arg, "--threads") == 0 && i + 1 < argc) { options.mThreads = atoi(argv[++i]); }
+        else if (arg[0] == '-')
+        {
+            Usage();
+            return 1;
+        }
+        else
+        {
+            files.push_back(wxString(arg));
+        }
+    }
+
+    if (files.empty())
+    {
+        Usage();
+        return 1;
+    }
+
+    int unsolved = 0;
+    for (auto &file : files)
+    {
+        LoadLevel level;
+        level.Load(file);
+
+        CircuitSolver solver(options);
+        solver.SetLevel(level);
+        auto result = solver.Solve();
+
+        cout << file.ToStdString() << " ";
+        if (result.mSolved)
+        {
+            cout << result.mGates.size() << " gates";
+        }
+        else
+        {
+            cout << "unsolved";
+            unsolved++;
+        }
+        cout << ", " << result.mCandidates << " candidates, " << result.mSeconds * 1000 << " ms\n";
+
+        if (write && result.mSolved && !SaveSolution(level, solver, result, file))
+        {
+            cerr << "unable to write the solution for " << file.ToStdString() << "\n";
+        }
+    }
+
+    return unsolved == 0 ? 0 : 2;
+}